@@ -0,0 +1,91 @@
+#pragma once
+
+#include "display/fonts/mono_5x7.hpp"
+#include "display/latency_probe.hpp"
+#include "display/types.hpp"
+#include "physics/world.hpp"
+#include "ui/button.hpp"
+#include "ui/numeric_readout.hpp"
+#include "ui/scene.hpp"
+
+namespace evms {
+
+namespace App {
+    /*
+    *   Body of the demo's frame loop: a logo bouncing around a canvas that touch draws
+    *   on, with hit counters and a clear button in a status bar along the bottom edge.
+    *   Hardware stays outside: touch comes in as a screen position and ScreenType may
+    *   be the SPI screen or one over the mock transport, so a session recorded on the
+    *   device (see replay/session_log.hpp) replays on the host frame by frame.
+    *   Start position and direction come from Utility::RandomInteger, seed it first
+    *   with Utility::SeedRandom() for reproducible runs.
+    */
+    template <typename ScreenType>
+    class Demo {
+    public:
+        static constexpr Display::Dimensions2D ScreenDims = ScreenType::Dimensions;
+        static constexpr int Speed = 1;
+        static constexpr int BarHeight = 12;
+        static constexpr int BarY = ScreenDims.height - BarHeight;
+
+        // Logo bounces above the status bar, so it never draws over the widgets
+        static constexpr Display::Dimensions2D CanvasDims = { ScreenDims.width, BarY };
+
+    private:
+        ScreenType& m_screen;
+        Display::PixelView m_logoImage;
+        Physics::World<1, CanvasDims> m_world;
+        int m_logo;
+        int m_canvasHits = 0;
+        int m_borderHits = 0;
+        int m_cornerHits = 0;
+
+        bool m_clearRequested = false;
+        Ui::NumericReadout m_canvasReadout;
+        Ui::NumericReadout m_borderReadout;
+        Ui::NumericReadout m_cornerReadout;
+        Ui::Button m_clearButton;
+        Ui::Scene<4> m_scene;
+
+        Display::LatencyProbe* m_latencyProbe = nullptr;
+
+    public:
+        // Doesn't touch the screen, so it can be set up while the panel is still initializing. Logo must fit CanvasDims.
+        Demo(ScreenType& screen, Display::PixelView logoImage);
+
+        // Widgets keep pointers into the demo
+        Demo(const Demo& other) = delete;
+
+    public:
+        Demo& operator=(const Demo& other) = delete;
+
+    public:
+        // Handle touch, step physics, draw and render once. Returns true if the logo hit anything.
+        bool frame(Display::Position touch);
+
+        // Pack logo if there is one and it fits the canvas, the built-in one otherwise
+        static Display::PixelView PickLogo(Display::PixelView packLogo);
+
+        // Report drawing the dot under a touch to probe, set it on the screen as well
+        inline void setLatencyProbe(Display::LatencyProbe* probe) {
+            m_latencyProbe = probe;
+        }
+
+    public:
+        inline int canvasHits() const {
+            return m_canvasHits;
+        }
+
+        inline int borderHits() const {
+            return m_borderHits;
+        }
+
+        inline int cornerHits() const {
+            return m_cornerHits;
+        }
+    };
+}
+
+} // namespace evms
+
+#include "demo.inl"
@@ -0,0 +1,87 @@
+#include "display/kernels.hpp"
+#include "main/bitmaps.hpp"
+#include "utility/random.hpp"
+
+namespace evms {
+
+namespace App {
+    template <typename ScreenType>
+    Demo<ScreenType>::Demo(ScreenType& screen, Display::PixelView logoImage)
+        : m_screen(screen)
+        , m_logoImage(logoImage)
+        , m_canvasReadout({ 2, BarY, 50, BarHeight }, Fonts::Mono5x7, "C:")
+        , m_borderReadout({ 54, BarY, 50, BarHeight }, Fonts::Mono5x7, "B:")
+        , m_cornerReadout({ 106, BarY, 50, BarHeight }, Fonts::Mono5x7, "K:")
+        , m_clearButton({ 180, BarY, 58, BarHeight }, Fonts::Mono5x7, "Clear", [this]() {
+            m_clearRequested = true;
+        }) {
+        const Display::Dimensions2D logoDims = logoImage.dimensions();
+        m_logo = m_world.add(
+            {
+                Utility::RandomInteger(0, CanvasDims.width - logoDims.width),
+                Utility::RandomInteger(0, CanvasDims.height - logoDims.height),
+                logoDims.width, logoDims.height
+            },
+            {
+                Utility::RandomInteger(0, 1) ? Speed : -Speed,
+                Utility::RandomInteger(0, 1) ? Speed : -Speed
+            }
+        );
+
+        m_scene.add(m_canvasReadout);
+        m_scene.add(m_borderReadout);
+        m_scene.add(m_cornerReadout);
+        m_scene.add(m_clearButton);
+    }
+
+    template <typename ScreenType>
+    Display::PixelView Demo<ScreenType>::PickLogo(Display::PixelView packLogo) {
+        if (!packLogo || packLogo.width() > CanvasDims.width || packLogo.height() > CanvasDims.height)
+            return Bitmaps::DvdLogo;
+        return packLogo;
+    }
+
+    template <typename ScreenType>
+    bool Demo<ScreenType>::frame(Display::Position touch) {
+        if (!m_scene.touch(touch) && touch.x >= 0 && touch.y >= 0) {
+            // Touches in the bar that miss the widgets mustn't draw over it
+            Display::MutablePixelView canvas = m_screen.canvas().subview(0, 0, CanvasDims);
+            Display::Rect drawn = Display::Kernels::Blit(canvas, touch.x - 1, touch.y - 1, Bitmaps::Dot);
+            if (drawn) {
+                m_screen.invalidate(drawn);
+                if (m_latencyProbe)
+                    m_latencyProbe->drawn(touch);
+            }
+        }
+
+        if (m_clearRequested) {
+            m_screen.clear();
+            m_scene.invalidate();
+            m_clearRequested = false;
+        }
+
+        Display::Rect previous = m_world.bounds(m_logo);
+        m_world.step(m_screen.framebuffer().subview(0, 0, CanvasDims));
+        for (const Physics::Event& event : m_world.events()) {
+            switch (event.type) {
+                case Physics::Event::Type::Corner:  ++m_cornerHits; break;
+                case Physics::Event::Type::Border:  ++m_borderHits; break;
+                case Physics::Event::Type::Canvas:  ++m_canvasHits; break;
+                default:                            break;
+            }
+        }
+        m_canvasReadout.setValue(m_canvasHits);
+        m_borderReadout.setValue(m_borderHits);
+        m_cornerReadout.setValue(m_cornerHits);
+
+        // Everything changed this frame goes out in a single flush
+        Display::Rect current = m_world.bounds(m_logo);
+        m_screen.clear(previous.x, previous.y, previous.dimensions());
+        m_screen.draw(current.x, current.y, m_logoImage);
+        m_scene.render(m_screen);
+        m_screen.render();
+        return !m_world.events().empty();
+    }
+}
+
+} // namespace evms
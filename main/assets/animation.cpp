@@ -0,0 +1,81 @@
+#include "animation.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "assets/rle.hpp"
+
+namespace evms {
+
+Assets::Animation::Animation(std::span<const uint8_t> bytes) {
+    if (bytes.size() < sizeof(AnimationHeader))
+        return;
+
+    AnimationHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (std::memcmp(header.magic, AnimationMagic, sizeof(AnimationMagic)) != 0)
+        return;
+    if (header.width == 0 || header.height == 0 || header.tileSize == 0 || header.frameCount == 0)
+        return;
+    if (sizeof(AnimationHeader) + header.frameCount * sizeof(uint32_t) > bytes.size())
+        return;
+
+    m_bytes = bytes;
+    m_header = header;
+    if (!frame(0).keyFrame) {
+        m_bytes = {};
+        m_header = {};
+    }
+}
+
+Assets::Animation::Frame Assets::Animation::frame(int index) const {
+    if (index < 0 || index >= m_header.frameCount)
+        return {};
+
+    uint32_t offset;
+    std::memcpy(&offset, m_bytes.data() + sizeof(AnimationHeader) + index * sizeof(uint32_t), sizeof(offset));
+    if (offset > m_bytes.size() || m_bytes.size() - offset < sizeof(FrameHeader))
+        return {};
+
+    FrameHeader header;
+    std::memcpy(&header, m_bytes.data() + offset, sizeof(header));
+    size_t tileMapSize = (tileCount() + 7) / 8;
+    offset += sizeof(FrameHeader);
+    if (header.size > m_bytes.size() - offset || header.size < tileMapSize)
+        return {};
+
+    std::span<const uint8_t> data = m_bytes.subspan(offset, header.size);
+    return {
+        (header.flags & KeyFrameFlag) != 0,
+        header.changedTiles,
+        data.first(tileMapSize),
+        data.subspan(tileMapSize)
+    };
+}
+
+bool Assets::Animation::decode(const Frame& frame, Display::MutablePixelView target) const {
+    if (!frame || target.width() < m_header.width || target.height() < m_header.height)
+        return false;
+
+    // One stream for the whole frame, the decoder carries runs over from tile to tile
+    Rle::Decoder decoder(frame.pixels);
+    for (int tile = 0, count = tileCount(); tile < count; ++tile) {
+        if (!TileChanged(frame.tileMap, tile))
+            continue;
+
+        Display::Rect rect = tileRect(tile);
+        for (int row = 0; row < rect.height; ++row) {
+            if (decoder.decode(target.row(rect.y + row) + rect.x, rect.width) != static_cast<size_t>(rect.width))
+                return false;
+        }
+    }
+    return true;
+}
+
+Display::Rect Assets::Animation::tileRect(int tile) const {
+    int size = m_header.tileSize;
+    int x = (tile % tilesX()) * size, y = (tile / tilesX()) * size;
+    return { x, y, std::min(size, m_header.width - x), std::min(size, m_header.height - y) };
+}
+
+} // namespace evms
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "display/types.hpp"
+
+namespace evms {
+
+namespace Assets {
+    /*
+    *   Delta-compressed animation, little-endian:
+    *   AnimationHeader, AnimationHeader::frameCount 32-bit frame offsets (from the start
+    *   of the animation), then frames. Every frame is a FrameHeader, a tile map with one
+    *   bit per tile (row-major, first tile in the top bit of the first byte) and a single
+    *   RLE stream (see assets/rle.hpp) holding the pixels of every set tile in tile order,
+    *   each tile row by row. Tiles on the right and bottom edges are clipped to the frame.
+    *   Keyframes have every tile set, so playback can start or loop from them; the first
+    *   frame is always a keyframe. Delta frames only carry tiles that differ from the
+    *   previous frame.
+    */
+    constexpr char AnimationMagic[4] = { 'E', 'V', 'A', 'N' };
+    constexpr uint8_t KeyFrameFlag = 0b0000'0001;
+
+    struct AnimationHeader {
+        char magic[4];
+        uint16_t width;
+        uint16_t height;
+        uint16_t frameCount;
+        uint16_t frameMilliseconds;
+        uint8_t tileSize;
+        uint8_t reserved[3];
+    };
+    static_assert(sizeof(AnimationHeader) == 16);
+
+    struct FrameHeader {
+        uint8_t flags;
+        uint8_t reserved;
+        uint16_t changedTiles;
+        uint32_t size;          // Tile map and RLE stream
+    };
+    static_assert(sizeof(FrameHeader) == 8);
+
+    // Read-only view of an animation in memory, e.g. an asset of an AssetPack
+    class Animation {
+    public:
+        struct Frame {
+            bool keyFrame = false;
+            int changedTiles = 0;
+            std::span<const uint8_t> tileMap;
+            std::span<const uint8_t> pixels;    // RLE stream
+
+            explicit operator bool() const {
+                return !tileMap.empty();
+            }
+        };
+
+    private:
+        std::span<const uint8_t> m_bytes;
+        AnimationHeader m_header = {};
+
+    public:
+        Animation() = default;
+
+        // Empty animation if bytes don't hold a valid one
+        explicit Animation(std::span<const uint8_t> bytes);
+
+    public:
+        // Empty frame if index is out of range or the frame is malformed
+        Frame frame(int index) const;
+
+        /*
+        *   Decode changed tiles of frame straight into target, which must be at least
+        *   dimensions() and hold the previous frame (unless this one is a keyframe).
+        *   Returns false if the frame is empty or its pixel stream ends early.
+        */
+        bool decode(const Frame& frame, Display::MutablePixelView target) const;
+
+        // Rect of tile in frame coordinates, clipped to the frame
+        Display::Rect tileRect(int tile) const;
+
+    public:
+        static inline bool TileChanged(std::span<const uint8_t> tileMap, int tile) {
+            return tileMap[tile / 8] & (0x80 >> (tile % 8));
+        }
+
+        inline Display::Dimensions2D dimensions() const {
+            return { m_header.width, m_header.height };
+        }
+
+        inline int tileSize() const {
+            return m_header.tileSize;
+        }
+
+        inline int tilesX() const {
+            return m_header.tileSize ? (m_header.width + m_header.tileSize - 1) / m_header.tileSize : 0;
+        }
+
+        inline int tilesY() const {
+            return m_header.tileSize ? (m_header.height + m_header.tileSize - 1) / m_header.tileSize : 0;
+        }
+
+        inline int tileCount() const {
+            return tilesX() * tilesY();
+        }
+
+        inline int frameCount() const {
+            return m_header.frameCount;
+        }
+
+        inline int64_t frameMicroseconds() const {
+            return m_header.frameMilliseconds * int64_t(1000);
+        }
+
+        inline bool empty() const {
+            return m_bytes.empty();
+        }
+    };
+}
+
+} // namespace evms
@@ -0,0 +1,124 @@
+#include "asset_pack.hpp"
+
+#include <cstring>
+
+#include "assets/qoi.hpp"
+#include "assets/rle.hpp"
+#include "display/kernels.hpp"
+
+namespace evms {
+
+static std::string_view EntryName(const Assets::AssetEntry& entry) {
+    return { entry.name, strnlen(entry.name, Assets::NameSize) };
+}
+
+Display::PixelView Assets::Asset::view() const {
+    if (compressed || format != PixelFormat::Rgb565 || data.size() < dimensions.width * dimensions.height * sizeof(uint16_t))
+        return {};
+    return { reinterpret_cast<const uint16_t*>(data.data()), dimensions };
+}
+
+Display::IndexedPixelView Assets::Asset::indexedView() const {
+    if (compressed || (format != PixelFormat::Indexed4 && format != PixelFormat::Indexed8) || data.size() < 2)
+        return {};
+
+    int bitsPerPixel = format == PixelFormat::Indexed4 ? 4 : 8;
+    size_t paletteSize = data[0] | (data[1] << 8);
+    size_t indicesSize = ((dimensions.width * bitsPerPixel + 7) / 8) * dimensions.height;
+    // Palettes are padded to every index the pixels can hold, so lookups can't run past them
+    if (paletteSize != (size_t(1) << bitsPerPixel) || data.size() < 2 + paletteSize * 2 + indicesSize)
+        return {};
+
+    // Palette is 2-byte aligned, asset data starts 4-byte aligned
+    const uint16_t* palette = reinterpret_cast<const uint16_t*>(data.data() + 2);
+    return { data.data() + 2 + paletteSize * 2, palette, dimensions, bitsPerPixel };
+}
+
+bool Assets::Asset::decode(Display::MutablePixelView destination) const {
+    if (destination.width() < dimensions.width || destination.height() < dimensions.height)
+        return false;
+
+    if (format == PixelFormat::Indexed4 || format == PixelFormat::Indexed8) {
+        Display::IndexedPixelView indexed = indexedView();
+        if (!indexed)
+            return false;
+        Display::Kernels::Blit(destination, 0, 0, indexed);
+        return true;
+    }
+    if (format == PixelFormat::Qoi) {
+        Qoi::Decoder decoder(data);
+        return decoder && decoder.decode(destination);
+    }
+    if (format != PixelFormat::Rgb565)
+        return false;
+
+    if (!compressed) {
+        Display::PixelView pixels = view();
+        if (!pixels)
+            return false;
+        Display::Kernels::Blit(destination, 0, 0, pixels);
+        return true;
+    }
+
+    Rle::Decoder decoder(data);
+    for (int y = 0; y < dimensions.height; ++y) {
+        if (decoder.decode(destination.row(y), dimensions.width) != static_cast<size_t>(dimensions.width))
+            return false;
+    }
+    return true;
+}
+
+Assets::AssetPack::AssetPack(std::span<const uint8_t> bytes) {
+    if (bytes.size() < sizeof(PackHeader))
+        return;
+
+    PackHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (std::memcmp(header.magic, PackMagic, sizeof(PackMagic)) != 0 || header.version != PackVersion)
+        return;
+    if (header.totalSize > bytes.size() || sizeof(PackHeader) + header.assetCount * sizeof(AssetEntry) > header.totalSize)
+        return;
+
+    // Pixels and palettes are read in place as uint16_t, misaligned data would mean misaligned loads
+    if (reinterpret_cast<uintptr_t>(bytes.data()) % DataAlignment != 0)
+        return;
+
+    const AssetEntry* entries = reinterpret_cast<const AssetEntry*>(bytes.data() + sizeof(PackHeader));
+    for (size_t index = 0; index < header.assetCount; ++index) {
+        if (entries[index].offset > header.totalSize || entries[index].size > header.totalSize - entries[index].offset)
+            return;
+        if (entries[index].offset % DataAlignment != 0)
+            return;
+    }
+
+    m_bytes = bytes.first(header.totalSize);
+    m_entries = { entries, header.assetCount };
+}
+
+int Assets::AssetPack::find(std::string_view name) const {
+    for (size_t index = 0; index < m_entries.size(); ++index) {
+        if (EntryName(m_entries[index]) == name)
+            return static_cast<int>(index);
+    }
+    return -1;
+}
+
+Assets::Asset Assets::AssetPack::asset(int index) const {
+    if (index < 0 || static_cast<size_t>(index) >= m_entries.size())
+        return {};
+
+    const AssetEntry& entry = m_entries[index];
+    return {
+        EntryName(entry),
+        { entry.width, entry.height },
+        entry.format,
+        (entry.flags & CompressedFlag) != 0,
+        m_bytes.subspan(entry.offset, entry.size)
+    };
+}
+
+Assets::Asset Assets::AssetPack::asset(std::string_view name) const {
+    return asset(find(name));
+}
+
+} // namespace evms
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#include "assets/pack_format.hpp"
+#include "display/indexed_pixel_map.hpp"
+#include "display/types.hpp"
+
+namespace evms {
+
+namespace Assets {
+    struct Asset {
+        std::string_view name;
+        Display::Dimensions2D dimensions = {};
+        PixelFormat format = PixelFormat::Rgb565;
+        bool compressed = false;
+        std::span<const uint8_t> data;
+
+        // Pixels in place, empty if the asset is compressed or not Rgb565
+        Display::PixelView view() const;
+
+        // Indices and palette in place, empty if the asset is not Indexed4/Indexed8
+        Display::IndexedPixelView indexedView() const;
+
+        // Decompress, decode, expand or copy pixels into destination, false if they don't fit
+        bool decode(Display::MutablePixelView destination) const;
+
+        explicit operator bool() const {
+            return !data.empty();
+        }
+    };
+
+    /*
+    *   Read-only view of an asset pack in memory, usually mapped from flash (see PackStorage).
+    *   Nothing is copied: assets are handed out as views into the pack, and mapped flash is
+    *   only fetched by the cache once an asset's pixels are actually read.
+    */
+    class AssetPack {
+    private:
+        std::span<const uint8_t> m_bytes;
+        std::span<const AssetEntry> m_entries;
+
+    public:
+        AssetPack() = default;
+
+        // Empty pack if bytes don't hold a valid one, data must start DataAlignment aligned
+        explicit AssetPack(std::span<const uint8_t> bytes);
+
+    public:
+        // -1 if there's no asset with this name
+        int find(std::string_view name) const;
+
+        Asset asset(int index) const;
+
+        // Empty asset if there's no asset with this name
+        Asset asset(std::string_view name) const;
+
+    public:
+        inline size_t size() const {
+            return m_entries.size();
+        }
+
+        inline bool empty() const {
+            return m_entries.empty();
+        }
+    };
+}
+
+} // namespace evms
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace evms {
+
+namespace Assets {
+    /*
+    *   Asset pack layout, little-endian:
+    *   PackHeader, PackHeader::assetCount AssetEntry records, then asset data.
+    *   Every asset's data starts 4-byte aligned, so uncompressed pixels can be
+    *   viewed right where they are mapped. Pixels are in panel byte order.
+    */
+    constexpr char PackMagic[4] = { 'E', 'V', 'A', 'P' };
+    constexpr uint16_t PackVersion = 2;
+    constexpr size_t DataAlignment = 4;
+    constexpr size_t NameSize = 24;
+
+    /*
+    *   Rgb565      2 bytes per pixel
+    *   Indexed4    Palette, then 2 pixels per byte (first in the high nibble), rows padded to a byte
+    *   Indexed8    Palette, then 1 byte per pixel
+    *   Mask1       1 bit per pixel (first in the top bit), rows padded to a byte, set means opaque
+    *   Animation   Keyframes and tile deltas, see assets/animation.hpp
+    *   Qoi         QOI image, see assets/qoi.hpp
+    *   A palette is a 16-bit entry count followed by that many Rgb565 entries, padded to 16 or
+    *   256 entries so every index is valid.
+    */
+    enum class PixelFormat : uint8_t {
+        Rgb565 = 0,
+        Indexed4 = 1,
+        Indexed8 = 2,
+        Mask1 = 3,
+        Animation = 4,
+        Qoi = 5,
+    };
+
+    // AssetEntry::flags bits
+    constexpr uint8_t CompressedFlag = 0b0000'0001;     // Data is RLE compressed, see assets/rle.hpp
+
+    struct PackHeader {
+        char magic[4];
+        uint16_t version;
+        uint16_t assetCount;
+        uint32_t totalSize;     // Header, index and data
+    };
+    static_assert(sizeof(PackHeader) == 12);
+
+    struct AssetEntry {
+        char name[NameSize];    // Zero padded, not necessarily zero terminated
+        uint32_t offset;        // From the start of the pack
+        uint32_t size;          // In bytes
+        uint16_t width;
+        uint16_t height;
+        PixelFormat format;
+        uint8_t flags;
+        uint16_t reserved;
+    };
+    static_assert(sizeof(AssetEntry) == 40);
+}
+
+} // namespace evms
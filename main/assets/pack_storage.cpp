@@ -0,0 +1,91 @@
+#include "pack_storage.hpp"
+
+#include <utility>
+
+#ifdef ESP_PLATFORM
+#include <esp_log.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace evms {
+
+Assets::PackStorage::PackStorage(const char* name)
+    : m_logTag(std::string(name) + " PackStorage") {
+#ifdef ESP_PLATFORM
+    const esp_partition_t* partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, name);
+    if (partition == nullptr) {
+        ESP_LOGW(m_logTag.c_str(), "Partition not found");
+        return;
+    }
+
+    const void* data = nullptr;
+    esp_err_t error = esp_partition_mmap(partition, 0, partition->size, ESP_PARTITION_MMAP_DATA, &data, &m_handle);
+    if (error != ESP_OK) {
+        ESP_LOGW(m_logTag.c_str(), "Couldn't map partition: %s", esp_err_to_name(error));
+        return;
+    }
+
+    m_data = static_cast<const uint8_t*>(data);
+    m_size = partition->size;
+    ESP_LOGI(m_logTag.c_str(), "Mapped %u bytes", static_cast<unsigned>(m_size));
+#else
+    int file = open(name, O_RDONLY);
+    if (file < 0)
+        return;
+
+    struct stat status = {};
+    if (fstat(file, &status) == 0 && status.st_size > 0) {
+        void* data = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (data != MAP_FAILED) {
+            m_data = static_cast<const uint8_t*>(data);
+            m_size = status.st_size;
+        }
+    }
+    close(file);
+#endif
+}
+
+Assets::PackStorage::PackStorage(PackStorage&& other) noexcept
+    : m_logTag(std::move(other.m_logTag))
+    , m_data(std::exchange(other.m_data, nullptr))
+    , m_size(std::exchange(other.m_size, 0))
+#ifdef ESP_PLATFORM
+    , m_handle(std::exchange(other.m_handle, 0))
+#endif
+{}
+
+Assets::PackStorage::~PackStorage() {
+    unmap();
+}
+
+Assets::PackStorage& Assets::PackStorage::operator=(PackStorage&& other) noexcept {
+    if (&other != this) {
+        unmap();
+        m_logTag = std::move(other.m_logTag);
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+#ifdef ESP_PLATFORM
+        m_handle = std::exchange(other.m_handle, 0);
+#endif
+    }
+    return *this;
+}
+
+void Assets::PackStorage::unmap() {
+    if (m_data == nullptr)
+        return;
+
+#ifdef ESP_PLATFORM
+    esp_partition_munmap(m_handle);
+#else
+    munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+    m_data = nullptr;
+    m_size = 0;
+}
+
+} // namespace evms
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+#ifdef ESP_PLATFORM
+#include <esp_partition.h>
+#endif
+
+namespace evms {
+
+namespace Assets {
+    /*
+    *   Maps an asset pack into memory, read-only and without copying.
+    *   On the device name is a data partition label and the partition is mapped through
+    *   the flash cache. On a host name is a file path and the file is mapped instead,
+    *   so pack handling can be tested on Linux. Empty if it can't be mapped.
+    */
+    class PackStorage {
+    private:
+        std::string m_logTag;
+        const uint8_t* m_data = nullptr;
+        size_t m_size = 0;
+#ifdef ESP_PLATFORM
+        esp_partition_mmap_handle_t m_handle = 0;
+#endif
+
+    public:
+        explicit PackStorage(const char* name);
+
+        PackStorage(const PackStorage& other) = delete;
+
+        PackStorage(PackStorage&& other) noexcept;
+
+        ~PackStorage();
+
+    public:
+        PackStorage& operator=(const PackStorage& other) = delete;
+
+        PackStorage& operator=(PackStorage&& other) noexcept;
+
+    private:
+        void unmap();
+
+    public:
+        inline std::span<const uint8_t> bytes() const {
+            return { m_data, m_size };
+        }
+    };
+}
+
+} // namespace evms
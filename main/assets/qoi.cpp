@@ -0,0 +1,180 @@
+#include "qoi.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef ESP_PLATFORM
+#include <esp_heap_caps.h>
+#endif
+
+#include "diagnostics/memory_report.hpp"
+#include "display/color.hpp"
+
+namespace evms {
+
+namespace QoiOps {
+    constexpr uint8_t Index = 0b00;
+    constexpr uint8_t Diff = 0b01;
+    constexpr uint8_t Luma = 0b10;
+    constexpr uint8_t Run = 0b11;
+    constexpr uint8_t Rgb = 0xFE;
+    constexpr uint8_t Rgba = 0xFF;
+}
+
+static inline uint32_t ReadBigEndian32(const uint8_t* bytes) {
+    return (uint32_t(bytes[0]) << 24) | (uint32_t(bytes[1]) << 16) | (uint32_t(bytes[2]) << 8) | bytes[3];
+}
+
+Assets::Qoi::Decoder::Decoder(std::span<const uint8_t> data) {
+    if (data.size() < HeaderSize + EndMarkerSize || std::memcmp(data.data(), Magic, sizeof(Magic)) != 0)
+        return;
+
+    uint32_t width = ReadBigEndian32(data.data() + 4);
+    uint32_t height = ReadBigEndian32(data.data() + 8);
+    uint8_t channels = data[12];
+    if (width == 0 || height == 0 || width > 0x7FFF || height > 0x7FFF || (channels != 3 && channels != 4))
+        return;
+
+    m_data = data.first(data.size() - EndMarkerSize);
+    m_dimensions = { static_cast<int>(width), static_cast<int>(height) };
+}
+
+bool Assets::Qoi::Decoder::decodeRow(uint16_t* destination) {
+    if (m_data.empty() || m_row >= m_dimensions.height)
+        return false;
+
+    const uint8_t* data = m_data.data();
+    size_t size = m_data.size();
+    size_t position = m_position;
+    Color pixel = m_pixel;
+    for (int x = 0, width = m_dimensions.width; x < width;) {
+        if (m_run) {
+            int count = std::min(m_run, width - x);
+            if (m_dithered) {
+                for (int index = x; index < x + count; ++index)
+                    destination[index] = Display::Color::FromRgb888Dithered(pixel.r, pixel.g, pixel.b, index, m_row);
+            }
+            else {
+                std::fill_n(destination + x, count, m_color);
+            }
+            x += count;
+            m_run -= count;
+            continue;
+        }
+        if (position >= size)
+            return false;
+
+        uint8_t op = data[position++];
+        if (op == QoiOps::Rgb || op == QoiOps::Rgba) {
+            size_t length = op == QoiOps::Rgb ? 3 : 4;
+            if (size - position < length)
+                return false;
+            pixel.r = data[position];
+            pixel.g = data[position + 1];
+            pixel.b = data[position + 2];
+            if (op == QoiOps::Rgba)
+                pixel.a = data[position + 3];
+            position += length;
+        }
+        else {
+            switch (op >> 6) {
+                case QoiOps::Index:
+                    pixel = m_index[op];
+                    break;
+                case QoiOps::Diff:
+                    pixel.r += ((op >> 4) & 0b11) - 2;
+                    pixel.g += ((op >> 2) & 0b11) - 2;
+                    pixel.b += (op & 0b11) - 2;
+                    break;
+                case QoiOps::Luma: {
+                    if (position >= size)
+                        return false;
+                    int greenDiff = (op & 0x3F) - 32;
+                    uint8_t redBlue = data[position++];
+                    pixel.r += greenDiff - 8 + (redBlue >> 4);
+                    pixel.g += greenDiff;
+                    pixel.b += greenDiff - 8 + (redBlue & 0x0F);
+                    break;
+                }
+                case QoiOps::Run:
+                    // Current pixel repeats, the fill above writes it
+                    m_run = (op & 0x3F) + 1;
+                    continue;
+            }
+        }
+
+        m_index[(pixel.r * 3 + pixel.g * 5 + pixel.b * 7 + pixel.a * 11) % 64] = pixel;
+        if (m_dithered) {
+            destination[x] = Display::Color::FromRgb888Dithered(pixel.r, pixel.g, pixel.b, x, m_row);
+        }
+        else {
+            m_color = Display::Color::FromRgb888(pixel.r, pixel.g, pixel.b);
+            destination[x] = m_color;
+        }
+        ++x;
+    }
+
+    m_position = position;
+    m_pixel = pixel;
+    ++m_row;
+    return true;
+}
+
+bool Assets::Qoi::Decoder::decode(Display::MutablePixelView destination) {
+    if (destination.width() < m_dimensions.width || destination.height() < m_dimensions.height)
+        return false;
+
+    for (int y = m_row; y < m_dimensions.height; ++y) {
+        if (!decodeRow(destination.row(y)))
+            return false;
+    }
+    return true;
+}
+
+void Assets::Qoi::Decoder::restart() {
+    m_position = HeaderSize;
+    m_row = 0;
+    m_run = 0;
+    m_pixel = { 0, 0, 0, 255 };
+    m_color = 0;
+    m_index = {};
+}
+
+void Assets::Qoi::HeapDeleter::operator()(uint16_t* pixels) const {
+    Diagnostics::Release(Diagnostics::Subsystem::Assets, bytes);
+#ifdef ESP_PLATFORM
+    heap_caps_free(pixels);
+#else
+    std::free(pixels);
+#endif
+}
+
+Assets::Qoi::Image Assets::Qoi::DecodeImage(std::span<const uint8_t> data, Memory memory) {
+    Decoder decoder(data);
+    if (!decoder)
+        return {};
+
+    Display::Dimensions2D dimensions = decoder.dimensions();
+    size_t size = static_cast<size_t>(dimensions.width) * dimensions.height * sizeof(uint16_t);
+#ifdef ESP_PLATFORM
+    void* buffer = nullptr;
+    if (memory == Memory::Psram)
+        buffer = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (buffer == nullptr)
+        buffer = heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+#else
+    // Host has one kind of memory
+    (void)memory;
+    void* buffer = std::malloc(size);
+#endif
+
+    Image image = { std::unique_ptr<uint16_t[], HeapDeleter>(static_cast<uint16_t*>(buffer), { size }), dimensions };
+    if (buffer)
+        Diagnostics::Charge(Diagnostics::Subsystem::Assets, size);
+    if (!image || !decoder.decode({ image.pixels.get(), dimensions }))
+        return {};
+    return image;
+}
+
+} // namespace evms
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+#include "display/types.hpp"
+
+namespace evms {
+
+namespace Assets {
+    /*
+    *   QOI ("Quite OK Image", qoiformat.org) decoding into panel byte order RGB565.
+    *   Lossless for 8-bit RGB sources and a few times smaller than raw pixels for UI
+    *   art and photos alike, while decoding at memcpy-like speeds. Alpha is ignored.
+    */
+    namespace Qoi {
+        constexpr char Magic[4] = { 'q', 'o', 'i', 'f' };
+        constexpr size_t HeaderSize = 14;
+        constexpr size_t EndMarkerSize = 8;
+
+        /*
+        *   Decodes one scanline at a time. The working set is the 64 entry color index
+        *   and the previous pixel (about 270 bytes), so images never have to be held
+        *   decoded in RAM: rows can go straight into a framebuffer or a line buffer.
+        */
+        class Decoder {
+        private:
+            struct Color {
+                uint8_t r, g, b, a;
+            };
+
+        private:
+            std::span<const uint8_t> m_data;
+            Display::Dimensions2D m_dimensions = {};
+            size_t m_position = HeaderSize;
+            int m_row = 0;
+            int m_run = 0;                  // Repeats of the current pixel left over from a run
+            Color m_pixel = { 0, 0, 0, 255 };
+            uint16_t m_color = 0;           // Current pixel converted
+            bool m_dithered = false;
+            std::array<Color, 64> m_index = {};
+
+        public:
+            Decoder() = default;
+
+            // Empty decoder if data doesn't start with a valid header
+            explicit Decoder(std::span<const uint8_t> data);
+
+        public:
+            // Decode next row into width pixels at destination. False once all rows are decoded or data ends early.
+            bool decodeRow(uint16_t* destination);
+
+            // Decode remaining rows into destination, false if they don't fit or data ends early
+            bool decode(Display::MutablePixelView destination);
+
+            // Start over from the first row
+            void restart();
+
+            // Ordered dither the conversion to RGB565 (see display/color.hpp), for photos and gradients
+            inline void setDithering(bool enabled) {
+                m_dithered = enabled;
+            }
+
+        public:
+            inline Display::Dimensions2D dimensions() const {
+                return m_dimensions;
+            }
+
+            // Index of the next row to decode
+            inline int row() const {
+                return m_row;
+            }
+
+            explicit operator bool() const {
+                return !m_data.empty();
+            }
+        };
+
+        enum class Memory {
+            Internal,
+            Psram,      // Falls back to internal RAM when there's no PSRAM
+        };
+
+        // Frees with heap_caps_free() and releases the bytes charged to Diagnostics::Subsystem::Assets
+        struct HeapDeleter {
+            size_t bytes = 0;
+
+            void operator()(uint16_t* pixels) const;
+        };
+
+        // Whole decoded image in its own heap buffer
+        struct Image {
+            std::unique_ptr<uint16_t[], HeapDeleter> pixels;
+            Display::Dimensions2D dimensions = {};
+
+            inline Display::PixelView view() const {
+                return { pixels.get(), dimensions };
+            }
+
+            explicit operator bool() const {
+                return static_cast<bool>(pixels);
+            }
+        };
+
+        // Empty image if data is malformed or the buffer can't be allocated
+        Image DecodeImage(std::span<const uint8_t> data, Memory memory = Memory::Psram);
+    }
+}
+
+} // namespace evms
@@ -0,0 +1,91 @@
+#include "rle.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace evms {
+
+std::vector<uint8_t> Assets::Rle::Encode(std::span<const uint16_t> pixels) {
+    std::vector<uint8_t> output(MaxEncodedSize(pixels.size()));
+    output.resize(Encode(pixels, output));
+    return output;
+}
+
+size_t Assets::Rle::Encode(std::span<const uint16_t> pixels, std::span<uint8_t> destination) {
+    size_t position = 0, index = 0, literalStart = 0;
+    auto putToken = [&](uint16_t token, const uint16_t* tokenPixels, size_t count) {
+        if (position + 2 + (count * 2) > destination.size())
+            return false;
+        destination[position++] = static_cast<uint8_t>(token);
+        destination[position++] = static_cast<uint8_t>(token >> 8);
+        std::memcpy(destination.data() + position, tokenPixels, count * sizeof(uint16_t));
+        position += count * 2;
+        return true;
+    };
+    auto flushLiterals = [&](size_t end) {
+        while (literalStart < end) {
+            size_t count = std::min(end - literalStart, MaxCount);
+            if (!putToken(static_cast<uint16_t>(count), pixels.data() + literalStart, count))
+                return false;
+            literalStart += count;
+        }
+        return true;
+    };
+
+    while (index < pixels.size()) {
+        size_t runEnd = index + 1;
+        while (runEnd < pixels.size() && pixels[runEnd] == pixels[index] && runEnd - index < MaxCount)
+            ++runEnd;
+
+        // A run token costs as much as two literal pixels, shorter runs stay literal
+        if (runEnd - index >= 3) {
+            if (!flushLiterals(index) || !putToken(static_cast<uint16_t>(RunFlag | (runEnd - index)), pixels.data() + index, 1))
+                return 0;
+            literalStart = runEnd;
+        }
+        index = runEnd;
+    }
+    return flushLiterals(pixels.size()) ? position : 0;
+}
+
+Assets::Rle::Decoder::Decoder(std::span<const uint8_t> data)
+    : m_data(data)
+{}
+
+size_t Assets::Rle::Decoder::decode(uint16_t* destination, size_t pixelCount) {
+    size_t written = 0;
+    while (written < pixelCount) {
+        if (m_remaining == 0) {
+            if (m_position + 2 > m_data.size())
+                break;
+            uint16_t token = m_data[m_position] | (m_data[m_position + 1] << 8);
+            m_position += 2;
+            m_remaining = token & MaxCount;
+            m_run = token & RunFlag;
+            if (m_run) {
+                if (m_position + 2 > m_data.size())
+                    break;
+                std::memcpy(&m_pixel, m_data.data() + m_position, sizeof(m_pixel));
+                m_position += 2;
+            }
+            continue;
+        }
+
+        size_t count = std::min(m_remaining, pixelCount - written);
+        if (m_run) {
+            std::fill_n(destination + written, count, m_pixel);
+        }
+        else {
+            count = std::min(count, (m_data.size() - m_position) / 2);
+            if (count == 0)
+                break;
+            std::memcpy(destination + written, m_data.data() + m_position, count * sizeof(uint16_t));
+            m_position += count * 2;
+        }
+        m_remaining -= count;
+        written += count;
+    }
+    return written;
+}
+
+} // namespace evms
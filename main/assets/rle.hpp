@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace evms {
+
+namespace Assets {
+    /*
+    *   Run-length encoding of 16-bit pixels. A stream is a sequence of tokens,
+    *   each a little-endian 16-bit word: top bit set means the next pixel repeats
+    *   (token & 0x7FFF) times, clear means (token & 0x7FFF) pixels follow as is.
+    */
+    namespace Rle {
+        constexpr uint16_t RunFlag = 0x8000;
+        constexpr size_t MaxCount = 0x7FFF;
+
+        std::vector<uint8_t> Encode(std::span<const uint16_t> pixels);
+
+        // Into a caller's buffer without allocating, returns bytes written or 0 if they don't fit
+        size_t Encode(std::span<const uint16_t> pixels, std::span<uint8_t> destination);
+
+        // Longest stream pixelCount pixels can take, all literals
+        constexpr size_t MaxEncodedSize(size_t pixelCount) {
+            return ((pixelCount + MaxCount - 1) / MaxCount) * 2 + pixelCount * 2;
+        }
+
+        // Decodes a stream piece by piece, e.g. a row at a time into a strided view
+        class Decoder {
+        private:
+            std::span<const uint8_t> m_data;
+            size_t m_position = 0;
+            size_t m_remaining = 0;     // Pixels left in the current token
+            bool m_run = false;
+            uint16_t m_pixel = 0;
+
+        public:
+            explicit Decoder(std::span<const uint8_t> data);
+
+        public:
+            // Returns number of pixels written, less than pixelCount if the stream ends
+            size_t decode(uint16_t* destination, size_t pixelCount);
+        };
+
+        inline size_t Decode(std::span<const uint8_t> data, uint16_t* destination, size_t pixelCount) {
+            return Decoder(data).decode(destination, pixelCount);
+        }
+    }
+}
+
+} // namespace evms
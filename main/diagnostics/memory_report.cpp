@@ -0,0 +1,194 @@
+#include "memory_report.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+
+#ifdef ESP_PLATFORM
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+namespace evms {
+
+struct SubsystemCounters {
+    std::atomic<size_t> bytes = 0;
+    std::atomic<size_t> peakBytes = 0;
+    std::atomic<size_t> blocks = 0;
+};
+
+static constexpr size_t MaxWatchedTasks = 8;
+
+#if defined(ESP_PLATFORM) && defined(CONFIG_EVMS_MEMORY_REPORT)
+static constexpr bool CountingAllocations = true;
+#else
+static constexpr bool CountingAllocations = false;
+#endif
+
+static std::array<SubsystemCounters, Diagnostics::SubsystemCount> g_subsystems;
+static std::atomic<size_t> g_allocations = 0;
+
+// Only the frame loop touches these
+static Diagnostics::FrameAllocations g_frameAllocations;
+static size_t g_allocationsAtFrameStart = 0;
+
+static std::mutex g_watchedTasksMutex;
+static std::array<const char*, MaxWatchedTasks> g_watchedTasks = { "main" };
+static size_t g_watchedTaskCount = 1;
+
+const char* Diagnostics::SubsystemName(Subsystem subsystem) {
+    switch (subsystem) {
+        case Subsystem::Display:    return "display";
+        case Subsystem::Spi:        return "spi";
+        case Subsystem::DmaPool:    return "dma pool";
+        case Subsystem::Assets:     return "assets";
+        case Subsystem::Replay:     return "replay";
+        default:                    return "other";
+    }
+}
+
+void Diagnostics::Charge(Subsystem subsystem, size_t bytes) {
+    SubsystemCounters& counters = g_subsystems[static_cast<size_t>(subsystem)];
+    size_t total = counters.bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    counters.blocks.fetch_add(1, std::memory_order_relaxed);
+
+    size_t peak = counters.peakBytes.load(std::memory_order_relaxed);
+    while (total > peak && !counters.peakBytes.compare_exchange_weak(peak, total, std::memory_order_relaxed));
+}
+
+void Diagnostics::Release(Subsystem subsystem, size_t bytes) {
+    SubsystemCounters& counters = g_subsystems[static_cast<size_t>(subsystem)];
+    counters.bytes.fetch_sub(bytes, std::memory_order_relaxed);
+    counters.blocks.fetch_sub(1, std::memory_order_relaxed);
+}
+
+Diagnostics::SubsystemUsage Diagnostics::Usage(Subsystem subsystem) {
+    const SubsystemCounters& counters = g_subsystems[static_cast<size_t>(subsystem)];
+    return {
+        counters.bytes.load(std::memory_order_relaxed),
+        counters.peakBytes.load(std::memory_order_relaxed),
+        counters.blocks.load(std::memory_order_relaxed)
+    };
+}
+
+std::array<Diagnostics::HeapUsage, 3> Diagnostics::HeapUsages() {
+    std::array<HeapUsage, 3> usages = { HeapUsage{ "internal" }, HeapUsage{ "dma" }, HeapUsage{ "spiram" } };
+#ifdef ESP_PLATFORM
+    static constexpr uint32_t Capabilities[] = {
+        MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT,
+        MALLOC_CAP_DMA,
+        MALLOC_CAP_SPIRAM,
+    };
+    for (size_t index = 0; index < usages.size(); ++index) {
+        uint32_t capabilities = Capabilities[index];
+        usages[index].totalBytes = heap_caps_get_total_size(capabilities);
+        usages[index].freeBytes = heap_caps_get_free_size(capabilities);
+        usages[index].minimumFreeBytes = heap_caps_get_minimum_free_size(capabilities);
+        usages[index].largestBlock = heap_caps_get_largest_free_block(capabilities);
+    }
+#endif
+    return usages;
+}
+
+void Diagnostics::WatchTask(const char* name) {
+    std::lock_guard lock(g_watchedTasksMutex);
+    if (g_watchedTaskCount < MaxWatchedTasks)
+        g_watchedTasks[g_watchedTaskCount++] = name;
+}
+
+size_t Diagnostics::AllocationCount() {
+    return g_allocations.load(std::memory_order_relaxed);
+}
+
+void Diagnostics::FrameEnded() {
+    size_t allocations = AllocationCount();
+    size_t frameAllocations = allocations - g_allocationsAtFrameStart;
+    g_allocationsAtFrameStart = allocations;
+
+    ++g_frameAllocations.frames;
+    g_frameAllocations.allocatingFrames += frameAllocations > 0;
+    g_frameAllocations.lastFrame = frameAllocations;
+    g_frameAllocations.maximum = std::max(g_frameAllocations.maximum, frameAllocations);
+}
+
+Diagnostics::FrameAllocations Diagnostics::FrameAllocationStats() {
+    return g_frameAllocations;
+}
+
+void Diagnostics::Report(std::ostream& stream) {
+    char line[96];
+    std::snprintf(line, sizeof(line), "%-10s %9s %9s %7s", "subsystem", "bytes", "peak", "blocks");
+    stream << ReportPrefix << line << '\n';
+    for (size_t index = 0; index < SubsystemCount; ++index) {
+        Subsystem subsystem = static_cast<Subsystem>(index);
+        SubsystemUsage usage = Usage(subsystem);
+        std::snprintf(line, sizeof(line), "%-10s %9zu %9zu %7zu", SubsystemName(subsystem), usage.bytes, usage.peakBytes, usage.blocks);
+        stream << ReportPrefix << line << '\n';
+    }
+
+#ifdef ESP_PLATFORM
+    std::snprintf(line, sizeof(line), "%-10s %9s %9s %9s %9s", "heap", "total", "free", "min free", "largest");
+    stream << ReportPrefix << line << '\n';
+    for (const HeapUsage& usage : HeapUsages()) {
+        if (usage.totalBytes == 0)
+            continue;
+        std::snprintf(line, sizeof(line), "%-10s %9zu %9zu %9zu %9zu",
+            usage.name, usage.totalBytes, usage.freeBytes, usage.minimumFreeBytes, usage.largestBlock);
+        stream << ReportPrefix << line << '\n';
+    }
+
+    // Tasks that ended since being watched are skipped, ESP-IDF stack sizes are in bytes
+    std::snprintf(line, sizeof(line), "%-16s %9s", "task", "stack min");
+    stream << ReportPrefix << line << '\n';
+    std::lock_guard lock(g_watchedTasksMutex);
+    for (size_t index = 0; index < g_watchedTaskCount; ++index) {
+        TaskHandle_t task = xTaskGetHandle(g_watchedTasks[index]);
+        if (task == nullptr)
+            continue;
+        std::snprintf(line, sizeof(line), "%-16s %9u", g_watchedTasks[index], static_cast<unsigned>(uxTaskGetStackHighWaterMark(task)));
+        stream << ReportPrefix << line << '\n';
+    }
+#endif
+
+    if (CountingAllocations) {
+        const FrameAllocations& frames = g_frameAllocations;
+        std::snprintf(line, sizeof(line), "%zu allocations, %zu of %zu frames allocated, last %zu, max %zu",
+            AllocationCount(), frames.allocatingFrames, frames.frames, frames.lastFrame, frames.maximum);
+        stream << ReportPrefix << line << '\n';
+    }
+    stream.flush();
+}
+
+} // namespace evms
+
+#if defined(ESP_PLATFORM) && defined(CONFIG_EVMS_MEMORY_REPORT)
+/*
+*   Counting replacements of the global allocation functions, the array forms call these.
+*   Firmware is built without exceptions, so running out of memory aborts like the default.
+*   C allocations (malloc, ESP-IDF drivers) aren't counted.
+*/
+void* operator new(size_t size) {
+    evms::g_allocations.fetch_add(1, std::memory_order_relaxed);
+    void* pointer = std::malloc(size ? size : 1);
+    if (pointer == nullptr)
+        std::abort();
+    return pointer;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    evms::g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    std::free(pointer);
+}
+#endif
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <ostream>
+#include <vector>
+
+namespace evms {
+
+namespace Diagnostics {
+    /*
+    *   Memory budget accounting. Long-lived buffers are charged to the subsystem that
+    *   owns them through TaggedAllocator and TaggedArray, heap capabilities and task
+    *   stacks are read from ESP-IDF at report time. With CONFIG_EVMS_MEMORY_REPORT the
+    *   firmware also counts every operator new, so the frame loop can check that it
+    *   stays allocation-free (see FrameEnded()). Counters are atomic, any task may
+    *   allocate. Reports are lines starting with ReportPrefix.
+    */
+    enum class Subsystem : uint8_t {
+        Display,    // Framebuffers, shadow buffers, staging rows
+        Spi,        // Transaction buffers
+        DmaPool,    // Slabs of Drivers::DmaPool
+        Assets,     // Decoded images
+        Replay,     // Session recording
+        Other,
+    };
+    constexpr size_t SubsystemCount = static_cast<size_t>(Subsystem::Other) + 1;
+
+    constexpr const char* ReportPrefix = "memory: ";
+
+    struct SubsystemUsage {
+        size_t bytes = 0;
+        size_t peakBytes = 0;
+        size_t blocks = 0;          // Live allocations
+    };
+
+    // Free memory of one heap capability, all zero if the chip has none (e.g. no PSRAM)
+    struct HeapUsage {
+        const char* name;
+        size_t totalBytes = 0;
+        size_t freeBytes = 0;
+        size_t minimumFreeBytes = 0;
+        size_t largestBlock = 0;
+    };
+
+    struct FrameAllocations {
+        size_t frames = 0;
+        size_t allocatingFrames = 0;
+        size_t lastFrame = 0;
+        size_t maximum = 0;
+    };
+
+    const char* SubsystemName(Subsystem subsystem);
+
+    // Account for memory allocated elsewhere, e.g. through heap_caps_malloc()
+    void Charge(Subsystem subsystem, size_t bytes);
+
+    void Release(Subsystem subsystem, size_t bytes);
+
+    SubsystemUsage Usage(Subsystem subsystem);
+
+    // Internal, DMA capable and SPIRAM, in that order
+    std::array<HeapUsage, 3> HeapUsages();
+
+    // Include a task in reports by name, as given to xTaskCreate(), "main" is watched already
+    void WatchTask(const char* name);
+
+    // operator new calls so far, 0 unless counting is compiled in (CONFIG_EVMS_MEMORY_REPORT)
+    size_t AllocationCount();
+
+    // Call once per frame loop iteration, allocations since the previous call count for this frame
+    void FrameEnded();
+
+    FrameAllocations FrameAllocationStats();
+
+    // Subsystems, heaps, watched task stack high-water marks and allocations per frame
+    void Report(std::ostream& stream);
+
+    // std::allocator that charges what it holds to Tag, e.g. for containers that live as long as their owner
+    template <typename T, Subsystem Tag>
+    class TaggedAllocator {
+    public:
+        using value_type = T;
+
+        template <typename Other>
+        struct rebind {
+            using other = TaggedAllocator<Other, Tag>;
+        };
+
+    public:
+        TaggedAllocator() = default;
+
+        template <typename Other>
+        TaggedAllocator(const TaggedAllocator<Other, Tag>&) {}
+
+    public:
+        T* allocate(size_t count) {
+            T* pointer = std::allocator<T>().allocate(count);
+            Charge(Tag, count * sizeof(T));
+            return pointer;
+        }
+
+        void deallocate(T* pointer, size_t count) {
+            Release(Tag, count * sizeof(T));
+            std::allocator<T>().deallocate(pointer, count);
+        }
+
+        template <typename Other>
+        bool operator==(const TaggedAllocator<Other, Tag>&) const {
+            return true;
+        }
+    };
+
+    template <typename T, Subsystem Tag>
+    using TaggedVector = std::vector<T, TaggedAllocator<T, Tag>>;
+
+    // Deleter of TaggedArray, remembers the size it releases
+    template <typename T>
+    struct TaggedArrayDeleter {
+        Subsystem subsystem = Subsystem::Other;
+        size_t count = 0;
+
+        void operator()(T* pointer) const {
+            Release(subsystem, count * sizeof(T));
+            delete[] pointer;
+        }
+    };
+
+    template <typename T>
+    using TaggedArray = std::unique_ptr<T[], TaggedArrayDeleter<T>>;
+
+    // Value-initialized like std::make_unique<T[]>
+    template <typename T>
+    TaggedArray<T> MakeTaggedArray(Subsystem subsystem, size_t count) {
+        TaggedArray<T> array(new T[count](), { subsystem, count });
+        Charge(subsystem, count * sizeof(T));
+        return array;
+    }
+
+    // Uninitialized, empty if there isn't enough memory
+    template <typename T>
+    TaggedArray<T> MakeTaggedArray(Subsystem subsystem, size_t count, const std::nothrow_t&) {
+        TaggedArray<T> array(new (std::nothrow) T[count], { subsystem, count });
+        if (array)
+            Charge(subsystem, count * sizeof(T));
+        return array;
+    }
+}
+
+} // namespace evms
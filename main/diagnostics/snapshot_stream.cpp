@@ -0,0 +1,349 @@
+#include "snapshot_stream.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#ifdef ESP_PLATFORM
+#include <esp_rom_crc.h>
+#endif
+
+#include "assets/rle.hpp"
+
+namespace evms {
+
+// Type, sequence and two 16-bit fields
+static constexpr size_t FrameHeaderSize = 6;
+static constexpr size_t FrameCrcSize = 4;
+
+// Rows frames fill up to this, or a single row if that takes more
+static constexpr size_t FramePayloadSize = 1024;
+
+static constexpr char Base64Digits[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+#ifndef ESP_PLATFORM
+static constexpr std::array<uint32_t, 256> MakeCrcTable() {
+    std::array<uint32_t, 256> table = {};
+    for (uint32_t index = 0; index < 256; ++index) {
+        uint32_t value = index;
+        for (int bit = 0; bit < 8; ++bit)
+            value = (value & 1) ? (value >> 1) ^ 0xEDB88320 : value >> 1;
+        table[index] = value;
+    }
+    return table;
+}
+
+static constexpr std::array<uint32_t, 256> CrcTable = MakeCrcTable();
+#endif
+
+// Console line of a frame without its CRC: prefix, base64 and newline
+static size_t LineSize(size_t frameSize) {
+    return std::strlen(Diagnostics::Snapshot::LinePrefix) + ((frameSize + FrameCrcSize + 2) / 3 * 4) + 1;
+}
+
+static void PutWord(uint8_t* destination, uint16_t value) {
+    destination[0] = static_cast<uint8_t>(value);
+    destination[1] = static_cast<uint8_t>(value >> 8);
+}
+
+static void PutLong(uint8_t* destination, uint32_t value) {
+    PutWord(destination, static_cast<uint16_t>(value));
+    PutWord(destination + 2, static_cast<uint16_t>(value >> 16));
+}
+
+static uint16_t GetWord(const uint8_t* source) {
+    return static_cast<uint16_t>(source[0] | (source[1] << 8));
+}
+
+static uint32_t GetLong(const uint8_t* source) {
+    return GetWord(source) | (uint32_t(GetWord(source + 2)) << 16);
+}
+
+static int Base64Value(char character) {
+    if (character >= 'A' && character <= 'Z')
+        return character - 'A';
+    if (character >= 'a' && character <= 'z')
+        return character - 'a' + 26;
+    if (character >= '0' && character <= '9')
+        return character - '0' + 52;
+    if (character == '+')
+        return 62;
+    if (character == '/')
+        return 63;
+    return -1;
+}
+
+// Returns characters written, destination holds at least 4 per 3 bytes rounded up
+static size_t Base64Encode(std::span<const uint8_t> bytes, char* destination) {
+    size_t position = 0;
+    for (size_t index = 0; index < bytes.size(); index += 3) {
+        size_t count = std::min<size_t>(bytes.size() - index, 3);
+        uint32_t group = bytes[index] << 16;
+        if (count > 1)
+            group |= bytes[index + 1] << 8;
+        if (count > 2)
+            group |= bytes[index + 2];
+        destination[position++] = Base64Digits[(group >> 18) & 0x3F];
+        destination[position++] = Base64Digits[(group >> 12) & 0x3F];
+        destination[position++] = count > 1 ? Base64Digits[(group >> 6) & 0x3F] : '=';
+        destination[position++] = count > 2 ? Base64Digits[group & 0x3F] : '=';
+    }
+    return position;
+}
+
+// False on characters outside the alphabet, stops at padding or the end of text
+static bool Base64Decode(std::string_view text, std::vector<uint8_t>& bytes) {
+    uint32_t group = 0;
+    int bits = 0;
+    for (char character : text) {
+        if (character == '=')
+            break;
+        int value = Base64Value(character);
+        if (value < 0)
+            return false;
+        group = (group << 6) | value;
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            bytes.push_back(static_cast<uint8_t>(group >> bits));
+        }
+    }
+    return true;
+}
+
+uint32_t Diagnostics::Snapshot::Crc32(uint32_t crc, std::span<const uint8_t> bytes) {
+#ifdef ESP_PLATFORM
+    return esp_rom_crc32_le(crc, bytes.data(), bytes.size());
+#else
+    crc = ~crc;
+    for (uint8_t byte : bytes)
+        crc = CrcTable[(crc ^ byte) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+#endif
+}
+
+uint32_t Diagnostics::Snapshot::ImageChecksum(Display::PixelView image) {
+    uint32_t checksum = 0;
+    for (int y = 0; y < image.height(); ++y) {
+        uint8_t rowCrc[4];
+        PutLong(rowCrc, Crc32(0, { reinterpret_cast<const uint8_t*>(image.row(y)), image.width() * sizeof(uint16_t) }));
+        checksum = Crc32(checksum, rowCrc);
+    }
+    return checksum;
+}
+
+Diagnostics::SnapshotStreamer::SnapshotStreamer(Display::PixelView framebuffer, std::ostream& stream)
+    : m_framebuffer(framebuffer)
+    , m_stream(stream)
+    , m_rowCrcs(MakeTaggedArray<uint32_t>(Subsystem::Other, framebuffer.height()))
+    , m_frame(MakeTaggedArray<uint8_t>(Subsystem::Other,
+        FrameHeaderSize + std::max(FramePayloadSize, Assets::Rle::MaxEncodedSize(framebuffer.width())) + FrameCrcSize))
+    , m_line(MakeTaggedArray<char>(Subsystem::Other,
+        LineSize(FrameHeaderSize + std::max(FramePayloadSize, Assets::Rle::MaxEncodedSize(framebuffer.width())))))
+{}
+
+void Diagnostics::SnapshotStreamer::startFrame(Snapshot::FrameType type) {
+    m_frame[0] = static_cast<uint8_t>(type);
+    m_frame[1] = m_sequence;
+    m_frameSize = FrameHeaderSize;
+}
+
+size_t Diagnostics::SnapshotStreamer::writeFrame() {
+    PutLong(m_frame.get() + m_frameSize, Snapshot::Crc32(0, { m_frame.get(), m_frameSize }));
+    m_frameSize += FrameCrcSize;
+
+    size_t prefixLength = std::strlen(Snapshot::LinePrefix);
+    std::memcpy(m_line.get(), Snapshot::LinePrefix, prefixLength);
+    size_t length = prefixLength + Base64Encode({ m_frame.get(), m_frameSize }, m_line.get() + prefixLength);
+    m_line[length++] = '\n';
+    m_stream.write(m_line.get(), length);
+    m_bytesWritten += length;
+    return length;
+}
+
+bool Diagnostics::SnapshotStreamer::begin() {
+    if (busy())
+        return false;
+
+    m_key = m_snapshots % Snapshot::KeyInterval == 0;
+    m_state = State::Begin;
+    return true;
+}
+
+size_t Diagnostics::SnapshotStreamer::step(size_t byteBudget) {
+    size_t written = 0, rowsHashed = 0;
+    int width = m_framebuffer.width(), height = m_framebuffer.height();
+    size_t frameCapacity = FrameHeaderSize + std::max(FramePayloadSize, Assets::Rle::MaxEncodedSize(width));
+    while (m_state != State::Idle && (written == 0 || written < byteBudget)) {
+        if (m_state == State::Begin) {
+            startFrame(Snapshot::FrameType::Begin);
+            PutWord(m_frame.get() + 2, static_cast<uint16_t>(width));
+            PutWord(m_frame.get() + 4, static_cast<uint16_t>(height));
+            m_frame[m_frameSize++] = Snapshot::FormatVersion;
+            m_frame[m_frameSize++] = m_key ? Snapshot::KeyFlag : 0;
+            written += writeFrame();
+            m_state = State::Rows;
+            m_row = 0;
+            m_rowsSent = 0;
+            continue;
+        }
+
+        if (m_state == State::End) {
+            uint8_t rowCrcs[4];
+            uint32_t checksum = 0;
+            for (int y = 0; y < height; ++y) {
+                PutLong(rowCrcs, m_rowCrcs[y]);
+                checksum = Snapshot::Crc32(checksum, rowCrcs);
+            }
+
+            startFrame(Snapshot::FrameType::End);
+            PutWord(m_frame.get() + 2, static_cast<uint16_t>(m_rowsSent));
+            PutWord(m_frame.get() + 4, 0);
+            PutLong(m_frame.get() + m_frameSize, checksum);
+            m_frameSize += 4;
+            written += writeFrame();
+            m_state = State::Idle;
+            ++m_sequence;
+            ++m_snapshots;
+            break;
+        }
+
+        // Consecutive changed rows go into one frame until it's full, an unchanged row or the budget ends it
+        startFrame(Snapshot::FrameType::Rows);
+        int firstRow = m_row, rowCount = 0;
+        while (m_row < height && rowsHashed < MaxRowsPerStep) {
+            std::span<const uint16_t> row(m_framebuffer.row(m_row), width);
+            uint32_t crc = Snapshot::Crc32(0, { reinterpret_cast<const uint8_t*>(row.data()), row.size_bytes() });
+            ++rowsHashed;
+            if (!m_key && crc == m_rowCrcs[m_row]) {
+                ++m_row;
+                if (rowCount)
+                    break;
+                continue;
+            }
+
+            std::span<uint8_t> free(m_frame.get() + m_frameSize, frameCapacity - m_frameSize);
+            size_t encoded = Assets::Rle::Encode(row, free);
+            if (encoded == 0 || (rowCount && written + LineSize(m_frameSize + encoded) > byteBudget))
+                break;
+
+            if (rowCount == 0)
+                firstRow = m_row;
+            m_frameSize += encoded;
+            m_rowCrcs[m_row++] = crc;
+            ++rowCount;
+        }
+
+        if (rowCount) {
+            PutWord(m_frame.get() + 2, static_cast<uint16_t>(firstRow));
+            PutWord(m_frame.get() + 4, static_cast<uint16_t>(rowCount));
+            written += writeFrame();
+            m_rowsSent += rowCount;
+        }
+        if (m_row >= height)
+            m_state = State::End;
+        else if (rowsHashed >= MaxRowsPerStep || rowCount == 0)
+            break;
+    }
+
+    if (written)
+        m_stream.flush();
+    return written;
+}
+
+bool Diagnostics::SnapshotReceiver::frame(std::span<const uint8_t> bytes) {
+    if (bytes.size() < FrameHeaderSize + FrameCrcSize) {
+        ++m_badFrames;
+        return false;
+    }
+    size_t size = bytes.size() - FrameCrcSize;
+    if (Snapshot::Crc32(0, bytes.first(size)) != GetLong(bytes.data() + size)) {
+        ++m_badFrames;
+        return false;
+    }
+
+    uint8_t sequence = bytes[1];
+    uint16_t first = GetWord(bytes.data() + 2), second = GetWord(bytes.data() + 4);
+    std::span<const uint8_t> body = bytes.subspan(FrameHeaderSize, size - FrameHeaderSize);
+    auto lose = [this]() {
+        ++m_dropped;
+        m_receiving = false;
+        m_synced = false;
+        return false;
+    };
+
+    switch (static_cast<Snapshot::FrameType>(bytes[0])) {
+        case Snapshot::FrameType::Begin: {
+            if (body.size() < 2 || body[0] != Snapshot::FormatVersion || first == 0 || second == 0) {
+                ++m_badFrames;
+                return false;
+            }
+            if (m_receiving)
+                lose();
+
+            // Dimensions2D compares by area
+            if (first != m_dimensions.width || second != m_dimensions.height) {
+                m_dimensions = { first, second };
+                m_image.assign(static_cast<size_t>(first) * second, 0);
+                m_synced = false;
+            }
+
+            // A delta only applies on top of the snapshot right before it
+            bool key = body[1] & Snapshot::KeyFlag;
+            if (!key && !(m_synced && sequence == static_cast<uint8_t>(m_sequence + 1)))
+                return lose();
+            m_receiving = true;
+            m_sequence = sequence;
+            m_rowsReceived = 0;
+            return false;
+        }
+
+        case Snapshot::FrameType::Rows: {
+            if (!m_receiving || sequence != m_sequence)
+                return false;
+            if (first + second > m_dimensions.height)
+                return lose();
+
+            size_t pixels = static_cast<size_t>(second) * m_dimensions.width;
+            if (Assets::Rle::Decode(body, m_image.data() + (static_cast<size_t>(first) * m_dimensions.width), pixels) != pixels)
+                return lose();
+            m_rowsReceived += second;
+            return false;
+        }
+
+        case Snapshot::FrameType::End: {
+            if (!m_receiving || sequence != m_sequence)
+                return false;
+            if (body.size() < 4 || first != m_rowsReceived || Snapshot::ImageChecksum(image()) != GetLong(body.data()))
+                return lose();
+
+            m_receiving = false;
+            m_synced = true;
+            ++m_complete;
+            return true;
+        }
+
+        default:
+            ++m_badFrames;
+            return false;
+    }
+}
+
+bool Diagnostics::SnapshotReceiver::feed(std::string_view line) {
+    // Log lines may carry timestamps or colors in front of the prefix
+    size_t start = line.find(Snapshot::LinePrefix);
+    if (start == std::string_view::npos)
+        return false;
+    line.remove_prefix(start + std::strlen(Snapshot::LinePrefix));
+    while (!line.empty() && (line.back() == '\r' || line.back() == '\n' || line.back() == ' '))
+        line.remove_suffix(1);
+
+    std::vector<uint8_t> bytes;
+    if (!Base64Decode(line, bytes)) {
+        ++m_badFrames;
+        return false;
+    }
+    return frame(bytes);
+}
+
+} // namespace evms
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "diagnostics/memory_report.hpp"
+#include "display/types.hpp"
+
+namespace evms {
+
+namespace Diagnostics {
+    /*
+    *   Framebuffer snapshots streamed over the console as "snapshot: <base64>" lines,
+    *   one frame per line. A frame is a type byte, the snapshot's sequence number, a
+    *   type specific body and a CRC-32 of all that, numbers are little-endian:
+    *       Begin   width, height (16 bits each), format version, flags (bit 0: key)
+    *       Rows    first row, row count (16 bits each), the rows as Assets::Rle tokens
+    *       End     rows sent, zero (16 bits each), CRC-32 of the whole image's row CRCs
+    *   Snapshots are deltas against the previous one: only rows whose CRC changed are
+    *   sent. Every KeyInterval-th snapshot is a key snapshot holding every row, so a
+    *   receiver that joined late or lost a line catches up.
+    */
+    namespace Snapshot {
+        constexpr const char* LinePrefix = "snapshot: ";
+        constexpr uint8_t FormatVersion = 1;
+        constexpr uint8_t KeyFlag = 0x01;
+        constexpr size_t KeyInterval = 8;
+
+        enum class FrameType : uint8_t {
+            Begin = 'B',
+            Rows = 'R',
+            End = 'E',
+        };
+
+        // zlib's CRC-32, the ROM implementation on ESP32
+        uint32_t Crc32(uint32_t crc, std::span<const uint8_t> bytes);
+
+        // CRC-32 of a snapshot's row CRCs, as End frames carry it
+        uint32_t ImageChecksum(Display::PixelView image);
+    }
+
+    /*
+    *   Streams snapshots of a framebuffer a few rows per frame, so the frame loop never
+    *   stalls on a whole framebuffer worth of output. Rows are read straight from the
+    *   framebuffer as they're encoded, a snapshot spanning several frames may show rows
+    *   from different frames. Doesn't allocate after construction.
+    */
+    class SnapshotStreamer {
+    public:
+        // Rows hashed per step() at most, bounds its CPU time when little changes
+        static constexpr size_t MaxRowsPerStep = 32;
+
+    private:
+        enum class State {
+            Idle,
+            Begin,
+            Rows,
+            End,
+        };
+
+    private:
+        Display::PixelView m_framebuffer;
+        std::ostream& m_stream;
+        State m_state = State::Idle;
+        uint8_t m_sequence = 0;
+        size_t m_snapshots = 0;
+        bool m_key = false;
+        int m_row = 0;
+        int m_rowsSent = 0;
+        size_t m_bytesWritten = 0;
+
+        // CRC of every row as last sent, rows that still match are left out of delta snapshots
+        TaggedArray<uint32_t> m_rowCrcs;
+
+        // Frame being built and its base64 line
+        TaggedArray<uint8_t> m_frame;
+        size_t m_frameSize = 0;
+        TaggedArray<char> m_line;
+
+    private:
+        void startFrame(Snapshot::FrameType type);
+
+        // Appends the CRC and writes the line, returns bytes written to the stream
+        size_t writeFrame();
+
+    public:
+        // Framebuffer must outlive the streamer
+        SnapshotStreamer(Display::PixelView framebuffer, std::ostream& stream);
+
+        SnapshotStreamer(const SnapshotStreamer& other) = delete;
+
+    public:
+        SnapshotStreamer& operator=(const SnapshotStreamer& other) = delete;
+
+    public:
+        // Start a snapshot, false if one is in progress
+        bool begin();
+
+        /*
+        *   Continue the snapshot in progress, writing about byteBudget bytes to the stream.
+        *   At least one line goes out if anything is pending, so a line may overshoot
+        *   the budget. Returns bytes written.
+        */
+        size_t step(size_t byteBudget);
+
+    public:
+        inline bool busy() const {
+            return m_state != State::Idle;
+        }
+
+        inline size_t snapshots() const {
+            return m_snapshots;
+        }
+
+        inline size_t bytesWritten() const {
+            return m_bytesWritten;
+        }
+    };
+
+    /*
+    *   Reassembles snapshots from console output, e.g. on the host. Lines without
+    *   the prefix are skipped, as are frames that fail their CRC; a delta snapshot
+    *   that doesn't follow a complete one is dropped until the next key snapshot.
+    */
+    class SnapshotReceiver {
+    private:
+        Display::Dimensions2D m_dimensions = {};
+        std::vector<uint16_t> m_image;
+        bool m_synced = false;          // Image holds the last complete snapshot
+        bool m_receiving = false;
+        uint8_t m_sequence = 0;
+        int m_rowsReceived = 0;
+        size_t m_complete = 0;
+        size_t m_badFrames = 0;
+        size_t m_dropped = 0;
+
+    private:
+        bool frame(std::span<const uint8_t> bytes);
+
+    public:
+        // True if the line completed a snapshot, image() holds it then
+        bool feed(std::string_view line);
+
+    public:
+        inline Display::PixelView image() const {
+            return { m_image.data(), m_dimensions };
+        }
+
+        inline size_t complete() const {
+            return m_complete;
+        }
+
+        // Frames that didn't decode or failed their CRC
+        inline size_t badFrames() const {
+            return m_badFrames;
+        }
+
+        // Snapshots started but not completed: lost lines, wrong checksum, no key snapshot yet
+        inline size_t dropped() const {
+            return m_dropped;
+        }
+    };
+}
+
+} // namespace evms
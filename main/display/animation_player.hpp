@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+
+#include "assets/animation.hpp"
+#include "display/types.hpp"
+
+namespace evms {
+
+namespace Display {
+    /*
+    *   Plays an animation into a Screen.
+    *   Frames are decoded straight into the screen's canvas and only changed tiles are
+    *   sent, a horizontal run of them per address window, so RAM use doesn't depend on
+    *   the animation: no frame buffers besides the screen's own framebuffer.
+    */
+    class AnimationPlayer {
+    private:
+        Assets::Animation m_animation;
+        Position m_position;
+        bool m_loop = true;
+        int m_frame = 0;
+        int64_t m_nextFrameTime = -1;   // Microseconds, negative until the first frame is shown
+
+    public:
+        AnimationPlayer(Assets::Animation animation, Position position, bool loop = true)
+            : m_animation(animation)
+            , m_position(position)
+            , m_loop(loop)
+        {}
+
+    public:
+        /*
+        *   Show the next frame if it's due, call every loop iteration with Utility::TimeMicroseconds().
+        *   Delta frames build on each other, so frames are never dropped: a late frame is
+        *   shown right away and the schedule only restarts from it when playback is more
+        *   than a frame behind. Returns false once a non-looping animation has ended or if
+        *   the animation doesn't fit the screen at its position.
+        */
+        template <typename ScreenType>
+        bool update(ScreenType& screen, int64_t timeMicroseconds);
+
+        // Decode and send the next frame right away
+        template <typename ScreenType>
+        bool step(ScreenType& screen);
+
+        // Next frame will be the first one, shown right away
+        inline void restart() {
+            m_frame = 0;
+            m_nextFrameTime = -1;
+        }
+
+    public:
+        // Index of the next frame to show
+        inline int frame() const {
+            return m_frame;
+        }
+
+        inline bool finished() const {
+            return !m_loop && m_frame >= m_animation.frameCount();
+        }
+
+        inline const Assets::Animation& animation() const {
+            return m_animation;
+        }
+    };
+}
+
+} // namespace evms
+
+#include "animation_player.inl"
@@ -0,0 +1,54 @@
+namespace evms {
+
+namespace Display {
+    template <typename ScreenType>
+    bool AnimationPlayer::update(ScreenType& screen, int64_t timeMicroseconds) {
+        if (m_nextFrameTime >= 0 && timeMicroseconds < m_nextFrameTime)
+            return !finished();
+        if (!step(screen))
+            return false;
+
+        int64_t period = m_animation.frameMicroseconds();
+        if (m_nextFrameTime < 0 || timeMicroseconds - m_nextFrameTime > period)
+            m_nextFrameTime = timeMicroseconds + period;
+        else
+            m_nextFrameTime += period;
+        return true;
+    }
+
+    template <typename ScreenType>
+    bool AnimationPlayer::step(ScreenType& screen) {
+        if (m_animation.empty() || finished())
+            return false;
+        if (m_frame >= m_animation.frameCount())
+            m_frame = 0;
+
+        MutablePixelView target = screen.canvas().subview(m_position.x, m_position.y, m_animation.dimensions());
+        Assets::Animation::Frame frame = m_animation.frame(m_frame);
+        if (!m_animation.decode(frame, target))
+            return false;
+
+        // Send changed tiles, merging horizontally adjacent ones into one window
+        int tilesX = m_animation.tilesX(), tilesY = m_animation.tilesY();
+        for (int tileY = 0; tileY < tilesY; ++tileY) {
+            int runStart = -1;
+            for (int tileX = 0; tileX <= tilesX; ++tileX) {
+                int tile = tileY * tilesX + tileX;
+                bool changed = tileX < tilesX && Assets::Animation::TileChanged(frame.tileMap, tile);
+                if (changed && runStart < 0) {
+                    runStart = tile;
+                }
+                else if (!changed && runStart >= 0) {
+                    Rect run = m_animation.tileRect(runStart).united(m_animation.tileRect(tile - 1));
+                    screen.render({ m_position.x + run.x, m_position.y + run.y, run.width, run.height });
+                    runStart = -1;
+                }
+            }
+        }
+
+        ++m_frame;
+        return true;
+    }
+}
+
+} // namespace evms
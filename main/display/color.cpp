@@ -0,0 +1,94 @@
+#include "color.hpp"
+
+#include <algorithm>
+
+#include "display/kernels.hpp"
+
+namespace evms {
+
+/*
+*   Channel lookup tables: 8-bit value (plus dither threshold, hence the extra entries)
+*   to the channel's bits of a panel order pixel, saturated. A pixel is the OR of one
+*   entry from each table, with no shifting, clamping or byte swapping left to do.
+*/
+template <int Bits, int Shift>
+static constexpr auto MakeChannelTable() {
+    std::array<uint16_t, 256 + (1 << (8 - Bits))> table = {};
+    for (size_t value = 0; value < table.size(); ++value) {
+        uint16_t level = static_cast<uint16_t>(std::min<size_t>(value >> (8 - Bits), (1 << Bits) - 1) << Shift);
+        table[value] = static_cast<uint16_t>((level >> 8) | (level << 8));
+    }
+    return table;
+}
+
+static constexpr auto RedTable = MakeChannelTable<5, 11>();
+static constexpr auto GreenTable = MakeChannelTable<6, 5>();
+static constexpr auto BlueTable = MakeChannelTable<5, 0>();
+
+// 5-bit channels drop 3 bits and take thresholds 0..7, the 6-bit channel drops 2 and takes 0..3
+static inline uint16_t DitherPixel(const uint8_t* rgb, int threshold) {
+    return RedTable[rgb[0] + (threshold >> 1)] | GreenTable[rgb[1] + (threshold >> 2)] | BlueTable[rgb[2] + (threshold >> 1)];
+}
+
+uint16_t Display::Color::FromRgb888Dithered(uint8_t red, uint8_t green, uint8_t blue, int x, int y) {
+    const uint8_t rgb[3] = { red, green, blue };
+    return DitherPixel(rgb, Bayer4x4[((y & 3) * 4) + (x & 3)]);
+}
+
+void Display::Color::FromRgb888Span(uint16_t* destination, const uint8_t* rgb, int length) {
+    // Threshold 0 truncates, same tables as the dithered span
+    for (int index = 0; index < length; ++index, rgb += 3)
+        destination[index] = DitherPixel(rgb, 0);
+}
+
+void Display::Color::FromRgb888SpanDithered(uint16_t* destination, const uint8_t* rgb, int length, int x, int y) {
+    // Thresholds repeat every four pixels, rotate the matrix row so the loop starts at phase 0
+    const uint8_t* matrixRow = Bayer4x4.data() + ((y & 3) * 4);
+    const int thresholds[4] = {
+        matrixRow[x & 3], matrixRow[(x + 1) & 3], matrixRow[(x + 2) & 3], matrixRow[(x + 3) & 3]
+    };
+
+    int index = 0;
+    for (; index + 4 <= length; index += 4, rgb += 12) {
+        destination[index + 0] = DitherPixel(rgb + 0, thresholds[0]);
+        destination[index + 1] = DitherPixel(rgb + 3, thresholds[1]);
+        destination[index + 2] = DitherPixel(rgb + 6, thresholds[2]);
+        destination[index + 3] = DitherPixel(rgb + 9, thresholds[3]);
+    }
+    for (; index < length; ++index, rgb += 3)
+        destination[index] = DitherPixel(rgb, thresholds[index & 3]);
+}
+
+Display::Rect Display::Color::FillGradient(MutablePixelView view, const Rect& rect, uint32_t top, uint32_t bottom, bool dithered) {
+    Rect visible = rect.intersected({ 0, 0, view.width(), view.height() });
+    if (!visible)
+        return {};
+
+    // Colors are interpolated along the whole rect, also when it's clipped
+    int span = std::max(rect.height - 1, 1);
+    for (int y = visible.y; y < visible.y + visible.height; ++y) {
+        int step = y - rect.y;
+        uint8_t rgb[3];
+        for (int channel = 0; channel < 3; ++channel) {
+            int shift = 16 - (channel * 8);
+            int from = (top >> shift) & 0xFF, to = (bottom >> shift) & 0xFF;
+            rgb[channel] = static_cast<uint8_t>(from + ((to - from) * step) / span);
+        }
+
+        uint16_t* row = view.row(y) + visible.x;
+        if (!dithered) {
+            Kernels::FillSpan(row, visible.width, FromRgb888(rgb[0], rgb[1], rgb[2]));
+            continue;
+        }
+
+        // One color per row: the dithered row is a pattern of four pixels
+        uint16_t pattern[4];
+        for (int index = 0; index < 4; ++index)
+            pattern[index] = FromRgb888Dithered(rgb[0], rgb[1], rgb[2], visible.x + index, y);
+        for (int index = 0; index < visible.width; ++index)
+            row[index] = pattern[index & 3];
+    }
+    return visible;
+}
+
+} // namespace evms
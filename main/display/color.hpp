@@ -0,0 +1,50 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "display/types.hpp"
+
+namespace evms {
+
+namespace Display {
+    /*
+    *   RGB888 to RGB565 conversion at runtime, for decoders, gradients and anything else
+    *   not baked into RGB565 ahead of time. Results are in panel byte order.
+    *   Plain conversion truncates every channel, like the host image tools do. Ordered
+    *   dithering adds a 4x4 Bayer threshold before truncating, so areas average out to
+    *   the 8-bit color instead of banding. The threshold depends on the pixel's position,
+    *   spans take the position of their first pixel.
+    */
+    namespace Color {
+        // Bayer matrix, row-major, values 0..15
+        constexpr std::array<uint8_t, 16> Bayer4x4 = {
+             0,  8,  2, 10,
+            12,  4, 14,  6,
+             3, 11,  1,  9,
+            15,  7, 13,  5,
+        };
+
+        constexpr uint16_t FromRgb888(uint8_t red, uint8_t green, uint8_t blue) {
+            uint16_t pixel = ((red & 0xF8) << 8) | ((green & 0xFC) << 3) | (blue >> 3);
+            return static_cast<uint16_t>((pixel >> 8) | (pixel << 8));
+        }
+
+        // Color given as 0xRRGGBB
+        constexpr uint16_t FromRgb888(uint32_t rgb) {
+            return FromRgb888(static_cast<uint8_t>(rgb >> 16), static_cast<uint8_t>(rgb >> 8), static_cast<uint8_t>(rgb));
+        }
+
+        uint16_t FromRgb888Dithered(uint8_t red, uint8_t green, uint8_t blue, int x, int y);
+
+        // Source is length packed R, G, B triplets
+        void FromRgb888Span(uint16_t* destination, const uint8_t* rgb, int length);
+
+        void FromRgb888SpanDithered(uint16_t* destination, const uint8_t* rgb, int length, int x, int y);
+
+        // Vertical gradient between two 0xRRGGBB colors over rect of view, clipped. Returns the rect filled.
+        Rect FillGradient(MutablePixelView view, const Rect& rect, uint32_t top, uint32_t bottom, bool dithered = true);
+    }
+}
+
+} // namespace evms
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace evms {
+
+namespace Display {
+    /*
+    *   Controller traits describe a panel controller to Screen at compile time:
+    *   Name, Dimensions (native, portrait), Frequency (SPI clock in Hz), Format,
+    *   InitSequence, MemoryAccessOrder (MADCTL without rotation bits) and command codes.
+    *   Most controllers speak MIPI DCS, so traits derive from MipiDcs and only
+    *   override what differs.
+    */
+    namespace Controllers {
+        enum class PixelFormat {
+            Rgb565,     // 2 bytes per pixel, sent straight from the framebuffer
+            Rgb666,     // 3 bytes per pixel, converted row by row while sending
+        };
+
+        /*
+        *   Init sequences are flat byte tables, one entry per command:
+        *   code, parameter count (| Wait), parameters..., [wait in ms if Wait was set]
+        *   A wait holds off the next command, e.g. after sleep out.
+        */
+        constexpr uint8_t Wait = 0x80;
+
+        // Check that entries add up exactly to the table size
+        constexpr bool ValidInitSequence(std::span<const uint8_t> sequence) {
+            size_t index = 0;
+            while (index + 2 <= sequence.size()) {
+                uint8_t header = sequence[index + 1];
+                index += 2 + (header & ~Wait) + ((header & Wait) ? 1 : 0);
+            }
+            return index == sequence.size();
+        }
+
+        struct MipiDcs {
+            static constexpr uint8_t Nop = 0x00;
+            static constexpr uint8_t SleepOut = 0x11;
+            static constexpr uint8_t InversionOff = 0x20;
+            static constexpr uint8_t InversionOn = 0x21;
+            static constexpr uint8_t DisplayOn = 0x29;
+            static constexpr uint8_t ColumnAddressSet = 0x2A;
+            static constexpr uint8_t PageAddressSet = 0x2B;
+            static constexpr uint8_t MemoryWrite = 0x2C;
+            static constexpr uint8_t VerticalScrollDefinition = 0x33;
+            static constexpr uint8_t MemoryAccessControl = 0x36;
+            static constexpr uint8_t VerticalScrollStart = 0x37;
+            static constexpr uint8_t PixelFormatSet = 0x3A;
+
+            // Pixel format parameter values for PixelFormatSet
+            static constexpr uint8_t Format16Bit = 0b0'101'0'101;
+            static constexpr uint8_t Format18Bit = 0b0'110'0'110;
+        };
+
+        template <typename Controller>
+        constexpr int BytesPerPixel() {
+            return Controller::Format == PixelFormat::Rgb666 ? 3 : 2;
+        }
+    }
+}
+
+} // namespace evms
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "display/controllers/controller.hpp"
+#include "display/types.hpp"
+
+namespace evms {
+
+namespace Display {
+    namespace Controllers {
+        // A typical 2.4" ILI9341 module, 240x320 pixels
+        struct Ili9341 : MipiDcs {
+            static constexpr const char* Name = "ILI9341";
+            static constexpr Dimensions2D Dimensions = { 240, 320 };
+            static constexpr int Frequency = 42'000'000;
+            static constexpr uint8_t MemoryAccessOrder = 0b000'000'00;
+            static constexpr PixelFormat Format = PixelFormat::Rgb565;
+
+            // Sleep out is only accepted 120 ms after reset
+            static constexpr uint8_t InitSequence[] = {
+                Nop,            Wait | 0,   120,
+                SleepOut,       Wait | 0,   120,
+                DisplayOn,      0,
+                PixelFormatSet, 1,          Format16Bit,
+            };
+        };
+    }
+}
+
+} // namespace evms
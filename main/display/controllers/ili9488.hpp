@@ -0,0 +1,33 @@
+#pragma once
+
+#include "display/controllers/controller.hpp"
+#include "display/types.hpp"
+
+namespace evms {
+
+namespace Display {
+    namespace Controllers {
+        /*
+        *   A typical 3.5" ILI9488 module, 320x480 pixels.
+        *   Its SPI interface only accepts 18-bit pixels, so the framebuffer stays RGB565
+        *   and rows are expanded while sending. The framebuffer takes 300 KB: needs PSRAM.
+        */
+        struct Ili9488 : MipiDcs {
+            static constexpr const char* Name = "ILI9488";
+            static constexpr Dimensions2D Dimensions = { 320, 480 };
+            static constexpr int Frequency = 26'666'666;
+            static constexpr uint8_t MemoryAccessOrder = 0b000'010'00;   // BGR panel
+            static constexpr PixelFormat Format = PixelFormat::Rgb666;
+
+            // Sleep out is only accepted 120 ms after reset
+            static constexpr uint8_t InitSequence[] = {
+                Nop,            Wait | 0,   120,
+                SleepOut,       Wait | 0,   120,
+                PixelFormatSet, 1,          Format18Bit,
+                DisplayOn,      Wait | 0,   20,
+            };
+        };
+    }
+}
+
+} // namespace evms
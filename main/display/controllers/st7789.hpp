@@ -0,0 +1,30 @@
+#pragma once
+
+#include "display/controllers/controller.hpp"
+#include "display/types.hpp"
+
+namespace evms {
+
+namespace Display {
+    namespace Controllers {
+        // A typical 2" ST7789 IPS module, 240x320 pixels
+        struct St7789 : MipiDcs {
+            static constexpr const char* Name = "ST7789";
+            static constexpr Dimensions2D Dimensions = { 240, 320 };
+            static constexpr int Frequency = 40'000'000;
+            static constexpr uint8_t MemoryAccessOrder = 0b000'000'00;
+            static constexpr PixelFormat Format = PixelFormat::Rgb565;
+
+            // Sleep out is only accepted 120 ms after reset
+            static constexpr uint8_t InitSequence[] = {
+                Nop,            Wait | 0,   120,
+                SleepOut,       Wait | 0,   120,
+                PixelFormatSet, Wait | 1,   Format16Bit,    10,
+                InversionOn,    0,                          // IPS panels are wired inverted
+                DisplayOn,      Wait | 0,   10,
+            };
+        };
+    }
+}
+
+} // namespace evms
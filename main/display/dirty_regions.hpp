@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <array>
+
+#include "display/types.hpp"
+
+namespace evms {
+
+namespace Display {
+    /*
+    *   Fixed-capacity list of changed screen regions.
+    *   Overlapping or touching rects are merged on insertion. When the list is full
+    *   the new rect is merged into the entry whose bounding box grows the least,
+    *   so no pixel is ever lost and no allocation ever happens.
+    */
+    template <size_t Capacity>
+    class DirtyRegions {
+    private:
+        std::array<Rect, Capacity> m_rects = {};
+        size_t m_size = 0;
+
+    private:
+        static inline bool Touch(const Rect& first, const Rect& second) {
+            return (
+                first.x <= second.x + second.width && second.x <= first.x + first.width &&
+                first.y <= second.y + second.height && second.y <= first.y + first.height
+            );
+        }
+
+        inline void remove(size_t index) {
+            m_rects[index] = m_rects[--m_size];
+        }
+
+        // Merge rect at index with every other rect it touches, as merging may create new contacts
+        inline void coalesce(size_t index) {
+            for (size_t other = 0; other < m_size; ++other) {
+                if (other == index || !Touch(m_rects[index], m_rects[other]))
+                    continue;
+
+                m_rects[index] = m_rects[index].united(m_rects[other]);
+                if (index == m_size - 1)
+                    index = other;
+                remove(other);
+                other = static_cast<size_t>(-1);
+            }
+        }
+
+    public:
+        inline void add(const Rect& rect) {
+            if (!rect)
+                return;
+
+            for (size_t index = 0; index < m_size; ++index) {
+                if (Touch(m_rects[index], rect)) {
+                    m_rects[index] = m_rects[index].united(rect);
+                    coalesce(index);
+                    return;
+                }
+            }
+
+            if (m_size < Capacity) {
+                m_rects[m_size++] = rect;
+                return;
+            }
+
+            size_t best = 0;
+            int bestGrowth = -1;
+            for (size_t index = 0; index < m_size; ++index) {
+                int growth = m_rects[index].united(rect).area() - m_rects[index].area();
+                if (bestGrowth < 0 || growth < bestGrowth) {
+                    best = index;
+                    bestGrowth = growth;
+                }
+            }
+            m_rects[best] = m_rects[best].united(rect);
+            coalesce(best);
+        }
+
+        inline void clear() {
+            m_size = 0;
+        }
+
+    public:
+        inline size_t size() const {
+            return m_size;
+        }
+
+        inline bool empty() const {
+            return m_size == 0;
+        }
+
+        // Total number of pixels covered
+        inline int area() const {
+            int result = 0;
+            for (size_t index = 0; index < m_size; ++index)
+                result += m_rects[index].area();
+            return result;
+        }
+
+        inline Rect bounds() const {
+            Rect result;
+            for (size_t index = 0; index < m_size; ++index)
+                result = result.united(m_rects[index]);
+            return result;
+        }
+
+        inline const Rect* begin() const {
+            return m_rects.data();
+        }
+
+        inline const Rect* end() const {
+            return m_rects.data() + m_size;
+        }
+
+        inline const Rect& operator[](size_t index) const {
+            return m_rects[index];
+        }
+    };
+}
+
+} // namespace evms
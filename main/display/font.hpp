@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+namespace evms {
+
+namespace Display {
+    struct Glyph {
+        uint16_t offset;    // Byte offset of glyph pixels in font bitmap
+        uint8_t width;      // Size of glyph pixels (the ink box), may be 0
+        uint8_t height;
+        int8_t xOffset;     // Ink box position relative to the pen position (top of line)
+        int8_t yOffset;
+        uint8_t advance;    // Distance to the next pen position
+    };
+
+    /*
+    *   Pre-rasterised font stored in flash.
+    *   Glyph pixels are packed row-major, most significant bits first, as one continuous
+    *   stream per glyph starting at a byte boundary. 1 bit per pixel is ink coverage on/off,
+    *   4 bits per pixel is anti-aliased coverage from 0 (background) to 15 (foreground).
+    */
+    struct Font {
+        const uint8_t* bitmap;
+        const Glyph* glyphs;
+        char firstCharacter;
+        char lastCharacter;
+        uint8_t bitsPerPixel;
+        uint8_t lineHeight;
+
+        // Characters outside of the font range are drawn as '?', or as the first glyph if there's no '?'
+        constexpr const Glyph& glyph(char character) const {
+            if (character < firstCharacter || character > lastCharacter)
+                character = ('?' >= firstCharacter && '?' <= lastCharacter) ? '?' : firstCharacter;
+            return glyphs[character - firstCharacter];
+        }
+    };
+}
+
+} // namespace evms
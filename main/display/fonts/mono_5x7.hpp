@@ -0,0 +1,145 @@
+#pragma once
+
+#include "display/font.hpp"
+
+namespace evms {
+
+namespace Fonts {
+    // 5x7 ASCII font in 6x8 cells, 1 bit per pixel, generated from glyph art by tools/font_converter:
+    //     font_converter --header main/display/fonts/mono_5x7.hpp --name Mono5x7 main/display/fonts/mono_5x7.png
+    static constexpr uint8_t Mono5x7Bitmap[] = {
+        0xFA, 0xB6, 0x80, 0x52, 0xBE, 0xAF, 0xA9, 0x40, 0x23, 0xE8, 0xE2, 0xF8, 0x80, 0xC6, 0x44, 0x44,
+        0x4C, 0x60, 0x64, 0xA8, 0x8A, 0xC9, 0xA0, 0x58, 0x2A, 0x48, 0x88, 0x88, 0x92, 0xA0, 0x25, 0x5D,
+        0x52, 0x00, 0x21, 0x3E, 0x42, 0x00, 0xD8, 0xF8, 0xF0, 0x08, 0x88, 0x88, 0x00, 0x74, 0x67, 0x5C,
+        0xC5, 0xC0, 0x59, 0x24, 0xB8, 0x74, 0x42, 0x22, 0x23, 0xE0, 0xF8, 0x88, 0x20, 0xC5, 0xC0, 0x11,
+        0x95, 0x2F, 0x88, 0x40, 0xFC, 0x3C, 0x10, 0xC5, 0xC0, 0x32, 0x21, 0xE8, 0xC5, 0xC0, 0xF8, 0x44,
+        0x44, 0x21, 0x00, 0x74, 0x62, 0xE8, 0xC5, 0xC0, 0x74, 0x62, 0xF0, 0x89, 0x80, 0xF3, 0xC0, 0xF3,
+        0x60, 0x12, 0x48, 0x42, 0x10, 0xF8, 0x3E, 0x84, 0x21, 0x24, 0x80, 0x74, 0x42, 0x22, 0x00, 0x80,
+        0x74, 0x42, 0xDA, 0xD5, 0xC0, 0x74, 0x63, 0xF8, 0xC6, 0x20, 0xF4, 0x63, 0xE8, 0xC7, 0xC0, 0x74,
+        0x61, 0x08, 0x45, 0xC0, 0xE4, 0xA3, 0x18, 0xCB, 0x80, 0xFC, 0x21, 0xE8, 0x43, 0xE0, 0xFC, 0x21,
+        0xE8, 0x42, 0x00, 0x74, 0x61, 0x78, 0xC5, 0xE0, 0x8C, 0x63, 0xF8, 0xC6, 0x20, 0xE9, 0x24, 0xB8,
+        0x38, 0x84, 0x21, 0x49, 0x80, 0x8C, 0xA9, 0x8A, 0x4A, 0x20, 0x84, 0x21, 0x08, 0x43, 0xE0, 0x8E,
+        0xEB, 0x58, 0xC6, 0x20, 0x8C, 0x73, 0x59, 0xC6, 0x20, 0x74, 0x63, 0x18, 0xC5, 0xC0, 0xF4, 0x63,
+        0xE8, 0x42, 0x00, 0x74, 0x63, 0x1A, 0xC9, 0xA0, 0xF4, 0x63, 0xEA, 0x4A, 0x20, 0x7C, 0x20, 0xE0,
+        0x87, 0xC0, 0xF9, 0x08, 0x42, 0x10, 0x80, 0x8C, 0x63, 0x18, 0xC5, 0xC0, 0x8C, 0x63, 0x18, 0xA8,
+        0x80, 0x8C, 0x63, 0x5A, 0xD5, 0x40, 0x8C, 0x54, 0x45, 0x46, 0x20, 0x8C, 0x54, 0x42, 0x10, 0x80,
+        0xF8, 0x44, 0x44, 0x43, 0xE0, 0xF2, 0x49, 0x38, 0x82, 0x08, 0x20, 0x80, 0xE4, 0x92, 0x78, 0x22,
+        0xA2, 0xF8, 0x88, 0x80, 0x70, 0x5F, 0x17, 0x80, 0x84, 0x2D, 0x98, 0xC7, 0xC0, 0x74, 0x21, 0x17,
+        0x00, 0x08, 0x5B, 0x38, 0xC5, 0xE0, 0x74, 0x7F, 0x07, 0x00, 0x32, 0x51, 0xC4, 0x21, 0x00, 0x7C,
+        0x62, 0xF0, 0xB8, 0x84, 0x2D, 0x98, 0xC6, 0x20, 0x43, 0x24, 0xB8, 0x10, 0x31, 0x19, 0x60, 0x88,
+        0x9A, 0xCA, 0x90, 0xC9, 0x24, 0xB8, 0xD5, 0x6B, 0x18, 0x80, 0xB6, 0x63, 0x18, 0x80, 0x74, 0x63,
+        0x17, 0x00, 0xF4, 0x7D, 0x08, 0x00, 0x6C, 0xDE, 0x10, 0x80, 0xB6, 0x61, 0x08, 0x00, 0x74, 0x1C,
+        0x1F, 0x00, 0x42, 0x38, 0x84, 0x24, 0xC0, 0x8C, 0x63, 0x36, 0x80, 0x8C, 0x62, 0xA2, 0x00, 0x8C,
+        0x6B, 0x55, 0x00, 0x8A, 0x88, 0xA8, 0x80, 0x8C, 0x5E, 0x17, 0x00, 0xF8, 0x88, 0x8F, 0x80, 0x29,
+        0x44, 0x88, 0xFE, 0x89, 0x14, 0xA0, 0x45, 0x44,
+    };
+
+    static constexpr Display::Glyph Mono5x7Glyphs[] = {
+        {   0, 0, 0, 0, 0, 6 },   //  
+        {   0, 1, 7, 2, 0, 6 },   // !
+        {   1, 3, 3, 1, 0, 6 },   // "
+        {   3, 5, 7, 0, 0, 6 },   // #
+        {   8, 5, 7, 0, 0, 6 },   // $
+        {  13, 5, 7, 0, 0, 6 },   // %
+        {  18, 5, 7, 0, 0, 6 },   // &
+        {  23, 2, 3, 1, 0, 6 },   // quote
+        {  24, 3, 7, 1, 0, 6 },   // (
+        {  27, 3, 7, 1, 0, 6 },   // )
+        {  30, 5, 5, 0, 1, 6 },   // *
+        {  34, 5, 5, 0, 1, 6 },   // +
+        {  38, 2, 3, 1, 4, 6 },   // ,
+        {  39, 5, 1, 0, 3, 6 },   // -
+        {  40, 2, 2, 1, 5, 6 },   // .
+        {  41, 5, 5, 0, 1, 6 },   // /
+        {  45, 5, 7, 0, 0, 6 },   // 0
+        {  50, 3, 7, 1, 0, 6 },   // 1
+        {  53, 5, 7, 0, 0, 6 },   // 2
+        {  58, 5, 7, 0, 0, 6 },   // 3
+        {  63, 5, 7, 0, 0, 6 },   // 4
+        {  68, 5, 7, 0, 0, 6 },   // 5
+        {  73, 5, 7, 0, 0, 6 },   // 6
+        {  78, 5, 7, 0, 0, 6 },   // 7
+        {  83, 5, 7, 0, 0, 6 },   // 8
+        {  88, 5, 7, 0, 0, 6 },   // 9
+        {  93, 2, 5, 1, 1, 6 },   // :
+        {  95, 2, 6, 1, 1, 6 },   // ;
+        {  97, 4, 7, 0, 0, 6 },   // <
+        { 101, 5, 3, 0, 2, 6 },   // =
+        { 103, 4, 7, 1, 0, 6 },   // >
+        { 107, 5, 7, 0, 0, 6 },   // ?
+        { 112, 5, 7, 0, 0, 6 },   // @
+        { 117, 5, 7, 0, 0, 6 },   // A
+        { 122, 5, 7, 0, 0, 6 },   // B
+        { 127, 5, 7, 0, 0, 6 },   // C
+        { 132, 5, 7, 0, 0, 6 },   // D
+        { 137, 5, 7, 0, 0, 6 },   // E
+        { 142, 5, 7, 0, 0, 6 },   // F
+        { 147, 5, 7, 0, 0, 6 },   // G
+        { 152, 5, 7, 0, 0, 6 },   // H
+        { 157, 3, 7, 1, 0, 6 },   // I
+        { 160, 5, 7, 0, 0, 6 },   // J
+        { 165, 5, 7, 0, 0, 6 },   // K
+        { 170, 5, 7, 0, 0, 6 },   // L
+        { 175, 5, 7, 0, 0, 6 },   // M
+        { 180, 5, 7, 0, 0, 6 },   // N
+        { 185, 5, 7, 0, 0, 6 },   // O
+        { 190, 5, 7, 0, 0, 6 },   // P
+        { 195, 5, 7, 0, 0, 6 },   // Q
+        { 200, 5, 7, 0, 0, 6 },   // R
+        { 205, 5, 7, 0, 0, 6 },   // S
+        { 210, 5, 7, 0, 0, 6 },   // T
+        { 215, 5, 7, 0, 0, 6 },   // U
+        { 220, 5, 7, 0, 0, 6 },   // V
+        { 225, 5, 7, 0, 0, 6 },   // W
+        { 230, 5, 7, 0, 0, 6 },   // X
+        { 235, 5, 7, 0, 0, 6 },   // Y
+        { 240, 5, 7, 0, 0, 6 },   // Z
+        { 245, 3, 7, 1, 0, 6 },   // [
+        { 248, 5, 5, 0, 1, 6 },   // backslash
+        { 252, 3, 7, 1, 0, 6 },   // ]
+        { 255, 5, 3, 0, 0, 6 },   // ^
+        { 257, 5, 1, 0, 6, 6 },   // _
+        { 258, 3, 3, 1, 0, 6 },   // `
+        { 260, 5, 5, 0, 2, 6 },   // a
+        { 264, 5, 7, 0, 0, 6 },   // b
+        { 269, 5, 5, 0, 2, 6 },   // c
+        { 273, 5, 7, 0, 0, 6 },   // d
+        { 278, 5, 5, 0, 2, 6 },   // e
+        { 282, 5, 7, 0, 0, 6 },   // f
+        { 287, 5, 6, 0, 1, 6 },   // g
+        { 291, 5, 7, 0, 0, 6 },   // h
+        { 296, 3, 7, 1, 0, 6 },   // i
+        { 299, 4, 7, 0, 0, 6 },   // j
+        { 303, 4, 7, 0, 0, 6 },   // k
+        { 307, 3, 7, 1, 0, 6 },   // l
+        { 310, 5, 5, 0, 2, 6 },   // m
+        { 314, 5, 5, 0, 2, 6 },   // n
+        { 318, 5, 5, 0, 2, 6 },   // o
+        { 322, 5, 5, 0, 2, 6 },   // p
+        { 326, 5, 5, 0, 2, 6 },   // q
+        { 330, 5, 5, 0, 2, 6 },   // r
+        { 334, 5, 5, 0, 2, 6 },   // s
+        { 338, 5, 7, 0, 0, 6 },   // t
+        { 343, 5, 5, 0, 2, 6 },   // u
+        { 347, 5, 5, 0, 2, 6 },   // v
+        { 351, 5, 5, 0, 2, 6 },   // w
+        { 355, 5, 5, 0, 2, 6 },   // x
+        { 359, 5, 5, 0, 2, 6 },   // y
+        { 363, 5, 5, 0, 2, 6 },   // z
+        { 367, 3, 7, 1, 0, 6 },   // {
+        { 370, 1, 7, 2, 0, 6 },   // |
+        { 371, 3, 7, 1, 0, 6 },   // }
+        { 374, 5, 3, 0, 2, 6 },   // ~
+    };
+
+    static constexpr Display::Font Mono5x7 = {
+        .bitmap = Mono5x7Bitmap,
+        .glyphs = Mono5x7Glyphs,
+        .firstCharacter = ' ',
+        .lastCharacter = '~',
+        .bitsPerPixel = 1,
+        .lineHeight = 8,
+    };
+}
+
+} // namespace evms
@@ -0,0 +1,57 @@
+#include "frame_diff.hpp"
+
+#include <cstring>
+
+namespace evms {
+
+static inline bool IsAligned(const void* pointer) {
+    return (reinterpret_cast<uintptr_t>(pointer) & 0b11) == 0;
+}
+
+static inline uint32_t LoadPair(const uint16_t* pixels) {
+    uint32_t pair;
+    std::memcpy(&pair, __builtin_assume_aligned(pixels, 4), sizeof(pair));
+    return pair;
+}
+
+bool Display::FindChangedSpan(const uint16_t* current, const uint16_t* previous, int length, int& first, int& last) {
+    if (length <= 0 || std::memcmp(current, previous, length * sizeof(uint16_t)) == 0)
+        return false;
+
+    bool pairs = IsAligned(current) == IsAligned(previous);
+
+    // Rows differ, so both scans are guaranteed to stop inside the row
+    first = 0;
+    if (pairs) {
+        // Unaligned rows compare their first pixel alone, pairs start at the aligned index after it
+        int start = IsAligned(current) ? 0 : 1;
+        if (start == 0 || current[0] == previous[0]) {
+            first = start;
+            while (first + 2 <= length && LoadPair(current + first) == LoadPair(previous + first))
+                first += 2;
+        }
+    }
+    while (current[first] == previous[first])
+        ++first;
+
+    last = length - 1;
+    if (pairs) {
+        // Scan pairs ending at an aligned boundary
+        int end = length;
+        if (!IsAligned(current + end)) {
+            if (current[end - 1] != previous[end - 1]) {
+                last = end - 1;
+                return true;
+            }
+            --end;
+        }
+        while (end - 2 > first && LoadPair(current + end - 2) == LoadPair(previous + end - 2))
+            end -= 2;
+        last = end - 1;
+    }
+    while (current[last] == previous[last])
+        --last;
+    return true;
+}
+
+} // namespace evms
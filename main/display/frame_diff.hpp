@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+
+#include "display/types.hpp"
+
+namespace evms {
+
+namespace Display {
+    /*
+    *   Find the first and last differing pixel of two rows.
+    *   Equal rows are rejected with memcmp, differing ones are scanned from both ends
+    *   two pixels at a time when the rows are equally aligned.
+    *   Returns false if rows are equal.
+    */
+    bool FindChangedSpan(const uint16_t* current, const uint16_t* previous, int length, int& first, int& last);
+
+    /*
+    *   Report rects covering every pixel of region that differs between current and previous.
+    *   Each row is reduced to its changed span, consecutive rows with overlapping spans are
+    *   merged into one rect and unchanged rows split rects apart.
+    *   Callback receives a Rect in view coordinates.
+    */
+    template <typename Callback>
+    void ForEachChangedRect(PixelView current, PixelView previous, const Rect& region, Callback&& callback) {
+        Rect open;
+        for (int y = region.y; y < region.y + region.height; ++y) {
+            int first, last;
+            bool changed = FindChangedSpan(current.row(y) + region.x, previous.row(y) + region.x, region.width, first, last);
+            if (!changed) {
+                if (open) {
+                    callback(open);
+                    open = {};
+                }
+                continue;
+            }
+
+            Rect span = { region.x + first, y, last - first + 1, 1 };
+            if (open && span.x < open.x + open.width && open.x < span.x + span.width) {
+                open = open.united(span);
+                continue;
+            }
+
+            if (open)
+                callback(open);
+            open = span;
+        }
+
+        if (open)
+            callback(open);
+    }
+}
+
+} // namespace evms
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstdint>
+#include <array>
+#include <algorithm>
+#include <initializer_list>
+
+#include "display/types.hpp"
+
+namespace evms {
+
+namespace Display {
+    /*
+    *   Palette indexed image, 4 or 8 bits per pixel. 4-bit rows hold two pixels per byte,
+    *   first in the high nibble, and are padded to a whole byte. Palette entries are
+    *   RGB565 in panel byte order. Same layout as Indexed4/Indexed8 assets.
+    */
+    template <Dimensions2D Dimensions, int BitsPerPixel>
+    class IndexedPixelMap {
+        static_assert(BitsPerPixel == 4 || BitsPerPixel == 8, "Only 4 and 8 bits per pixel are supported");
+
+    public:
+        static constexpr int RowBytes = (Dimensions.width * BitsPerPixel + 7) / 8;
+        static constexpr int PaletteSize = 1 << BitsPerPixel;
+
+    private:
+        std::array<uint16_t, PaletteSize> m_palette = {};
+        std::array<uint8_t, RowBytes * Dimensions.height> m_indices = {};
+
+    public:
+        constexpr IndexedPixelMap(std::initializer_list<uint16_t> palette, std::initializer_list<uint8_t> indices) {
+            std::copy_n(palette.begin(), std::min<size_t>(palette.size(), PaletteSize), m_palette.begin());
+            std::copy_n(indices.begin(), std::min(indices.size(), m_indices.size()), m_indices.begin());
+        }
+
+    public:
+        constexpr const uint16_t* palette() const {
+            return m_palette.data();
+        }
+
+        constexpr const uint8_t* indices() const {
+            return m_indices.data();
+        }
+
+        constexpr Dimensions2D dimensions() const {
+            return Dimensions;
+        }
+
+        constexpr int bitsPerPixel() const {
+            return BitsPerPixel;
+        }
+    };
+
+    // Non-owning view of palette indexed pixels, stride is the distance between rows in bytes
+    class IndexedPixelView {
+    private:
+        const uint8_t* m_indices = nullptr;
+        const uint16_t* m_palette = nullptr;
+        int m_width = 0;
+        int m_height = 0;
+        int m_stride = 0;
+        int m_bitsPerPixel = 8;
+
+    public:
+        constexpr IndexedPixelView() = default;
+
+        constexpr IndexedPixelView(const uint8_t* indices, const uint16_t* palette, Dimensions2D dimensions, int bitsPerPixel)
+            : m_indices(indices)
+            , m_palette(palette)
+            , m_width(dimensions.width)
+            , m_height(dimensions.height)
+            , m_stride((dimensions.width * bitsPerPixel + 7) / 8)
+            , m_bitsPerPixel(bitsPerPixel)
+        {}
+
+        template <Dimensions2D Dimensions, int BitsPerPixel>
+        constexpr IndexedPixelView(const IndexedPixelMap<Dimensions, BitsPerPixel>& map)
+            : IndexedPixelView(map.indices(), map.palette(), Dimensions, BitsPerPixel)
+        {}
+
+    public:
+        constexpr const uint8_t* indices() const {
+            return m_indices;
+        }
+
+        constexpr const uint16_t* palette() const {
+            return m_palette;
+        }
+
+        constexpr int width() const {
+            return m_width;
+        }
+
+        constexpr int height() const {
+            return m_height;
+        }
+
+        constexpr int stride() const {
+            return m_stride;
+        }
+
+        constexpr int bitsPerPixel() const {
+            return m_bitsPerPixel;
+        }
+
+        constexpr Dimensions2D dimensions() const {
+            return { m_width, m_height };
+        }
+
+        constexpr const uint8_t* row(int y) const {
+            return m_indices + (y * m_stride);
+        }
+
+    public:
+        constexpr operator bool() const {
+            return m_indices && m_palette && m_width > 0 && m_height > 0;
+        }
+    };
+}
+
+} // namespace evms
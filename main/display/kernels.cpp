@@ -0,0 +1,280 @@
+#include "kernels.hpp"
+
+#include <cstring>
+#include <utility>
+#include <algorithm>
+
+namespace evms {
+
+/*
+*   RGB565 field masks for a native pixel in a 32-bit word.
+*   Blend50Mask clears the lowest bit of every field so that halving can't borrow across fields.
+*   BlendLowMask spreads the fields (green on top) with enough spare bits above each of them
+*   to be multiplied by a 5-bit alpha (0..32) without spilling into their neighbours.
+*/
+static constexpr uint32_t Blend50Mask = 0xF7DE'F7DE;
+static constexpr uint32_t BlendLowMask = 0x07E0'F81F;
+
+static inline bool IsAligned(const void* pointer) {
+    return (reinterpret_cast<uintptr_t>(pointer) & 0b11) == 0;
+}
+
+static inline uint32_t LoadPair(const uint16_t* pixels) {
+    uint32_t pair;
+    std::memcpy(&pair, __builtin_assume_aligned(pixels, 4), sizeof(pair));
+    return pair;
+}
+
+static inline void StorePair(uint16_t* pixels, uint32_t pair) {
+    std::memcpy(__builtin_assume_aligned(pixels, 4), &pair, sizeof(pair));
+}
+
+// Panel order pixels are byte-swapped in memory
+static inline uint16_t ToNative(uint16_t pixel) {
+    return __builtin_bswap16(pixel);
+}
+
+static inline uint16_t Blend50Pixel(uint16_t destination, uint16_t source) {
+    uint32_t nativeDestination = ToNative(destination);
+    uint32_t nativeSource = ToNative(source);
+    uint32_t result = (nativeDestination & nativeSource) + (((nativeDestination ^ nativeSource) & Blend50Mask) >> 1);
+    return ToNative(static_cast<uint16_t>(result));
+}
+
+static inline uint16_t BlendPixel(uint16_t destination, uint16_t source, uint32_t alpha) {
+    // Spread the pixel over a word (green on top) so all three fields can be multiplied at once
+    uint32_t nativeDestination = ToNative(destination);
+    uint32_t nativeSource = ToNative(source);
+    nativeDestination = (nativeDestination | (nativeDestination << 16)) & BlendLowMask;
+    nativeSource = (nativeSource | (nativeSource << 16)) & BlendLowMask;
+
+    uint32_t result = ((nativeSource * alpha + nativeDestination * (32 - alpha)) >> 5) & BlendLowMask;
+    return ToNative(static_cast<uint16_t>(result | (result >> 16)));
+}
+
+uint16_t Display::Kernels::BlendColor(uint16_t destination, uint16_t source, uint8_t alpha) {
+    return BlendPixel(destination, source, (static_cast<uint32_t>(alpha) + 4) >> 3);
+}
+
+void Display::Kernels::FillSpan(uint16_t* span, int length, uint16_t color) {
+    if (length > 0)
+        std::fill_n(span, length, color);
+}
+
+void Display::Kernels::ReverseSpan(uint16_t* span, int length) {
+    if (length > 0)
+        std::reverse(span, span + length);
+}
+
+void Display::Kernels::SwapSpans(uint16_t* first, uint16_t* second, int length) {
+    if (length > 0)
+        std::swap_ranges(first, first + length, second);
+}
+
+void Display::Kernels::Blend50Span(uint16_t* destination, const uint16_t* source, int length) {
+    for (int index = 0; index < length; ++index)
+        destination[index] = Blend50Pixel(destination[index], source[index]);
+}
+
+void Display::Kernels::BlendSpan(uint16_t* destination, const uint16_t* source, int length, uint8_t alpha) {
+    if (length <= 0 || alpha == 0)
+        return;
+    if (alpha == 255) {
+        std::memcpy(destination, source, length * sizeof(uint16_t));
+        return;
+    }
+
+    // Quantize alpha to 0..32 so field products fit into their gaps
+    uint32_t alpha5 = (static_cast<uint32_t>(alpha) + 4) >> 3;
+    uint32_t inverse = 32 - alpha5;
+    for (int index = 0; index < length; ++index) {
+        // Plain per field arithmetic, which compilers vectorize where there's SIMD
+        uint32_t nativeDestination = ToNative(destination[index]);
+        uint32_t nativeSource = ToNative(source[index]);
+        uint32_t red = ((nativeSource >> 11) * alpha5 + (nativeDestination >> 11) * inverse) >> 5;
+        uint32_t green = (((nativeSource >> 5) & 0x3F) * alpha5 + ((nativeDestination >> 5) & 0x3F) * inverse) >> 5;
+        uint32_t blue = ((nativeSource & 0x1F) * alpha5 + (nativeDestination & 0x1F) * inverse) >> 5;
+        destination[index] = ToNative(static_cast<uint16_t>((red << 11) | (green << 5) | blue));
+    }
+}
+
+void Display::Kernels::ToRgb666Span(uint8_t* destination, const uint16_t* source, int length) {
+    // Working on bytes keeps this independent of host byte order: RRRRRGGG GGGBBBBB
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(source);
+    for (int index = 0; index < length; ++index, bytes += 2, destination += 3) {
+        destination[0] = bytes[0] & 0xF8;
+        destination[1] = ((bytes[0] << 5) | (bytes[1] >> 3)) & 0xFC;
+        destination[2] = bytes[1] << 3;
+    }
+}
+
+void Display::Kernels::ExpandIndexed4Span(uint16_t* destination, const uint8_t* indices, int firstPixel, int length, const uint16_t* palette) {
+    if (length <= 0)
+        return;
+
+    // Odd start: low nibble of the first byte
+    if (firstPixel) {
+        *destination++ = palette[*indices++ & 0x0F];
+        --length;
+    }
+
+    // Eight pixels per iteration
+    for (; length >= 8; length -= 8, indices += 4, destination += 8) {
+        uint8_t first = indices[0], second = indices[1], third = indices[2], fourth = indices[3];
+        destination[0] = palette[first >> 4];
+        destination[1] = palette[first & 0x0F];
+        destination[2] = palette[second >> 4];
+        destination[3] = palette[second & 0x0F];
+        destination[4] = palette[third >> 4];
+        destination[5] = palette[third & 0x0F];
+        destination[6] = palette[fourth >> 4];
+        destination[7] = palette[fourth & 0x0F];
+    }
+    for (; length >= 2; length -= 2, ++indices, destination += 2) {
+        destination[0] = palette[*indices >> 4];
+        destination[1] = palette[*indices & 0x0F];
+    }
+    if (length)
+        *destination = palette[*indices >> 4];
+}
+
+void Display::Kernels::ExpandIndexed8Span(uint16_t* destination, const uint8_t* indices, int length, const uint16_t* palette) {
+    int index = 0;
+    for (; index + 4 <= length; index += 4) {
+        destination[index + 0] = palette[indices[index + 0]];
+        destination[index + 1] = palette[indices[index + 1]];
+        destination[index + 2] = palette[indices[index + 2]];
+        destination[index + 3] = palette[indices[index + 3]];
+    }
+    for (; index < length; ++index)
+        destination[index] = palette[indices[index]];
+}
+
+void Display::Kernels::Copy(uint16_t* destination, int destinationStride, const uint16_t* source, int sourceStride, int width, int height) {
+    if (width <= 0)
+        return;
+
+    if (destinationStride == width && sourceStride == width) {
+        // Contiguous regions copy in one go
+        std::memcpy(destination, source, width * height * sizeof(uint16_t));
+        return;
+    }
+
+    for (int row = 0; row < height; ++row)
+        std::memcpy(destination + row * destinationStride, source + row * sourceStride, width * sizeof(uint16_t));
+}
+
+void Display::Kernels::Fill(uint16_t* data, int width, int height, int stride, uint16_t color) {
+    for (int row = 0; row < height; ++row)
+        FillSpan(data + row * stride, width, color);
+}
+
+void Display::Kernels::FlipHorizontal(uint16_t* data, int width, int height, int stride) {
+    for (int row = 0; row < height; ++row)
+        ReverseSpan(data + row * stride, width);
+}
+
+void Display::Kernels::FlipVertical(uint16_t* data, int width, int height, int stride) {
+    for (int top = 0, bottom = height - 1; top < bottom; ++top, --bottom)
+        SwapSpans(data + top * stride, data + bottom * stride, width);
+}
+
+void Display::Kernels::Rotate180(uint16_t* data, int width, int height, int stride) {
+    FlipVertical(data, width, height, stride);
+    FlipHorizontal(data, width, height, stride);
+}
+
+void Display::Kernels::Rotate90(const uint16_t* source, int width, int height, int sourceStride, uint16_t* destination, int destinationStride) {
+    bool fastPath = (
+        width % 2 == 0 && height % 2 == 0 &&
+        sourceStride % 2 == 0 && destinationStride % 2 == 0 &&
+        IsAligned(source) && IsAligned(destination)
+    );
+
+    if (!fastPath) {
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x)
+                destination[x * destinationStride + (height - 1 - y)] = source[y * sourceStride + x];
+        }
+        return;
+    }
+
+    // Transpose 2x2 blocks: two pair loads from source rows, two pair stores into destination rows
+    for (int y = 0; y < height; y += 2) {
+        const uint16_t* upperRow = source + y * sourceStride;
+        const uint16_t* lowerRow = upperRow + sourceStride;
+        int column = height - 2 - y;
+        for (int x = 0; x < width; x += 2) {
+            uint32_t upper = LoadPair(upperRow + x);
+            uint32_t lower = LoadPair(lowerRow + x);
+            StorePair(destination + x * destinationStride + column, (lower & 0xFFFF) | (upper << 16));
+            StorePair(destination + (x + 1) * destinationStride + column, (lower >> 16) | (upper & 0xFFFF'0000));
+        }
+    }
+}
+
+void Display::Kernels::Rotate270(const uint16_t* source, int width, int height, int sourceStride, uint16_t* destination, int destinationStride) {
+    bool fastPath = (
+        width % 2 == 0 && height % 2 == 0 &&
+        sourceStride % 2 == 0 && destinationStride % 2 == 0 &&
+        IsAligned(source) && IsAligned(destination)
+    );
+
+    if (!fastPath) {
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x)
+                destination[(width - 1 - x) * destinationStride + y] = source[y * sourceStride + x];
+        }
+        return;
+    }
+
+    for (int y = 0; y < height; y += 2) {
+        const uint16_t* upperRow = source + y * sourceStride;
+        const uint16_t* lowerRow = upperRow + sourceStride;
+        for (int x = 0; x < width; x += 2) {
+            uint32_t upper = LoadPair(upperRow + x);
+            uint32_t lower = LoadPair(lowerRow + x);
+            StorePair(destination + (width - 1 - x) * destinationStride + y, (upper & 0xFFFF) | (lower << 16));
+            StorePair(destination + (width - 2 - x) * destinationStride + y, (upper >> 16) | (lower & 0xFFFF'0000));
+        }
+    }
+}
+
+void Display::Kernels::Scale(const uint16_t* source, int width, int height, int sourceStride, uint16_t* destination, int destinationStride, int factor) {
+    if (factor <= 0)
+        return;
+
+    int scaledWidth = width * factor;
+    for (int y = 0; y < height; ++y) {
+        const uint16_t* sourceRow = source + y * sourceStride;
+        uint16_t* firstRow = destination + (y * factor) * destinationStride;
+
+        // Expand one row, then replicate it vertically
+        if (factor == 1) {
+            std::memcpy(firstRow, sourceRow, width * sizeof(uint16_t));
+        }
+        else if (factor == 2 && IsAligned(firstRow)) {
+            for (int x = 0; x < width; ++x)
+                StorePair(firstRow + x * 2, sourceRow[x] | (static_cast<uint32_t>(sourceRow[x]) << 16));
+        }
+        else {
+            for (int x = 0; x < width; ++x)
+                FillSpan(firstRow + x * factor, factor, sourceRow[x]);
+        }
+
+        for (int copy = 1; copy < factor; ++copy)
+            std::memcpy(firstRow + copy * destinationStride, firstRow, scaledWidth * sizeof(uint16_t));
+    }
+}
+
+void Display::Kernels::Blend50(uint16_t* destination, int destinationStride, const uint16_t* source, int sourceStride, int width, int height) {
+    for (int row = 0; row < height; ++row)
+        Blend50Span(destination + row * destinationStride, source + row * sourceStride, width);
+}
+
+void Display::Kernels::Blend(uint16_t* destination, int destinationStride, const uint16_t* source, int sourceStride, int width, int height, uint8_t alpha) {
+    for (int row = 0; row < height; ++row)
+        BlendSpan(destination + row * destinationStride, source + row * sourceStride, width, alpha);
+}
+
+} // namespace evms
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <cstdint>
+#include <algorithm>
+
+#include "display/indexed_pixel_map.hpp"
+#include "display/types.hpp"
+
+namespace evms {
+
+namespace Display {
+    /*
+    *   Pixel kernels operating on RGB565 spans and regions.
+    *   Pixels are expected in panel byte order (big-endian RGB565), the same
+    *   layout PixelMap literals and the framebuffer use. Regions are described
+    *   by a pointer to the top-left pixel, size and stride (in pixels) or by a view.
+    *   Rotations and 2x scaling move two pixels per 32-bit word when the involved
+    *   pointers are 4-byte aligned. Fills, flips and blends are plain per pixel loops,
+    *   which compilers vectorize better than word pairs (see tools/kernels_bench).
+    */
+    namespace Kernels {
+        // Single color blend, alpha is 0 (keep destination) to 255 (take source)
+        uint16_t BlendColor(uint16_t destination, uint16_t source, uint8_t alpha);
+
+        void FillSpan(uint16_t* span, int length, uint16_t color);
+
+        void ReverseSpan(uint16_t* span, int length);
+
+        void SwapSpans(uint16_t* first, uint16_t* second, int length);
+
+        // Average of source and destination: destination = (destination + source) / 2
+        void Blend50Span(uint16_t* destination, const uint16_t* source, int length);
+
+        // Alpha is 0 (keep destination) to 255 (take source), quantized to 1/32 steps
+        void BlendSpan(uint16_t* destination, const uint16_t* source, int length, uint8_t alpha);
+
+        // Expand to 3 bytes per pixel (R, G, B in the top 6 bits), destination holds length * 3 bytes
+        void ToRgb666Span(uint8_t* destination, const uint16_t* source, int length);
+
+        // Palette lookup of length pixels, source starts firstPixel (0 or 1) nibbles into indices
+        void ExpandIndexed4Span(uint16_t* destination, const uint8_t* indices, int firstPixel, int length, const uint16_t* palette);
+
+        void ExpandIndexed8Span(uint16_t* destination, const uint8_t* indices, int length, const uint16_t* palette);
+
+        void Copy(uint16_t* destination, int destinationStride, const uint16_t* source, int sourceStride, int width, int height);
+
+        void Fill(uint16_t* data, int width, int height, int stride, uint16_t color);
+
+        void FlipHorizontal(uint16_t* data, int width, int height, int stride);
+
+        void FlipVertical(uint16_t* data, int width, int height, int stride);
+
+        void Rotate180(uint16_t* data, int width, int height, int stride);
+
+        // Destination is height x width pixels
+        void Rotate90(const uint16_t* source, int width, int height, int sourceStride, uint16_t* destination, int destinationStride);
+
+        // Destination is height x width pixels
+        void Rotate270(const uint16_t* source, int width, int height, int sourceStride, uint16_t* destination, int destinationStride);
+
+        // Destination is (width * factor) x (height * factor) pixels
+        void Scale(const uint16_t* source, int width, int height, int sourceStride, uint16_t* destination, int destinationStride, int factor);
+
+        void Blend50(uint16_t* destination, int destinationStride, const uint16_t* source, int sourceStride, int width, int height);
+
+        void Blend(uint16_t* destination, int destinationStride, const uint16_t* source, int sourceStride, int width, int height, uint8_t alpha);
+
+        // View conveniences, PixelMap converts to views implicitly
+        // Copy source into destination at (x, y), clipped. Returns the rect written in destination coordinates.
+        inline Rect Blit(MutablePixelView destination, int x, int y, PixelView source) {
+            PixelView visible = source.subview(-x, -y, destination.dimensions());
+            if (!visible)
+                return {};
+
+            x = std::max(x, 0);
+            y = std::max(y, 0);
+            Copy(destination.row(y) + x, destination.stride(), visible.data(), visible.stride(), visible.width(), visible.height());
+            return { x, y, visible.width(), visible.height() };
+        }
+
+        // Expand palette indexed source into destination at (x, y), clipped. Returns the rect written.
+        inline Rect Blit(MutablePixelView destination, int x, int y, IndexedPixelView source) {
+            Rect visible = Rect{ x, y, source.width(), source.height() }.intersected({ 0, 0, destination.width(), destination.height() });
+            if (!visible || !source)
+                return {};
+
+            int sourceX = visible.x - x, sourceY = visible.y - y;
+            for (int row = 0; row < visible.height; ++row) {
+                uint16_t* target = destination.row(visible.y + row) + visible.x;
+                const uint8_t* indices = source.row(sourceY + row);
+                if (source.bitsPerPixel() == 4)
+                    ExpandIndexed4Span(target, indices + (sourceX / 2), sourceX % 2, visible.width, source.palette());
+                else
+                    ExpandIndexed8Span(target, indices + sourceX, visible.width, source.palette());
+            }
+            return visible;
+        }
+
+        // Fill rect of view, clipped. Returns the rect filled.
+        inline Rect Fill(MutablePixelView view, const Rect& rect, uint16_t color) {
+            Rect visible = rect.intersected({ 0, 0, view.width(), view.height() });
+            if (!visible)
+                return {};
+
+            Fill(view.row(visible.y) + visible.x, visible.width, visible.height, view.stride(), color);
+            return visible;
+        }
+
+        inline void Fill(MutablePixelView view, uint16_t color) {
+            Fill(view.data(), view.width(), view.height(), view.stride(), color);
+        }
+
+        inline void FlipHorizontal(MutablePixelView view) {
+            FlipHorizontal(view.data(), view.width(), view.height(), view.stride());
+        }
+
+        inline void FlipVertical(MutablePixelView view) {
+            FlipVertical(view.data(), view.width(), view.height(), view.stride());
+        }
+
+        inline void Rotate180(MutablePixelView view) {
+            Rotate180(view.data(), view.width(), view.height(), view.stride());
+        }
+
+        // Destination must be at least source.height() x source.width() pixels
+        inline void Rotate90(PixelView source, MutablePixelView destination) {
+            Rotate90(source.data(), source.width(), source.height(), source.stride(), destination.data(), destination.stride());
+        }
+
+        // Destination must be at least source.height() x source.width() pixels
+        inline void Rotate270(PixelView source, MutablePixelView destination) {
+            Rotate270(source.data(), source.width(), source.height(), source.stride(), destination.data(), destination.stride());
+        }
+
+        // Destination must be at least (source.width() * factor) x (source.height() * factor) pixels
+        inline void Scale(PixelView source, MutablePixelView destination, int factor) {
+            Scale(source.data(), source.width(), source.height(), source.stride(), destination.data(), destination.stride(), factor);
+        }
+
+        // Blends the overlapping top-left part of both views
+        inline void Blend50(MutablePixelView destination, PixelView source) {
+            int width = std::min(destination.width(), source.width());
+            int height = std::min(destination.height(), source.height());
+            Blend50(destination.data(), destination.stride(), source.data(), source.stride(), width, height);
+        }
+
+        // Blends the overlapping top-left part of both views
+        inline void Blend(MutablePixelView destination, PixelView source, uint8_t alpha) {
+            int width = std::min(destination.width(), source.width());
+            int height = std::min(destination.height(), source.height());
+            Blend(destination.data(), destination.stride(), source.data(), source.stride(), width, height, alpha);
+        }
+
+        template <Dimensions2D Dimensions>
+        inline PixelMap<Dimensions2D{ Dimensions.height, Dimensions.width }> Rotate90(const PixelMap<Dimensions>& map) {
+            PixelMap<Dimensions2D{ Dimensions.height, Dimensions.width }> result = {};
+            Rotate90(map, result);
+            return result;
+        }
+
+        template <Dimensions2D Dimensions>
+        inline PixelMap<Dimensions2D{ Dimensions.height, Dimensions.width }> Rotate270(const PixelMap<Dimensions>& map) {
+            PixelMap<Dimensions2D{ Dimensions.height, Dimensions.width }> result = {};
+            Rotate270(map, result);
+            return result;
+        }
+
+        template <int Factor, Dimensions2D Dimensions>
+        inline PixelMap<Dimensions2D{ Dimensions.width * Factor, Dimensions.height * Factor }> Scale(const PixelMap<Dimensions>& map) {
+            PixelMap<Dimensions2D{ Dimensions.width * Factor, Dimensions.height * Factor }> result = {};
+            Scale(map, result, Factor);
+            return result;
+        }
+    }
+}
+
+} // namespace evms
@@ -0,0 +1,111 @@
+#include "latency_probe.hpp"
+
+#include <cstdio>
+#include <vector>
+
+namespace evms {
+
+Display::LatencyProbe::LatencyProbe(Clock clock)
+    : m_clock(clock)
+{}
+
+void Display::LatencyProbe::sample(Position touch, int64_t edgeTime) {
+    bool pressed = touch.x >= 0 && touch.y >= 0;
+    bool pressStarted = pressed && !m_pressed;
+    m_pressed = pressed;
+
+    if (!pressStarted) {
+        // Released before anything was drawn, e.g. the press went to a button
+        if (!pressed && m_state == State::Sampled)
+            m_state = State::Idle;
+        return;
+    }
+
+    // Previous press never made it to the panel, e.g. frame diffing found nothing to send
+    if (m_state != State::Idle)
+        ++m_dropped;
+
+    int64_t now = m_clock();
+    m_current = {};
+    m_current.sampled = now;
+    m_current.touched = (edgeTime >= 0 && edgeTime <= now) ? edgeTime : now;
+    m_state = State::Sampled;
+}
+
+void Display::LatencyProbe::drawn(Position pixel) {
+    if (m_state != State::Sampled)
+        return;
+
+    m_current.drawn = m_clock();
+    m_pixel = pixel;
+    m_state = State::Drawn;
+}
+
+bool Display::LatencyProbe::covers(const Rect& region) const {
+    return m_state == State::Drawn && region.contains(m_pixel);
+}
+
+void Display::LatencyProbe::flushStarted() {
+    if (m_state != State::Drawn)
+        return;
+
+    m_current.flushStarted = m_clock();
+    m_state = State::Flushing;
+}
+
+void Display::LatencyProbe::flushEnded() {
+    if (m_state != State::Flushing)
+        return;
+
+    m_current.flushEnded = m_clock();
+    m_measurements[m_count % Capacity] = m_current;
+    ++m_count;
+    m_state = State::Idle;
+}
+
+void Display::LatencyProbe::report(std::ostream& stream) const {
+    struct Stage {
+        const char* name;
+        int64_t Measurement::* from;
+        int64_t Measurement::* to;
+    };
+    static constexpr Stage Stages[] = {
+        { "touch>sample", &Measurement::touched, &Measurement::sampled },
+        { "sample>draw", &Measurement::sampled, &Measurement::drawn },
+        { "draw>flush", &Measurement::drawn, &Measurement::flushStarted },
+        { "flush", &Measurement::flushStarted, &Measurement::flushEnded },
+        { "total", &Measurement::touched, &Measurement::flushEnded },
+    };
+
+    char line[96];
+    std::snprintf(line, sizeof(line), "%zu presses measured, %zu dropped", m_count, m_dropped);
+    stream << ReportPrefix << line << '\n';
+    std::snprintf(line, sizeof(line), "%-14s %7s %7s %7s %7s", "ms", "p50", "p90", "p99", "max");
+    stream << ReportPrefix << line << '\n';
+
+    std::span<const Measurement> kept = measurements();
+    std::vector<int64_t> values(kept.size());
+    for (const Stage& stage : Stages) {
+        if (kept.empty())
+            break;
+        for (size_t index = 0; index < kept.size(); ++index)
+            values[index] = kept[index].*stage.to - kept[index].*stage.from;
+        std::sort(values.begin(), values.end());
+
+        auto percentile = [&values](double fraction) {
+            return values[std::min(values.size() - 1, static_cast<size_t>(fraction * values.size()))] / 1000.0;
+        };
+        std::snprintf(line, sizeof(line), "%-14s %7.2f %7.2f %7.2f %7.2f",
+            stage.name, percentile(0.5), percentile(0.9), percentile(0.99), percentile(1.0));
+        stream << ReportPrefix << line << '\n';
+    }
+    stream.flush();
+}
+
+void Display::LatencyProbe::clear() {
+    m_state = State::Idle;
+    m_count = 0;
+    m_dropped = 0;
+}
+
+} // namespace evms
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+
+#include "display/types.hpp"
+#include "utility/time.hpp"
+
+namespace evms {
+
+namespace Display {
+    /*
+    *   Touch-to-photon latency of presses, split into stages:
+    *       touched         PENIRQ edge, or the first sample when there's no edge timestamp
+    *       sampled         first sample of the press was read
+    *       drawn           its feedback was drawn into the framebuffer
+    *       flushStarted    the region holding the drawn pixel started going out
+    *       flushEnded      ...and is in GRAM
+    *   The panel shows GRAM on its next refresh, up to one refresh period (~14 ms at
+    *   70 Hz) later, which isn't measured. One press is measured at a time, a press
+    *   whose pixel never gets sent (e.g. it hit a button) is dropped.
+    *   Feed it from the frame loop with sample() and drawn(), Screen::setLatencyProbe()
+    *   does the rest. Clock is a parameter so host simulations can run it on model time.
+    */
+    class LatencyProbe {
+    public:
+        struct Measurement {
+            int64_t touched = 0;
+            int64_t sampled = 0;
+            int64_t drawn = 0;
+            int64_t flushStarted = 0;
+            int64_t flushEnded = 0;
+        };
+
+        using Clock = int64_t (*)();
+
+        // Most recent measurements kept for report()
+        static constexpr size_t Capacity = 256;
+
+        // Prefix of the report lines
+        static constexpr const char* ReportPrefix = "latency: ";
+
+    private:
+        enum class State {
+            Idle,
+            Sampled,
+            Drawn,
+            Flushing,
+        };
+
+    private:
+        Clock m_clock;
+        State m_state = State::Idle;
+        bool m_pressed = false;
+        Position m_pixel;
+        Measurement m_current;
+        std::array<Measurement, Capacity> m_measurements;
+        size_t m_count = 0;
+        size_t m_dropped = 0;
+
+    public:
+        explicit LatencyProbe(Clock clock = Utility::TimeMicroseconds);
+
+    public:
+        /*
+        *   Once per frame with the touch sample ({ -1, -1 } if not touched) right after reading it.
+        *   edgeTime is the press's PENIRQ edge in clock time, -1 if unknown.
+        */
+        void sample(Position touch, int64_t edgeTime = -1);
+
+        // Feedback for the current sample is in the framebuffer, pixel is a framebuffer position it changed
+        void drawn(Position pixel);
+
+        // Whether the region about to be sent holds the pixel of the press being measured
+        bool covers(const Rect& region) const;
+
+        void flushStarted();
+
+        void flushEnded();
+
+        // Percentiles of every stage in milliseconds, as lines starting with ReportPrefix
+        void report(std::ostream& stream) const;
+
+        // Forget all measurements
+        void clear();
+
+    public:
+        // Measurements completed so far, including ones no longer kept
+        inline size_t count() const {
+            return m_count;
+        }
+
+        inline size_t dropped() const {
+            return m_dropped;
+        }
+
+        // Kept measurements in no particular order
+        inline std::span<const Measurement> measurements() const {
+            return { m_measurements.data(), std::min(m_count, Capacity) };
+        }
+    };
+}
+
+} // namespace evms
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+
+#include "display/types.hpp"
+
+namespace evms {
+
+namespace Display {
+    // Clockwise rotation of the picture relative to the panel's native (portrait) orientation
+    enum class Rotation {
+        Deg0,
+        Deg90,
+        Deg180,
+        Deg270,
+    };
+
+    // Rotations that exchange rows and columns
+    constexpr bool SwapsAxes(Rotation rotation) {
+        return rotation == Rotation::Deg90 || rotation == Rotation::Deg270;
+    }
+
+    constexpr Dimensions2D Rotate(Dimensions2D native, Rotation rotation) {
+        return SwapsAxes(rotation) ? Dimensions2D{ native.height, native.width } : native;
+    }
+
+    /*
+    *   Memory access control (MADCTL) bits making the controller do the rotation while writing GRAM:
+    *   MY (row order), MX (column order) and MV (row/column exchange). Address windows are then
+    *   given in rotated coordinates and pixels go out unchanged.
+    */
+    constexpr uint8_t MemoryAccessRotationBits(Rotation rotation) {
+        constexpr uint8_t MY = 0b1000'0000;
+        constexpr uint8_t MX = 0b0100'0000;
+        constexpr uint8_t MV = 0b0010'0000;
+        switch (rotation) {
+            case Rotation::Deg90:   return MV | MX;
+            case Rotation::Deg180:  return MY | MX;
+            case Rotation::Deg270:  return MV | MY;
+            default:                return 0;
+        }
+    }
+
+    // Map a position in native panel coordinates (e.g. calibrated touch) to rotated coordinates
+    constexpr Position Rotate(Position native, Dimensions2D nativeDimensions, Rotation rotation) {
+        int width = nativeDimensions.width, height = nativeDimensions.height;
+        switch (rotation) {
+            case Rotation::Deg90:   return { native.y, width - 1 - native.x };
+            case Rotation::Deg180:  return { width - 1 - native.x, height - 1 - native.y };
+            case Rotation::Deg270:  return { height - 1 - native.y, native.x };
+            default:                return native;
+        }
+    }
+}
+
+} // namespace evms
@@ -1,35 +1,74 @@
 #pragma once
 
+#include <array>
+#include <concepts>
 #include <cstdint>
 #include <cstring>
-#include <vector>
+#include <future>
+#include <memory>
+#include <initializer_list>
 #include <algorithm>
+#include <string_view>
 
+#include "diagnostics/memory_report.hpp"
+#include "display/controllers/controller.hpp"
+#include "display/dirty_regions.hpp"
+#include "display/font.hpp"
+#include "display/indexed_pixel_map.hpp"
+#include "display/latency_probe.hpp"
+#include "display/rotation.hpp"
+#include "display/transports/transport.hpp"
 #include "display/types.hpp"
-#include "drivers/gpio_pin.hpp"
-#include "drivers/spi_bus.hpp"
+#include "drivers/dma_pool.hpp"
 
 namespace evms {
 
 namespace Display {
-    class Screen : private Drivers::SpiDevice {
+    /*
+    *   Framebuffered screen. Everything controller specific comes from Controller
+    *   traits (see display/controllers/) and bytes go out through TransportType
+    *   (see display/transports/), so one build can drive several different panels
+    *   over different buses, each Screen owning its own framebuffer.
+    *   Orientation is applied by the controller through MADCTL, so Dimensions and all
+    *   coordinates are already rotated and drawing costs the same in every orientation.
+    */
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation = Rotation::Deg0>
+    class Screen {
     public:
-        // A typical ILI9341 screen is 240x320 pixels
-        static constexpr Dimensions2D Dimensions = { 240, 320 };
+        static constexpr Dimensions2D Dimensions = Rotate(Controller::Dimensions, Orientation);
+
+        // Changed regions further apart than this are merged before being sent
+        static constexpr size_t ChangedRegionCapacity = 8;
 
     private:
-        static PixelMap<Dimensions> s_framebuffer;
+        // Two alternating row conversion buffers for controllers that don't take RGB565 as is
+        static constexpr size_t LineSize = Dimensions.width * Controllers::BytesPerPixel<Controller>();
+        static constexpr size_t LineBufferSize = Controller::Format == Controllers::PixelFormat::Rgb565 ? 0 : LineSize * 2;
 
     private:
-        Drivers::GpioPin m_resetPin;
-        Drivers::GpioPin m_dcPin;
+        TransportType m_transport;
+        Diagnostics::TaggedArray<uint16_t> m_framebuffer;
+        alignas(Drivers::DmaPool::Alignment) std::array<uint8_t, LineBufferSize> m_lineBuffer;
+
+        // Regions changed since last render
+        DirtyRegions<ChangedRegionCapacity> m_changedRegions;
+
+        // Vertical scroll area and offset, see setScrollArea()
+        int m_scrollTop = 0;
+        int m_scrollHeight = 0;
+        int m_scrollOffset = 0;
+        bool m_scrollChanged = false;
 
-        // Render region variables
-        int m_xStart = -1, m_xEnd = -1;
-        int m_yStart = -1, m_yEnd = -1;
+        // Copy of what GRAM holds, only allocated when frame diffing is enabled
+        Diagnostics::TaggedArray<uint16_t> m_shadow;
+
+        LatencyProbe* m_latencyProbe = nullptr;
 
     public:
-        Screen(const Drivers::SpiBus& spiBus, gpio_num_t csPin, gpio_num_t resetPin, gpio_num_t dcPin);
+        // Arguments construct the transport, nothing is sent until begin(). False if the framebuffer couldn't be allocated.
+        template <typename... Arguments>
+        requires std::constructible_from<TransportType, Arguments...>
+        explicit Screen(Arguments&&... arguments);
 
         Screen(const Screen& other) = delete;
 
@@ -43,27 +82,181 @@ namespace Display {
         Screen& operator=(Screen&& other) noexcept;
 
     private:
-        void reset();
+        void command(uint8_t commandCode, std::initializer_list<uint8_t> parameters = {});
 
-        std::vector<uint8_t> command(uint8_t commandCode, const std::vector<uint8_t>& parameters = {}, size_t responseLength = 0);
+        // Reset the controller and run its init sequence
+        void initialize();
 
         bool framebufferChanged() const;
 
-        void markChangedRegion(int xStart, int xEnd, int yStart, int yEnd);
+        void markChangedRegion(int x, int y, int width, int height);
+
+        void setAddressWindow(int x, int y, int width, int height);
+
+        void sendRegion(int x, int y, int width, int height);
+
+        void sendRows(const uint16_t* firstRow, int width, int height);
+
+        // Send only the parts of region that differ from the shadow and update it
+        void sendRegionDiff(const Rect& region);
+
+        void sendScrollDefinition();
+
+        void sendScrollStart();
+
+        // Move rows of the scroll area up by rows, wrapping around
+        void rotateScrollArea(uint16_t* pixels, int rows) const;
+
+        // Framebuffer, shadow and pending changes follow the scroll area content up by rows
+        void scrollFramebuffer(int rows);
+
+        /*
+        *   Split rows [y, y + height) of screen coordinates into bands that are contiguous in GRAM.
+        *   Callback receives the screen row and the GRAM row of each band's first row and its row count.
+        */
+        template <typename Callback>
+        void forEachBand(int y, int height, Callback&& callback) const {
+            int end = std::min(y + height, Dimensions.height);
+            y = std::max(y, 0);
+            height = end - y;
+            int scrollBottom = m_scrollTop + m_scrollHeight;
+            while (height > 0) {
+                int physicalY = y, rows = height;
+                if (y < m_scrollTop) {
+                    rows = std::min(rows, m_scrollTop - y);
+                }
+                else if (y < scrollBottom) {
+                    physicalY = m_scrollTop + (y - m_scrollTop + m_scrollOffset) % m_scrollHeight;
+                    rows = std::min({ rows, scrollBottom - y, scrollBottom - physicalY });
+                }
+
+                callback(y, physicalY, rows);
+                y += rows;
+                height -= rows;
+            }
+        }
 
     public:
+        /*
+        *   Bring the panel up in a separate thread, most of which is spent waiting on the controller.
+        *   Other startup work can go on meanwhile, but not with this screen: it must stay in place and
+        *   unused until the future is ready. The whole framebuffer is sent on the first render().
+        */
+        std::future<void> begin();
+
         void clear();
 
         void clear(int x, int y, Dimensions2D dimensions);
 
-        template <typename Map>
-        void draw(int x, int y, const Map& map);
+        // Clear the area the map covers when drawn at (x, y)
+        void clear(int x, int y, PixelView map);
+
+        void fill(uint16_t color);
+
+        void fill(int x, int y, Dimensions2D dimensions, uint16_t color);
+
+        void draw(int x, int y, PixelView map);
+
+        // Palette lookup happens right while writing into the framebuffer
+        void draw(int x, int y, IndexedPixelView map);
+
+        /*
+        *   Rows [top, top + height) become a hardware scrolled area, the rest stays fixed.
+        *   The framebuffer stays in screen row order, rows are mapped to GRAM as they're sent,
+        *   so content keeps its place until scrolled. Height 0 disables scrolling. Resets scroll offset.
+        *   Controllers scroll along native rows only, so this needs Rotation::Deg0.
+        */
+        void setScrollArea(int top, int height) requires (Orientation == Rotation::Deg0);
+
+        /*
+        *   Scroll area content moves up by offset rows (wrapping around), applied on next render().
+        *   The framebuffer's rows move along right away, only the scroll start is sent.
+        */
+        void scrollTo(int offset);
 
+        void scrollBy(int rows);
+
+        // Returns the rect the text occupies on screen
+        Rect drawText(int x, int y, const Font& font, std::string_view text, uint16_t foreground, uint16_t background = 0x0000);
+
+        // Mark region as changed after writing to it through the canvas
+        void invalidate(const Rect& region);
+
+        // Send all changed regions, each as its own address window
         void render();
 
+        /*
+        *   Keep a shadow copy of GRAM (another framebuffer worth of memory) and send only
+        *   rows and row spans that differ from it within changed regions. Pays off when
+        *   redraws mostly write back what's already there. A moving sprite gains nothing:
+        *   its old and new place differ at both ends of every row, so the spans are as wide
+        *   as the bounding box and diffing only costs CPU time (see tools/frame_diff_bench).
+        *   Returns false if shadow can't be allocated.
+        */
+        bool setFrameDiffing(bool enabled);
+
+        /*
+        *   Stamp flush start and end of the region holding the pixel probe is waiting for, see
+        *   display/latency_probe.hpp. That region is flushed on its own, so that the end stamp
+        *   doesn't wait for regions sent after it. Probe must outlive the screen or be unset.
+        */
+        inline void setLatencyProbe(LatencyProbe* probe) {
+            m_latencyProbe = probe;
+        }
+
+        // Send region of the framebuffer regardless of what has been marked as changed
+        void render(const Rect& region);
+
+        template <size_t Capacity>
+        inline void render(const DirtyRegions<Capacity>& regions) {
+            for (const Rect& region : regions)
+                render(region);
+        }
+
+        /*
+        *   Send rows produced by source(uint16_t* row, int y) straight to GRAM, bypassing the
+        *   framebuffer, e.g. from a streaming image decoder. Rows are in panel byte order and
+        *   one is produced while the previous is still being sent. Only two rows are buffered,
+        *   in a Drivers::DmaPool block when one is free (falling back to the heap).
+        *   GRAM differs from the framebuffer there until the region is rendered again.
+        *   Returns false if region isn't entirely on screen or source returns false.
+        */
+        template <typename RowSource>
+        bool stream(const Rect& region, RowSource&& source);
+
     public:
-        inline const PixelMap<Dimensions>& framebuffer() const {
-            return s_framebuffer;
+        // Map a position in native panel coordinates (e.g. calibrated touch) to screen coordinates
+        static constexpr Position FromNative(Position position) {
+            if (position.x < 0 || position.y < 0)
+                return position;
+            return Rotate(position, Controller::Dimensions, Orientation);
+        }
+
+        inline TransportType& transport() {
+            return m_transport;
+        }
+
+        inline bool frameDiffing() const {
+            return static_cast<bool>(m_shadow);
+        }
+
+        inline int scrollOffset() const {
+            return m_scrollOffset;
+        }
+
+        // Nothing but moving and destroying works on a screen without framebuffer
+        explicit operator bool() const {
+            return static_cast<bool>(m_framebuffer);
+        }
+
+        // Framebuffer and canvas are in screen row order, whatever the scroll offset
+        inline PixelView framebuffer() const {
+            return { m_framebuffer.get(), Dimensions };
+        }
+
+        // Writes through the canvas aren't tracked, invalidate() them or send them with render(region)
+        inline MutablePixelView canvas() {
+            return { m_framebuffer.get(), Dimensions };
         }
     };
 }
@@ -1,54 +1,414 @@
+#include <new>
+#include <span>
+#include <utility>
+
+#include "display/frame_diff.hpp"
+#include "display/kernels.hpp"
+#include "display/text.hpp"
+#include "utility/time.hpp"
+
 namespace evms {
 
 namespace Display {
-    template <typename Map>
-    void Screen::draw(int x, int y, const Map& map) {
-        Dimensions2D mapDimensions = map.dimensions();
-        if (!mapDimensions) {
-            // Map is empty. Can't draw!
-            return;
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    template <typename... Arguments>
+    requires std::constructible_from<TransportType, Arguments...>
+    Screen<Controller, TransportType, Orientation>::Screen(Arguments&&... arguments)
+        : m_transport(std::forward<Arguments>(arguments)...)
+        , m_framebuffer(Diagnostics::MakeTaggedArray<uint16_t>(Diagnostics::Subsystem::Display, Dimensions.width * Dimensions.height, std::nothrow)) {
+        static_assert(Controllers::ValidInitSequence(Controller::InitSequence));
+    }
+
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    Screen<Controller, TransportType, Orientation>::Screen(Screen&& other) noexcept
+        : m_transport(std::move(other.m_transport))
+        , m_framebuffer(std::move(other.m_framebuffer))
+        , m_changedRegions(std::exchange(other.m_changedRegions, {}))
+        , m_scrollTop(std::exchange(other.m_scrollTop, 0))
+        , m_scrollHeight(std::exchange(other.m_scrollHeight, 0))
+        , m_scrollOffset(std::exchange(other.m_scrollOffset, 0))
+        , m_scrollChanged(std::exchange(other.m_scrollChanged, false))
+        , m_shadow(std::move(other.m_shadow))
+        , m_latencyProbe(std::exchange(other.m_latencyProbe, nullptr))
+    {}
+
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    Screen<Controller, TransportType, Orientation>& Screen<Controller, TransportType, Orientation>::operator=(Screen&& other) noexcept {
+        if (&other != this) {
+            m_transport = std::move(other.m_transport);
+            m_framebuffer = std::move(other.m_framebuffer);
+            m_changedRegions = std::exchange(other.m_changedRegions, {});
+            m_scrollTop = std::exchange(other.m_scrollTop, 0);
+            m_scrollHeight = std::exchange(other.m_scrollHeight, 0);
+            m_scrollOffset = std::exchange(other.m_scrollOffset, 0);
+            m_scrollChanged = std::exchange(other.m_scrollChanged, false);
+            m_shadow = std::move(other.m_shadow);
+            m_latencyProbe = std::exchange(other.m_latencyProbe, nullptr);
         }
+        return *this;
+    }
+
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    void Screen<Controller, TransportType, Orientation>::command(uint8_t commandCode, std::initializer_list<uint8_t> parameters) {
+        m_transport.command(commandCode, parameters.begin(), parameters.size());
+    }
 
-        if (x + mapDimensions.width <= 0 || x >= Dimensions.width) {
-            // Map is out of display bounds x-wise!
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    void Screen<Controller, TransportType, Orientation>::initialize() {
+        m_transport.reset();
+
+        std::span<const uint8_t> sequence = Controller::InitSequence;
+        for (size_t index = 0; index < sequence.size();) {
+            uint8_t code = sequence[index];
+            uint8_t header = sequence[index + 1];
+            size_t parameterCount = header & ~Controllers::Wait;
+            m_transport.command(code, sequence.data() + index + 2, parameterCount);
+            index += 2 + parameterCount;
+
+            if (header & Controllers::Wait)
+                Utility::Sleep(sequence[index++] / 1000.0f);
+        }
+        command(Controller::MemoryAccessControl, { static_cast<uint8_t>(Controller::MemoryAccessOrder | MemoryAccessRotationBits(Orientation)) });
+    }
+
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    std::future<void> Screen<Controller, TransportType, Orientation>::begin() {
+        // Whatever GRAM holds gets overwritten by the first render()
+        invalidate({ 0, 0, Dimensions.width, Dimensions.height });
+        return std::async(std::launch::async, &Screen::initialize, this);
+    }
+
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    bool Screen<Controller, TransportType, Orientation>::framebufferChanged() const {
+        return !m_changedRegions.empty();
+    }
+
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    void Screen<Controller, TransportType, Orientation>::markChangedRegion(int x, int y, int width, int height) {
+        m_changedRegions.add({ x, y, width, height });
+    }
+
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    void Screen<Controller, TransportType, Orientation>::clear() {
+        fill(0, 0, Dimensions, 0x0000);
+    }
+
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    void Screen<Controller, TransportType, Orientation>::clear(int x, int y, Dimensions2D dimensions) {
+        fill(x, y, dimensions, 0x0000);
+    }
+
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    void Screen<Controller, TransportType, Orientation>::clear(int x, int y, PixelView map) {
+        fill(x, y, map.dimensions(), 0x0000);
+    }
+
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    void Screen<Controller, TransportType, Orientation>::fill(uint16_t color) {
+        fill(0, 0, Dimensions, color);
+    }
+
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    void Screen<Controller, TransportType, Orientation>::fill(int x, int y, Dimensions2D dimensions, uint16_t color) {
+        Rect filled = Kernels::Fill(canvas(), { x, y, dimensions.width, dimensions.height }, color);
+        if (filled)
+            markChangedRegion(filled.x, filled.y, filled.width, filled.height);
+    }
+
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    void Screen<Controller, TransportType, Orientation>::draw(int x, int y, PixelView map) {
+        Rect drawn = Kernels::Blit(canvas(), x, y, map);
+        if (drawn)
+            markChangedRegion(drawn.x, drawn.y, drawn.width, drawn.height);
+    }
+
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    void Screen<Controller, TransportType, Orientation>::draw(int x, int y, IndexedPixelView map) {
+        Rect drawn = Kernels::Blit(canvas(), x, y, map);
+        if (drawn)
+            markChangedRegion(drawn.x, drawn.y, drawn.width, drawn.height);
+    }
+
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    Rect Screen<Controller, TransportType, Orientation>::drawText(int x, int y, const Font& font, std::string_view text, uint16_t foreground, uint16_t background) {
+        Rect drawn = DrawText(canvas(), x, y, font, text, foreground, background);
+        if (drawn)
+            markChangedRegion(drawn.x, drawn.y, drawn.width, drawn.height);
+        return drawn;
+    }
+
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    void Screen<Controller, TransportType, Orientation>::setScrollArea(int top, int height) requires (Orientation == Rotation::Deg0) {
+        top = std::clamp(top, 0, Dimensions.height);
+        height = std::clamp(height, 0, Dimensions.height - top);
+        if (height == 0) {
+            // Whole screen as one scroll area with zero offset is the same as no scrolling
+            top = 0;
+        }
+
+        // Scrolled rows go back to showing GRAM in order, the framebuffer keeps what the screen showed
+        if (m_scrollOffset) {
+            if (m_shadow)
+                rotateScrollArea(m_shadow.get(), m_scrollHeight - m_scrollOffset);
+            invalidate({ 0, m_scrollTop, Dimensions.width, m_scrollHeight });
+        }
+
+        m_scrollTop = top;
+        m_scrollHeight = height;
+        m_scrollOffset = 0;
+        m_scrollChanged = false;
+        sendScrollDefinition();
+        sendScrollStart();
+    }
+
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    void Screen<Controller, TransportType, Orientation>::scrollTo(int offset) {
+        if (m_scrollHeight == 0)
             return;
+
+        offset %= m_scrollHeight;
+        if (offset < 0)
+            offset += m_scrollHeight;
+        if (offset != m_scrollOffset) {
+            scrollFramebuffer((offset - m_scrollOffset + m_scrollHeight) % m_scrollHeight);
+            m_scrollOffset = offset;
+            m_scrollChanged = true;
+        }
+    }
+
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    void Screen<Controller, TransportType, Orientation>::scrollBy(int rows) {
+        scrollTo(m_scrollOffset + rows);
+    }
+
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    void Screen<Controller, TransportType, Orientation>::rotateScrollArea(uint16_t* pixels, int rows) const {
+        uint16_t* first = pixels + (m_scrollTop * Dimensions.width);
+        std::rotate(first, first + (rows * Dimensions.width), first + (m_scrollHeight * Dimensions.width));
+    }
+
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    void Screen<Controller, TransportType, Orientation>::scrollFramebuffer(int rows) {
+        rotateScrollArea(m_framebuffer.get(), rows);
+        if (m_shadow)
+            rotateScrollArea(m_shadow.get(), rows);
+
+        // Changed rows inside the area move up too, wrapping ones split in two
+        int bottom = m_scrollTop + m_scrollHeight;
+        DirtyRegions<ChangedRegionCapacity> pending = std::exchange(m_changedRegions, {});
+        for (const Rect& region : pending) {
+            m_changedRegions.add(region.intersected({ 0, 0, Dimensions.width, m_scrollTop }));
+            m_changedRegions.add(region.intersected({ 0, bottom, Dimensions.width, Dimensions.height - bottom }));
+
+            Rect inside = region.intersected({ 0, m_scrollTop, Dimensions.width, m_scrollHeight });
+            if (!inside)
+                continue;
+            int y = m_scrollTop + (inside.y - m_scrollTop - rows + m_scrollHeight) % m_scrollHeight;
+            int firstRows = std::min(inside.height, bottom - y);
+            m_changedRegions.add({ inside.x, y, inside.width, firstRows });
+            m_changedRegions.add({ inside.x, m_scrollTop, inside.width, inside.height - firstRows });
         }
-        if (y + mapDimensions.height <= 0 || y >= Dimensions.height) {
-            // Map is out of display bounds y-wise!
+    }
+
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    void Screen<Controller, TransportType, Orientation>::sendScrollDefinition() {
+        int top = m_scrollTop;
+        int height = m_scrollHeight ? m_scrollHeight : Dimensions.height;
+        int bottom = Dimensions.height - top - height;
+
+        command(Controller::VerticalScrollDefinition, {
+            static_cast<uint8_t>(top >> 8), static_cast<uint8_t>(top),
+            static_cast<uint8_t>(height >> 8), static_cast<uint8_t>(height),
+            static_cast<uint8_t>(bottom >> 8), static_cast<uint8_t>(bottom)
+        });
+    }
+
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    void Screen<Controller, TransportType, Orientation>::sendScrollStart() {
+        int start = m_scrollTop + m_scrollOffset;
+        command(Controller::VerticalScrollStart, { static_cast<uint8_t>(start >> 8), static_cast<uint8_t>(start) });
+    }
+
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    void Screen<Controller, TransportType, Orientation>::setAddressWindow(int x, int y, int width, int height) {
+        int xEnd = x + width - 1;
+        int yEnd = y + height - 1;
+
+        command(Controller::ColumnAddressSet, {
+            static_cast<uint8_t>(x >> 8), static_cast<uint8_t>(x),
+            static_cast<uint8_t>(xEnd >> 8), static_cast<uint8_t>(xEnd)
+        });
+
+        command(Controller::PageAddressSet, {
+            static_cast<uint8_t>(y >> 8), static_cast<uint8_t>(y),
+            static_cast<uint8_t>(yEnd >> 8), static_cast<uint8_t>(yEnd)
+        });
+
+        command(Controller::MemoryWrite);
+    }
+
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    void Screen<Controller, TransportType, Orientation>::sendRegion(int x, int y, int width, int height) {
+        bool probed = m_latencyProbe && m_latencyProbe->covers({ x, y, width, height });
+        if (probed)
+            m_latencyProbe->flushStarted();
+
+        forEachBand(y, height, [&](int bandY, int gramY, int rows) {
+            setAddressWindow(x, gramY, width, rows);
+            sendRows(m_framebuffer.get() + (bandY * Dimensions.width) + x, width, rows);
+        });
+
+        if (probed) {
+            m_transport.flush();
+            m_latencyProbe->flushEnded();
+        }
+    }
+
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    void Screen<Controller, TransportType, Orientation>::sendRows(const uint16_t* firstRow, int width, int height) {
+        for (int row = 0; row < height; ++row) {
+            const uint16_t* regionRow = firstRow + (row * Dimensions.width);
+            if constexpr (Controller::Format == Controllers::PixelFormat::Rgb565) {
+                m_transport.pixels(reinterpret_cast<const uint8_t*>(regionRow), width * sizeof(uint16_t));
+            }
+            else {
+                // Previous row may still be going out of the other buffer, wait for it only before sending this one
+                uint8_t* line = m_lineBuffer.data() + (row % 2) * LineSize;
+                Kernels::ToRgb666Span(line, regionRow, width);
+                m_transport.flush();
+                m_transport.pixels(line, width * Controllers::BytesPerPixel<Controller>());
+            }
+        }
+
+        // Line buffers are free again for the next band
+        if constexpr (Controller::Format != Controllers::PixelFormat::Rgb565)
+            m_transport.flush();
+    }
+
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    void Screen<Controller, TransportType, Orientation>::sendRegionDiff(const Rect& region) {
+        PixelView shadow(m_shadow.get(), Dimensions);
+        ForEachChangedRect(framebuffer(), shadow, region, [this](const Rect& changed) {
+            sendRegion(changed.x, changed.y, changed.width, changed.height);
+            Kernels::Copy(
+                m_shadow.get() + (changed.y * Dimensions.width) + changed.x, Dimensions.width,
+                m_framebuffer.get() + (changed.y * Dimensions.width) + changed.x, Dimensions.width,
+                changed.width, changed.height
+            );
+        });
+    }
+
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    void Screen<Controller, TransportType, Orientation>::invalidate(const Rect& region) {
+        Rect visible = region.intersected({ 0, 0, Dimensions.width, Dimensions.height });
+        if (visible)
+            markChangedRegion(visible.x, visible.y, visible.width, visible.height);
+    }
+
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    void Screen<Controller, TransportType, Orientation>::render() {
+        // Check if framebuffer and GRAM match
+        if (!framebufferChanged() && !m_scrollChanged)
             return;
+
+        for (const Rect& region : m_changedRegions) {
+            if (m_shadow)
+                sendRegionDiff(region);
+            else
+                sendRegion(region.x, region.y, region.width, region.height);
         }
 
-        int widthStart = 0, heightStart = 0;
-        if (x < 0) {
-            widthStart = -x;
-            x = 0;
+        // Framebuffer and GRAM match now
+        m_changedRegions.clear();
+
+        // Scroll after new content is in place
+        if (m_scrollChanged) {
+            sendScrollStart();
+            m_scrollChanged = false;
         }
-        if (y < 0) {
-            heightStart = -y;
-            y = 0;
+        m_transport.flush();
+    }
+
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    void Screen<Controller, TransportType, Orientation>::render(const Rect& region) {
+        Rect visible = region.intersected({ 0, 0, Dimensions.width, Dimensions.height });
+        if (!visible)
+            return;
+
+        if (m_shadow)
+            sendRegionDiff(visible);
+        else
+            sendRegion(visible.x, visible.y, visible.width, visible.height);
+        m_transport.flush();
+    }
+
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    template <typename RowSource>
+    bool Screen<Controller, TransportType, Orientation>::stream(const Rect& region, RowSource&& source) {
+        Rect visible = region.intersected({ 0, 0, Dimensions.width, Dimensions.height });
+        if (!visible || visible.width != region.width || visible.height != region.height)
+            return false;
+
+        Drivers::DmaPool::Block pooledRows = Drivers::DmaPool::Shared().acquire(region.width * 2 * sizeof(uint16_t));
+        Diagnostics::TaggedArray<uint16_t> heapRows;
+        uint16_t* rows = pooledRows.as<uint16_t>();
+        if (!rows) {
+            heapRows = Diagnostics::MakeTaggedArray<uint16_t>(Diagnostics::Subsystem::Display, region.width * 2, std::nothrow);
+            rows = heapRows.get();
         }
+        if (!rows)
+            return false;
+
+        // One address window per band of the scroll mapping, rows keep alternating buffers across them
+        int row = 0;
+        bool sourced = true;
+        forEachBand(region.y, region.height, [&](int, int gramY, int bandRows) {
+            if (!sourced)
+                return;
+            setAddressWindow(region.x, gramY, region.width, bandRows);
+            for (int end = row + bandRows; row < end; ++row) {
+                // The other row may still be in flight, this one was last sent two rows ago
+                uint16_t* line = rows + (row % 2) * region.width;
+                if (!source(line, row)) {
+                    sourced = false;
+                    return;
+                }
 
-        int mapStride = mapDimensions.width;
-        if (x + (mapDimensions.width - widthStart) > Dimensions.width)
-            mapDimensions.width = Dimensions.width + widthStart - x;
-        if (y + (mapDimensions.height - heightStart) > Dimensions.height)
-            mapDimensions.height = Dimensions.height + heightStart - y;
+                // Shadow mirrors GRAM
+                if (m_shadow)
+                    std::memcpy(m_shadow.get() + ((region.y + row) * Dimensions.width) + region.x, line, region.width * sizeof(uint16_t));
 
-        int colsToCopy = std::min<std::size_t>(
-            mapDimensions.width - static_cast<std::size_t>(widthStart),
-            Dimensions.width - static_cast<std::size_t>(x)
-        );
-        int rowsToCopy = std::min<std::size_t>(
-            mapDimensions.height - static_cast<std::size_t>(heightStart),
-            Dimensions.height - static_cast<std::size_t>(y)
-        );
+                m_transport.flush();
+                if constexpr (Controller::Format == Controllers::PixelFormat::Rgb565) {
+                    m_transport.pixels(reinterpret_cast<const uint8_t*>(line), region.width * sizeof(uint16_t));
+                }
+                else {
+                    Kernels::ToRgb666Span(m_lineBuffer.data(), line, region.width);
+                    m_transport.pixels(m_lineBuffer.data(), region.width * Controllers::BytesPerPixel<Controller>());
+                }
+            }
+        });
+        m_transport.flush();
+        return sourced;
+    }
 
-        for (int row = 0; row < rowsToCopy; ++row) {
-            const uint16_t* mapRow = map.data() + ((heightStart + row) * mapStride) + widthStart;
-            uint16_t* regionRow = s_framebuffer.data() + ((y + row) * Dimensions.width) + x;
-            std::memcpy(regionRow, mapRow, colsToCopy * sizeof(uint16_t));
+    template <typename Controller, Transports::Transport TransportType, Rotation Orientation>
+    bool Screen<Controller, TransportType, Orientation>::setFrameDiffing(bool enabled) {
+        if (!enabled) {
+            m_shadow.reset();
+            return true;
         }
-        markChangedRegion(x, y, colsToCopy, rowsToCopy);
+        if (m_shadow)
+            return true;
+
+        m_shadow = Diagnostics::MakeTaggedArray<uint16_t>(Diagnostics::Subsystem::Display, Dimensions.width * Dimensions.height, std::nothrow);
+        if (!m_shadow)
+            return false;
+
+        // Flush pending changes first so that the shadow starts out equal to GRAM
+        render();
+        std::memcpy(m_shadow.get(), m_framebuffer.get(), Dimensions.width * Dimensions.height * sizeof(uint16_t));
+        return true;
     }
 }
 
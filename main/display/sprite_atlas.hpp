@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <array>
+#include <span>
+
+#include "display/types.hpp"
+
+namespace evms {
+
+namespace Display {
+    // Sheet with all frames packed side by side, produced at compile time by PackAtlas()
+    template <Dimensions2D SheetDimensions, size_t FrameCount>
+    struct PackedAtlas {
+        PixelMap<SheetDimensions> sheet;
+        std::array<Rect, FrameCount> frames;
+    };
+
+    template <Dimensions2D... Dimensions>
+    constexpr Dimensions2D PackedSheetDimensions() {
+        Dimensions2D result = {};
+        ((result.width += Dimensions.width, result.height = std::max(result.height, Dimensions.height)), ...);
+        return result;
+    }
+
+    template <Dimensions2D... Dimensions>
+    constexpr auto PackAtlas(const PixelMap<Dimensions>&... maps) {
+        constexpr Dimensions2D Sheet = PackedSheetDimensions<Dimensions...>();
+        PackedAtlas<Sheet, sizeof...(Dimensions)> atlas = {};
+        for (auto& pixel : atlas.sheet)
+            pixel = 0x0000;
+
+        int x = 0;
+        size_t frame = 0;
+        auto pack = [&](const auto& map) {
+            Dimensions2D mapDimensions = map.dimensions();
+            for (int row = 0; row < mapDimensions.height; ++row) {
+                for (int column = 0; column < mapDimensions.width; ++column)
+                    atlas.sheet[(row * Sheet.width) + x + column] = map[(row * mapDimensions.width) + column];
+            }
+            atlas.frames[frame++] = { x, 0, mapDimensions.width, mapDimensions.height };
+            x += mapDimensions.width;
+        };
+        (pack(maps), ...);
+        return atlas;
+    }
+
+    // Non-owning handle to a sprite sheet and its frame rects
+    class SpriteAtlas {
+    private:
+        PixelView m_sheet;
+        std::span<const Rect> m_frames;
+
+    public:
+        constexpr SpriteAtlas() = default;
+
+        constexpr SpriteAtlas(PixelView sheet, std::span<const Rect> frames)
+            : m_sheet(sheet)
+            , m_frames(frames)
+        {}
+
+        template <Dimensions2D SheetDimensions, size_t FrameCount>
+        constexpr SpriteAtlas(const PackedAtlas<SheetDimensions, FrameCount>& atlas)
+            : SpriteAtlas(atlas.sheet, atlas.frames)
+        {}
+
+    public:
+        constexpr PixelView sheet() const {
+            return m_sheet;
+        }
+
+        constexpr int frameCount() const {
+            return static_cast<int>(m_frames.size());
+        }
+
+        constexpr const Rect& frameRect(int index) const {
+            return m_frames[index];
+        }
+
+        constexpr PixelView frame(int index) const {
+            const Rect& rect = m_frames[index];
+            return m_sheet.subview(rect.x, rect.y, rect.dimensions());
+        }
+    };
+}
+
+} // namespace evms
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+#include "display/dirty_regions.hpp"
+#include "display/sprite_atlas.hpp"
+#include "display/types.hpp"
+
+namespace evms {
+
+namespace Display {
+    /*
+    *   Many sprites drawn from one atlas.
+    *   Per-sprite state is kept as structure of arrays so the update and render
+    *   passes stream through only the fields they touch.
+    *   Positions and velocities are fixed-point with FractionBits fractional bits.
+    */
+    template <size_t Capacity>
+    class SpriteBatch {
+    public:
+        static constexpr int FractionBits = 4;
+        static constexpr int One = 1 << FractionBits;
+
+    private:
+        SpriteAtlas m_atlas;
+        size_t m_size = 0;
+
+        std::array<int16_t, Capacity> m_x = {};
+        std::array<int16_t, Capacity> m_y = {};
+        std::array<int16_t, Capacity> m_xVelocity = {};
+        std::array<int16_t, Capacity> m_yVelocity = {};
+
+        // Animation: frames firstFrame..firstFrame+frameCount-1, each shown for frameTicks updates
+        std::array<uint16_t, Capacity> m_firstFrame = {};
+        std::array<uint8_t, Capacity> m_frameCount = {};
+        std::array<uint8_t, Capacity> m_frameTicks = {};
+        std::array<uint8_t, Capacity> m_frame = {};
+        std::array<uint8_t, Capacity> m_tick = {};
+
+        // Rect drawn by the previous render, to be cleared by the next one
+        std::array<Rect, Capacity> m_drawn = {};
+
+        // Rects of removed sprites waiting to be cleared
+        std::array<Rect, Capacity> m_removed = {};
+        size_t m_removedCount = 0;
+
+    public:
+        explicit SpriteBatch(SpriteAtlas atlas);
+
+    public:
+        // Position is in pixels, velocity in 1/One pixels per update. Returns sprite index or -1 if batch is full.
+        int add(Position position, Position velocity, int firstFrame, int frameCount = 1, int frameTicks = 1);
+
+        // Index of the last sprite is reused for the removed one
+        void remove(int index);
+
+        void setPosition(int index, Position position);
+
+        void setVelocity(int index, Position velocity);
+
+        // Integrate positions and advance animations by one tick
+        void update();
+
+        // Clear previously drawn rects with background, draw sprites at their current positions and report both
+        template <size_t RegionCapacity>
+        void render(MutablePixelView target, uint16_t background, DirtyRegions<RegionCapacity>& dirty);
+
+    public:
+        inline size_t size() const {
+            return m_size;
+        }
+
+        inline Position position(int index) const {
+            return { m_x[index] >> FractionBits, m_y[index] >> FractionBits };
+        }
+
+        inline Position velocity(int index) const {
+            return { m_xVelocity[index], m_yVelocity[index] };
+        }
+
+        inline Rect bounds(int index) const {
+            const Rect& frame = m_atlas.frameRect(m_firstFrame[index] + m_frame[index]);
+            Position topLeft = position(index);
+            return { topLeft.x, topLeft.y, frame.width, frame.height };
+        }
+    };
+}
+
+} // namespace evms
+
+#include "sprite_batch.inl"
@@ -0,0 +1,101 @@
+#include "display/kernels.hpp"
+
+namespace evms {
+
+namespace Display {
+    template <size_t Capacity>
+    SpriteBatch<Capacity>::SpriteBatch(SpriteAtlas atlas)
+        : m_atlas(atlas)
+    {}
+
+    template <size_t Capacity>
+    int SpriteBatch<Capacity>::add(Position position, Position velocity, int firstFrame, int frameCount, int frameTicks) {
+        if (m_size == Capacity) {
+            // Batch is full!
+            return -1;
+        }
+
+        size_t index = m_size++;
+        m_x[index] = static_cast<int16_t>(position.x * One);
+        m_y[index] = static_cast<int16_t>(position.y * One);
+        m_xVelocity[index] = static_cast<int16_t>(velocity.x);
+        m_yVelocity[index] = static_cast<int16_t>(velocity.y);
+        m_firstFrame[index] = static_cast<uint16_t>(firstFrame);
+        m_frameCount[index] = static_cast<uint8_t>(std::max(frameCount, 1));
+        m_frameTicks[index] = static_cast<uint8_t>(std::max(frameTicks, 1));
+        m_frame[index] = 0;
+        m_tick[index] = 0;
+        m_drawn[index] = {};
+        return static_cast<int>(index);
+    }
+
+    template <size_t Capacity>
+    void SpriteBatch<Capacity>::remove(int index) {
+        if (index < 0 || static_cast<size_t>(index) >= m_size)
+            return;
+
+        if (m_drawn[index])
+            m_removed[m_removedCount++] = m_drawn[index];
+
+        size_t last = --m_size;
+        m_x[index] = m_x[last];
+        m_y[index] = m_y[last];
+        m_xVelocity[index] = m_xVelocity[last];
+        m_yVelocity[index] = m_yVelocity[last];
+        m_firstFrame[index] = m_firstFrame[last];
+        m_frameCount[index] = m_frameCount[last];
+        m_frameTicks[index] = m_frameTicks[last];
+        m_frame[index] = m_frame[last];
+        m_tick[index] = m_tick[last];
+        m_drawn[index] = m_drawn[last];
+    }
+
+    template <size_t Capacity>
+    void SpriteBatch<Capacity>::setPosition(int index, Position position) {
+        m_x[index] = static_cast<int16_t>(position.x * One);
+        m_y[index] = static_cast<int16_t>(position.y * One);
+    }
+
+    template <size_t Capacity>
+    void SpriteBatch<Capacity>::setVelocity(int index, Position velocity) {
+        m_xVelocity[index] = static_cast<int16_t>(velocity.x);
+        m_yVelocity[index] = static_cast<int16_t>(velocity.y);
+    }
+
+    template <size_t Capacity>
+    void SpriteBatch<Capacity>::update() {
+        for (size_t index = 0; index < m_size; ++index)
+            m_x[index] += m_xVelocity[index];
+        for (size_t index = 0; index < m_size; ++index)
+            m_y[index] += m_yVelocity[index];
+
+        for (size_t index = 0; index < m_size; ++index) {
+            if (m_frameCount[index] == 1 || ++m_tick[index] < m_frameTicks[index])
+                continue;
+
+            m_tick[index] = 0;
+            if (++m_frame[index] == m_frameCount[index])
+                m_frame[index] = 0;
+        }
+    }
+
+    template <size_t Capacity>
+    template <size_t RegionCapacity>
+    void SpriteBatch<Capacity>::render(MutablePixelView target, uint16_t background, DirtyRegions<RegionCapacity>& dirty) {
+        // All clears go before all draws so that overlapping sprites never erase each other
+        for (size_t index = 0; index < m_removedCount; ++index)
+            dirty.add(Kernels::Fill(target, m_removed[index], background));
+        m_removedCount = 0;
+
+        for (size_t index = 0; index < m_size; ++index)
+            dirty.add(Kernels::Fill(target, m_drawn[index], background));
+
+        for (size_t index = 0; index < m_size; ++index) {
+            PixelView frame = m_atlas.frame(m_firstFrame[index] + m_frame[index]);
+            m_drawn[index] = Kernels::Blit(target, m_x[index] >> FractionBits, m_y[index] >> FractionBits, frame);
+            dirty.add(m_drawn[index]);
+        }
+    }
+}
+
+} // namespace evms
@@ -0,0 +1,79 @@
+#include "text.hpp"
+
+#include <array>
+#include <algorithm>
+
+#include "display/kernels.hpp"
+
+namespace evms {
+
+static inline unsigned ReadPixel(const uint8_t* bitmap, uint32_t index, int bitsPerPixel) {
+    if (bitsPerPixel == 1)
+        return (bitmap[index >> 3] >> (7 - (index & 0b111))) & 0b1;
+    return (bitmap[index >> 1] >> ((index & 0b1) ? 0 : 4)) & 0b1111;
+}
+
+static void DrawGlyph(Display::MutablePixelView target, int x, int y, const Display::Font& font, const Display::Glyph& glyph, const std::array<uint16_t, 16>& shades) {
+    // Clip ink box to target
+    int columnStart = std::max(0, -x);
+    int columnEnd = std::min<int>(glyph.width, target.width() - x);
+    int rowStart = std::max(0, -y);
+    int rowEnd = std::min<int>(glyph.height, target.height() - y);
+    if (columnStart >= columnEnd || rowStart >= rowEnd)
+        return;
+
+    const uint8_t* bitmap = font.bitmap + glyph.offset;
+    int maxShade = (1 << font.bitsPerPixel) - 1;
+    for (int row = rowStart; row < rowEnd; ++row) {
+        uint16_t* targetRow = target.row(y + row) + x;
+        uint32_t rowIndex = static_cast<uint32_t>(row) * glyph.width;
+
+        // Emit runs of equal coverage, background runs are already in place
+        int column = columnStart;
+        while (column < columnEnd) {
+            unsigned shade = ReadPixel(bitmap, rowIndex + column, font.bitsPerPixel);
+            int runEnd = column + 1;
+            while (runEnd < columnEnd && ReadPixel(bitmap, rowIndex + runEnd, font.bitsPerPixel) == shade)
+                ++runEnd;
+
+            if (shade != 0)
+                Display::Kernels::FillSpan(targetRow + column, runEnd - column, shades[(shade * 15) / maxShade]);
+            column = runEnd;
+        }
+    }
+}
+
+Display::Rect Display::MeasureText(const Font& font, std::string_view text) {
+    int width = 0;
+    for (char character : text)
+        width += font.glyph(character).advance;
+    return { 0, 0, width, font.lineHeight };
+}
+
+Display::Rect Display::DrawText(MutablePixelView target, int x, int y, const Font& font, std::string_view text, uint16_t foreground, uint16_t background) {
+    Rect bounds = MeasureText(font, text);
+    bounds.x = x;
+    bounds.y = y;
+    Rect visible = Kernels::Fill(target, bounds, background);
+    if (!visible)
+        return {};
+
+    // Coverage levels blended once per call instead of once per pixel
+    std::array<uint16_t, 16> shades;
+    shades[15] = foreground;
+    if (font.bitsPerPixel != 1) {
+        for (int level = 0; level < 15; ++level)
+            shades[level] = Kernels::BlendColor(background, foreground, static_cast<uint8_t>((level * 255) / 15));
+    }
+
+    int penX = x;
+    for (char character : text) {
+        const Glyph& glyph = font.glyph(character);
+        if (glyph.width && glyph.height)
+            DrawGlyph(target, penX + glyph.xOffset, y + glyph.yOffset, font, glyph, shades);
+        penX += glyph.advance;
+    }
+    return visible;
+}
+
+} // namespace evms
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#include "display/font.hpp"
+#include "display/types.hpp"
+
+namespace evms {
+
+namespace Display {
+    // Size of a single line of text drawn at (0, 0). Only sums glyph advances.
+    Rect MeasureText(const Font& font, std::string_view text);
+
+    /*
+    *   Draw a single line of text with its top-left corner at (x, y).
+    *   The whole text rect is filled with background and glyph ink is filled with
+    *   foreground span by span, so redrawing changed text leaves no leftovers.
+    *   Returns the rect written in target coordinates (clipped).
+    */
+    Rect DrawText(MutablePixelView target, int x, int y, const Font& font, std::string_view text, uint16_t foreground, uint16_t background);
+}
+
+} // namespace evms
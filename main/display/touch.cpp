@@ -2,8 +2,18 @@
 
 #include <utility>
 
+#include <esp_attr.h>
+#include <esp_timer.h>
+
 namespace evms {
 
+static void IRAM_ATTR OnTouchEdge(void* argument) {
+    // Keep the first edge, later ones come from conversions of the same press
+    auto* edgeTime = static_cast<std::atomic<int64_t>*>(argument);
+    int64_t none = -1;
+    edgeTime->compare_exchange_strong(none, esp_timer_get_time(), std::memory_order_relaxed);
+}
+
 Display::Touch::Touch(const Drivers::SpiBus& spiBus, gpio_num_t csPin, gpio_num_t irqPin)
     : SpiDevice(spiBus.newDevice("XPT2046", csPin, 2'000'000, true))
     , m_irqPin("IRQ", irqPin, GPIO_MODE_INPUT) {
@@ -11,12 +21,16 @@ Display::Touch::Touch(const Drivers::SpiBus& spiBus, gpio_num_t csPin, gpio_num_
 
 Display::Touch::Touch(Touch&& other) noexcept
     : SpiDevice(std::move(other))
+    , m_edgeTime(std::move(other.m_edgeTime))
     , m_irqPin(std::move(other.m_irqPin))
 {}
 
 Display::Touch& Display::Touch::operator=(Touch&& other) noexcept {
     if (&other != this) {
+        // Our handler would keep firing on our old pin, with our edge time freed below
+        m_irqPin.setInterrupt(GPIO_INTR_DISABLE);
         SpiDevice::operator=(std::move(other));
+        m_edgeTime = std::move(other.m_edgeTime);
         m_irqPin = std::move(other.m_irqPin);
     }
     return *this;
@@ -27,7 +41,9 @@ uint16_t Display::Touch::getValue(uint8_t valueCode) const {
     valueCode &= ~0b11; 
     valueCode |= PowerMode;
 
-    std::vector<uint8_t> response = transfer({ valueCode, 0x00, 0x00 }, 3);
+    uint8_t request[3] = { valueCode, 0x00, 0x00 };
+    uint8_t response[3];
+    transfer(request, sizeof(request), response, sizeof(response));
     return ((response[1] << 8) | response[2]) >> 3;
 }
 
@@ -67,4 +83,21 @@ float Display::Touch::getControllerTemp() const {
     return (t1 - t0) * 0.125f;
 }
 
+bool Display::Touch::enableEdgeTimestamps() {
+    if (m_edgeTime)
+        return true;
+
+    auto edgeTime = std::make_unique<std::atomic<int64_t>>(-1);
+    if (!m_irqPin.setInterrupt(GPIO_INTR_NEGEDGE, &OnTouchEdge, edgeTime.get()))
+        return false;
+    m_edgeTime = std::move(edgeTime);
+    return true;
+}
+
+int64_t Display::Touch::takeEdgeTime() {
+    if (!m_edgeTime)
+        return -1;
+    return m_edgeTime->exchange(-1, std::memory_order_relaxed);
+}
+
 } // namespace evms
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
+#include <memory>
 
 #include "display/types.hpp"
 #include "drivers/gpio_pin.hpp"
@@ -11,6 +13,10 @@ namespace evms {
 namespace Display {
     class Touch : private Drivers::SpiDevice {
     private:
+        // Written by the PENIRQ interrupt, on the heap so that it stays put when Touch moves.
+        // Declared before the pin, so the pin removes the handler before this is freed.
+        std::unique_ptr<std::atomic<int64_t>> m_edgeTime;
+
         Drivers::GpioPin m_irqPin;
         
     public:
@@ -41,6 +47,16 @@ namespace Display {
 
         // In Celcius, ~5-10C error
         float getControllerTemp() const;
+
+        // Timestamp PENIRQ falling edges (touch down) in an interrupt. False if it can't be installed.
+        bool enableEdgeTimestamps();
+
+        /*
+        *   Time (as Utility::TimeMicroseconds()) of the first PENIRQ edge since the last call,
+        *   -1 if there was none or timestamps aren't enabled. Conversions toggle PENIRQ too,
+        *   so only the edge taken together with the first sample of a press marks touch down.
+        */
+        int64_t takeEdgeTime();
     };
 }
 
@@ -0,0 +1,121 @@
+#include "i80.hpp"
+
+#include <utility>
+
+#include <esp_attr.h>
+#include <esp_log.h>
+
+#include "utility/time.hpp"
+
+namespace evms {
+
+static std::string MakeLogTag(const std::string& logName, gpio_num_t wrPin, gpio_num_t csPin) {
+    std::string wrPinStr = std::to_string(static_cast<int>(wrPin));
+    std::string csPinStr = std::to_string(static_cast<int>(csPin));
+    return logName + " I80 [WR_" + wrPinStr + ", CS_" + csPinStr + "]";
+}
+
+static bool IRAM_ATTR OnPixelsSent(esp_lcd_panel_io_handle_t io, esp_lcd_panel_io_event_data_t* event, void* context) {
+    BaseType_t taskWoken = pdFALSE;
+    xSemaphoreGiveFromISR(static_cast<SemaphoreHandle_t>(context), &taskWoken);
+    return taskWoken == pdTRUE;
+}
+
+Display::Transports::I80::I80(
+    const std::array<gpio_num_t, BusWidth>& dataPins,
+    gpio_num_t wrPin, gpio_num_t dcPin, gpio_num_t csPin, gpio_num_t resetPin,
+    int frequency, size_t maxTransferBytes, const char* logName
+)
+    : m_logTag(MakeLogTag(logName, wrPin, csPin))
+    , m_bus(nullptr)
+    , m_io(nullptr)
+    , m_resetPin("RESET", resetPin, GPIO_MODE_OUTPUT)
+    , m_doneSemaphore(xSemaphoreCreateCounting(QueueDepth, 0)) {
+    esp_lcd_i80_bus_config_t busConfig = {};
+    busConfig.dc_gpio_num = dcPin;
+    busConfig.wr_gpio_num = wrPin;
+    busConfig.clk_src = LCD_CLK_SRC_DEFAULT;
+    for (int index = 0; index < BusWidth; ++index)
+        busConfig.data_gpio_nums[index] = dataPins[index];
+    busConfig.bus_width = BusWidth;
+    busConfig.max_transfer_bytes = maxTransferBytes;
+    ESP_ERROR_CHECK(esp_lcd_new_i80_bus(&busConfig, &m_bus));
+
+    esp_lcd_panel_io_i80_config_t ioConfig = {};
+    ioConfig.cs_gpio_num = csPin;
+    ioConfig.pclk_hz = frequency;
+    ioConfig.trans_queue_depth = QueueDepth;
+    ioConfig.on_color_trans_done = &OnPixelsSent;
+    ioConfig.user_ctx = m_doneSemaphore;
+    ioConfig.lcd_cmd_bits = 8;
+    ioConfig.lcd_param_bits = 8;
+    ioConfig.dc_levels.dc_idle_level = 0;
+    ioConfig.dc_levels.dc_cmd_level = 0;
+    ioConfig.dc_levels.dc_dummy_level = 0;
+    ioConfig.dc_levels.dc_data_level = 1;
+    ioConfig.flags.swap_color_bytes = false;    // Framebuffer is already in panel byte order
+    ESP_ERROR_CHECK(esp_lcd_new_panel_io_i80(m_bus, &ioConfig, &m_io));
+    ESP_LOGI(m_logTag.c_str(), "Initialized with frequency \"%d\"", frequency);
+}
+
+Display::Transports::I80::I80(I80&& other) noexcept
+    : m_logTag(std::move(other.m_logTag))
+    , m_bus(std::exchange(other.m_bus, nullptr))
+    , m_io(std::exchange(other.m_io, nullptr))
+    , m_resetPin(std::move(other.m_resetPin))
+    , m_doneSemaphore(std::exchange(other.m_doneSemaphore, nullptr))
+    , m_queued(std::exchange(other.m_queued, 0))
+{}
+
+Display::Transports::I80::~I80() {
+    if (m_io != nullptr) {
+        flush();
+        ESP_ERROR_CHECK(esp_lcd_panel_io_del(m_io));
+        ESP_ERROR_CHECK(esp_lcd_del_i80_bus(m_bus));
+        vSemaphoreDelete(m_doneSemaphore);
+        ESP_LOGI(m_logTag.c_str(), "Deinitialized");
+    }
+}
+
+Display::Transports::I80& Display::Transports::I80::operator=(I80&& other) noexcept {
+    if (&other != this) {
+        m_logTag = std::move(other.m_logTag);
+        m_bus = std::exchange(other.m_bus, nullptr);
+        m_io = std::exchange(other.m_io, nullptr);
+        m_resetPin = std::move(other.m_resetPin);
+        m_doneSemaphore = std::exchange(other.m_doneSemaphore, nullptr);
+        m_queued = std::exchange(other.m_queued, 0);
+    }
+    return *this;
+}
+
+void Display::Transports::I80::reset() {
+    // At least 10 us low, commands are accepted 5 ms after release. Longer waits are up to init sequences.
+    m_resetPin.write(false);
+    Utility::Sleep(0.00001f);
+    m_resetPin.write(true);
+    Utility::Sleep(0.005f);
+}
+
+void Display::Transports::I80::command(uint8_t code, const uint8_t* parameters, size_t length) {
+    // Waits for queued pixel writes on its own
+    ESP_ERROR_CHECK(esp_lcd_panel_io_tx_param(m_io, code, parameters, length));
+}
+
+void Display::Transports::I80::pixels(const uint8_t* data, size_t length) {
+    if (m_queued == QueueDepth) {
+        xSemaphoreTake(m_doneSemaphore, portMAX_DELAY);
+        --m_queued;
+    }
+
+    // Command -1: continue the memory write without sending a command first
+    ESP_ERROR_CHECK(esp_lcd_panel_io_tx_color(m_io, -1, data, length));
+    ++m_queued;
+}
+
+void Display::Transports::I80::flush() {
+    for (; m_queued; --m_queued)
+        xSemaphoreTake(m_doneSemaphore, portMAX_DELAY);
+}
+
+} // namespace evms
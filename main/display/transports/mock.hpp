@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace evms {
+
+namespace Display {
+    namespace Transports {
+        // Records everything sent instead of talking to hardware, for host tests and tools
+        class Mock {
+        public:
+            struct Write {
+                bool command;               // True for a command code, false for parameters and pixels
+                std::vector<uint8_t> bytes;
+            };
+
+            /*
+            *   How long the bus would be busy, for host simulations: every transfer (command code,
+            *   its parameters, each pixels() call) costs a fixed setup time plus its bits at frequency.
+            */
+            struct WireModel {
+                int frequency = 0;                  // Hz, 0 disables the model
+                int transferOverheadNanoseconds = 0;
+            };
+
+        private:
+            std::vector<Write> m_writes;
+            bool m_recordWrites = true;
+            WireModel m_wireModel;
+            size_t m_bytesWritten = 0;
+            int64_t m_wireNanoseconds = 0;
+            int m_commands = 0;
+            int m_resets = 0;
+            int m_flushes = 0;
+
+        public:
+            Mock() = default;
+
+            // Without recording writes only counts them, for long runs that shouldn't allocate
+            explicit Mock(bool recordWrites)
+                : m_recordWrites(recordWrites)
+            {}
+
+            Mock(bool recordWrites, WireModel wireModel)
+                : m_recordWrites(recordWrites)
+                , m_wireModel(wireModel)
+            {}
+
+        public:
+            inline void reset() {
+                ++m_resets;
+            }
+
+            inline void command(uint8_t code, const uint8_t* parameters, size_t length) {
+                ++m_commands;
+                record(true, &code, 1);
+                if (length)
+                    record(false, parameters, length);
+            }
+
+            inline void pixels(const uint8_t* data, size_t length) {
+                record(false, data, length);
+            }
+
+            inline void flush() {
+                ++m_flushes;
+            }
+
+            // Forget what has been recorded so far
+            inline void clear() {
+                m_writes.clear();
+                m_bytesWritten = 0;
+                m_wireNanoseconds = 0;
+                m_commands = 0;
+                m_resets = 0;
+                m_flushes = 0;
+            }
+
+        private:
+            inline void record(bool command, const uint8_t* data, size_t length) {
+                m_bytesWritten += length;
+                if (m_wireModel.frequency)
+                    m_wireNanoseconds += m_wireModel.transferOverheadNanoseconds + int64_t(length) * 8'000'000'000 / m_wireModel.frequency;
+                if (!m_recordWrites)
+                    return;
+
+                // Consecutive writes of the same kind are one stream on the wire
+                if (m_writes.empty() || m_writes.back().command != command || command)
+                    m_writes.push_back({ command, {} });
+                m_writes.back().bytes.insert(m_writes.back().bytes.end(), data, data + length);
+            }
+
+        public:
+            inline const std::vector<Write>& writes() const {
+                return m_writes;
+            }
+
+            inline size_t bytesWritten() const {
+                return m_bytesWritten;
+            }
+
+            // Bus time of everything written so far under the wire model, a clock for simulations
+            inline int64_t wireNanoseconds() const {
+                return m_wireNanoseconds;
+            }
+
+            // Command codes sent, e.g. three per address window
+            inline int commands() const {
+                return m_commands;
+            }
+
+            inline int resets() const {
+                return m_resets;
+            }
+
+            inline int flushes() const {
+                return m_flushes;
+            }
+        };
+    }
+}
+
+} // namespace evms
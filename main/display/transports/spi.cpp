@@ -0,0 +1,36 @@
+#include "spi.hpp"
+
+#include "utility/time.hpp"
+
+namespace evms {
+
+Display::Transports::Spi::Spi(const Drivers::SpiBus& spiBus, gpio_num_t csPin, gpio_num_t resetPin, gpio_num_t dcPin, int frequency, const char* logName)
+    : SpiDevice(spiBus.newDevice(logName, csPin, frequency, false))
+    , m_resetPin("RESET", resetPin, GPIO_MODE_OUTPUT)
+    , m_dcPin("DC", dcPin, GPIO_MODE_OUTPUT)
+{}
+
+void Display::Transports::Spi::reset() {
+    // At least 10 us low, commands are accepted 5 ms after release. Longer waits are up to init sequences.
+    m_resetPin.write(false);
+    Utility::Sleep(0.00001f);
+    m_resetPin.write(true);
+    Utility::Sleep(0.005f);
+}
+
+void Display::Transports::Spi::command(uint8_t code, const uint8_t* parameters, size_t length) {
+    m_dcPin.write(false);
+    send(&code, 1);
+
+    if (length) {
+        m_dcPin.write(true);
+        send(parameters, length);
+    }
+}
+
+void Display::Transports::Spi::pixels(const uint8_t* data, size_t length) {
+    m_dcPin.write(true);
+    send(data, length);
+}
+
+} // namespace evms
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "drivers/gpio_pin.hpp"
+#include "drivers/spi_bus.hpp"
+
+namespace evms {
+
+namespace Display {
+    namespace Transports {
+        // 4-wire SPI with a separate data/command pin, every send blocks until done
+        class Spi : private Drivers::SpiDevice {
+        private:
+            Drivers::GpioPin m_resetPin;
+            Drivers::GpioPin m_dcPin;
+
+        public:
+            Spi(const Drivers::SpiBus& spiBus, gpio_num_t csPin, gpio_num_t resetPin, gpio_num_t dcPin, int frequency, const char* logName = "Screen");
+
+            Spi(const Spi& other) = delete;
+
+            Spi(Spi&& other) noexcept = default;
+
+            ~Spi() = default;
+
+        public:
+            Spi& operator=(const Spi& other) = delete;
+
+            Spi& operator=(Spi&& other) noexcept = default;
+
+        public:
+            void reset();
+
+            void command(uint8_t code, const uint8_t* parameters, size_t length);
+
+            void pixels(const uint8_t* data, size_t length);
+
+            inline void flush() {}
+        };
+    }
+}
+
+} // namespace evms
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+namespace evms {
+
+namespace Display {
+    /*
+    *   Transports move bytes between Screen and the panel controller. Screen speaks
+    *   the panel protocol (commands, address window, pixel stream) and is templated
+    *   on its transport, so calls are resolved at compile time.
+    *
+    *   reset()     Pulse the controller's reset line (if there is one)
+    *   command()   Send command code followed by its parameters
+    *   pixels()    Continue a memory write started with a command. Transports may send
+    *               asynchronously: data must stay untouched until the next flush()
+    *   flush()     Wait until everything sent so far is on the wire
+    */
+    namespace Transports {
+        template <typename TransportType>
+        concept Transport = std::movable<TransportType> && requires(TransportType transport, uint8_t code, const uint8_t* data, size_t length) {
+            transport.reset();
+            transport.command(code, data, length);
+            transport.pixels(data, length);
+            transport.flush();
+        };
+    }
+}
+
+} // namespace evms
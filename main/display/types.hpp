@@ -2,7 +2,9 @@
 
 #include <cstdint>
 #include <array>
+#include <algorithm>
 #include <compare>
+#include <type_traits>
 
 namespace evms {
 
@@ -42,10 +44,166 @@ namespace Display {
         }
     };
 
+    /*
+    *   Non-owning view of a rectangular pixel region.
+    *   Stride is the distance between rows in pixels, so a view can address
+    *   a sub-rectangle of a larger buffer (sprite sheet, framebuffer) in place.
+    */
+    template <typename Pixel>
+    class BasicPixelView {
+    private:
+        Pixel* m_data = nullptr;
+        int m_width = 0;
+        int m_height = 0;
+        int m_stride = 0;
+
+    public:
+        constexpr BasicPixelView() = default;
+
+        constexpr BasicPixelView(Pixel* data, int width, int height, int stride)
+            : m_data(data)
+            , m_width(width)
+            , m_height(height)
+            , m_stride(stride)
+        {}
+
+        constexpr BasicPixelView(Pixel* data, Dimensions2D dimensions)
+            : BasicPixelView(data, dimensions.width, dimensions.height, dimensions.width)
+        {}
+
+        template <Dimensions2D Dimensions>
+        constexpr BasicPixelView(PixelMap<Dimensions>& map)
+            : BasicPixelView(map.data(), Dimensions)
+        {}
+
+        template <Dimensions2D Dimensions> requires std::is_const_v<Pixel>
+        constexpr BasicPixelView(const PixelMap<Dimensions>& map)
+            : BasicPixelView(map.data(), Dimensions)
+        {}
+
+        // Mutable view converts to read-only view
+        template <typename Other> requires std::is_same_v<const Other, Pixel> && (!std::is_same_v<Other, Pixel>)
+        constexpr BasicPixelView(const BasicPixelView<Other>& other)
+            : BasicPixelView(other.data(), other.width(), other.height(), other.stride())
+        {}
+
+    public:
+        constexpr Pixel* data() const {
+            return m_data;
+        }
+
+        constexpr int width() const {
+            return m_width;
+        }
+
+        constexpr int height() const {
+            return m_height;
+        }
+
+        constexpr int stride() const {
+            return m_stride;
+        }
+
+        constexpr Dimensions2D dimensions() const {
+            return { m_width, m_height };
+        }
+
+        constexpr Pixel* row(int y) const {
+            return m_data + (y * m_stride);
+        }
+
+        constexpr Pixel& at(int x, int y) const {
+            return m_data[(y * m_stride) + x];
+        }
+
+        // Clipped to view bounds, empty if the region doesn't intersect the view
+        constexpr BasicPixelView subview(int x, int y, Dimensions2D dimensions) const {
+            if (x < 0) {
+                dimensions.width += x;
+                x = 0;
+            }
+            if (y < 0) {
+                dimensions.height += y;
+                y = 0;
+            }
+            dimensions.width = std::min(dimensions.width, m_width - x);
+            dimensions.height = std::min(dimensions.height, m_height - y);
+            if (dimensions.width <= 0 || dimensions.height <= 0)
+                return {};
+            return { m_data + (y * m_stride) + x, dimensions.width, dimensions.height, m_stride };
+        }
+
+    public:
+        constexpr operator bool() const {
+            return m_data && m_width > 0 && m_height > 0;
+        }
+    };
+
+    using PixelView = BasicPixelView<const uint16_t>;
+    using MutablePixelView = BasicPixelView<uint16_t>;
+
     struct Position {
         int x = 0;
         int y = 0;
     };
+
+    struct Rect {
+        int x = 0;
+        int y = 0;
+        int width = 0;
+        int height = 0;
+
+        constexpr operator bool() const {
+            return width > 0 && height > 0;
+        }
+
+        constexpr Dimensions2D dimensions() const {
+            return { width, height };
+        }
+
+        constexpr int area() const {
+            return *this ? width * height : 0;
+        }
+
+        constexpr bool contains(Position position) const {
+            return (
+                position.x >= x && position.x < x + width &&
+                position.y >= y && position.y < y + height
+            );
+        }
+
+        constexpr bool intersects(const Rect& other) const {
+            return (
+                x < other.x + other.width && other.x < x + width &&
+                y < other.y + other.height && other.y < y + height
+            );
+        }
+
+        // Smallest rect containing both, empty rects are ignored
+        constexpr Rect united(const Rect& other) const {
+            if (!other)
+                return *this;
+            if (!*this)
+                return other;
+
+            int left = std::min(x, other.x);
+            int top = std::min(y, other.y);
+            int right = std::max(x + width, other.x + other.width);
+            int bottom = std::max(y + height, other.y + other.height);
+            return { left, top, right - left, bottom - top };
+        }
+
+        // Empty if rects don't intersect
+        constexpr Rect intersected(const Rect& other) const {
+            int left = std::max(x, other.x);
+            int top = std::max(y, other.y);
+            int right = std::min(x + width, other.x + other.width);
+            int bottom = std::min(y + height, other.y + other.height);
+            if (right <= left || bottom <= top)
+                return {};
+            return { left, top, right - left, bottom - top };
+        }
+    };
 }
 
 } // namespace evms
@@ -0,0 +1,153 @@
+#include "dma_pool.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+#ifdef ESP_PLATFORM
+#include <esp_heap_caps.h>
+#endif
+
+#include "diagnostics/memory_report.hpp"
+
+namespace evms {
+
+static constexpr uint16_t EndOfList = 0xFFFF;
+
+static uint8_t* AllocateSlab(size_t size) {
+#ifdef ESP_PLATFORM
+    return static_cast<uint8_t*>(heap_caps_malloc(size, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL));
+#else
+    return static_cast<uint8_t*>(std::aligned_alloc(Drivers::DmaPool::Alignment, size));
+#endif
+}
+
+static void FreeSlab(uint8_t* slab) {
+#ifdef ESP_PLATFORM
+    heap_caps_free(slab);
+#else
+    std::free(slab);
+#endif
+}
+
+static inline uint32_t MakeHead(uint32_t previous, uint16_t index) {
+    return ((previous + 0x10000) & 0xFFFF0000) | index;
+}
+
+Drivers::DmaPool::Block::Block(DmaPool* pool, uint16_t sizeClass, uint16_t index)
+    : m_pool(pool)
+    , m_data(pool->m_freeLists[sizeClass].slab + (index * pool->m_freeLists[sizeClass].blockSize))
+    , m_sizeClass(sizeClass)
+    , m_index(index)
+{}
+
+Drivers::DmaPool::Block::Block(Block&& other) noexcept
+    : m_pool(std::exchange(other.m_pool, nullptr))
+    , m_data(std::exchange(other.m_data, nullptr))
+    , m_sizeClass(other.m_sizeClass)
+    , m_index(other.m_index)
+{}
+
+Drivers::DmaPool::Block::~Block() {
+    release();
+}
+
+Drivers::DmaPool::Block& Drivers::DmaPool::Block::operator=(Block&& other) noexcept {
+    if (&other != this) {
+        release();
+        m_pool = std::exchange(other.m_pool, nullptr);
+        m_data = std::exchange(other.m_data, nullptr);
+        m_sizeClass = other.m_sizeClass;
+        m_index = other.m_index;
+    }
+    return *this;
+}
+
+void Drivers::DmaPool::Block::release() {
+    if (m_pool) {
+        m_pool->release(m_sizeClass, m_index);
+        m_pool = nullptr;
+        m_data = nullptr;
+    }
+}
+
+size_t Drivers::DmaPool::Block::size() const {
+    return m_pool ? m_pool->m_freeLists[m_sizeClass].blockSize : 0;
+}
+
+Drivers::DmaPool::DmaPool(std::initializer_list<SizeClass> sizeClasses) {
+    for (const SizeClass& sizeClass : sizeClasses) {
+        if (m_sizeClassCount == MaxSizeClasses)
+            break;
+
+        FreeList& freeList = m_freeLists[m_sizeClassCount++];
+        freeList.head = EndOfList;
+        freeList.blockSize = (sizeClass.blockSize + Alignment - 1) / Alignment * Alignment;
+        size_t blockCount = std::min(sizeClass.blockCount, MaxBlocksPerClass);
+        if (freeList.blockSize == 0 || blockCount == 0)
+            continue;
+
+        freeList.slab = AllocateSlab(freeList.blockSize * blockCount);
+        if (freeList.slab == nullptr)
+            continue;
+
+        // All blocks start out free, in address order
+        freeList.next = std::make_unique<std::atomic<uint16_t>[]>(blockCount);
+        for (size_t index = 0; index < blockCount; ++index)
+            freeList.next[index].store(index + 1 < blockCount ? static_cast<uint16_t>(index + 1) : EndOfList, std::memory_order_relaxed);
+        freeList.blockCount = blockCount;
+        freeList.available = blockCount;
+        freeList.head = 0;
+        Diagnostics::Charge(Diagnostics::Subsystem::DmaPool, freeList.blockSize * blockCount);
+    }
+}
+
+Drivers::DmaPool::~DmaPool() {
+    for (size_t sizeClass = 0; sizeClass < m_sizeClassCount; ++sizeClass) {
+        FreeList& freeList = m_freeLists[sizeClass];
+        if (freeList.slab) {
+            Diagnostics::Release(Diagnostics::Subsystem::DmaPool, freeList.blockSize * freeList.blockCount);
+            FreeSlab(freeList.slab);
+        }
+    }
+}
+
+Drivers::DmaPool::Block Drivers::DmaPool::acquire(size_t size) {
+    for (size_t sizeClass = 0; sizeClass < m_sizeClassCount; ++sizeClass) {
+        FreeList& freeList = m_freeLists[sizeClass];
+        if (freeList.blockSize < size)
+            continue;
+
+        uint32_t head = freeList.head.load(std::memory_order_acquire);
+        while (true) {
+            uint16_t index = head & 0xFFFF;
+            if (index == EndOfList)
+                break;
+
+            // Stale if another task took the block meanwhile, the counter makes the CAS fail then
+            uint16_t next = freeList.next[index].load(std::memory_order_relaxed);
+            if (freeList.head.compare_exchange_weak(head, MakeHead(head, next), std::memory_order_acquire, std::memory_order_acquire)) {
+                freeList.available.fetch_sub(1, std::memory_order_relaxed);
+                return { this, static_cast<uint16_t>(sizeClass), index };
+            }
+        }
+    }
+    return {};
+}
+
+void Drivers::DmaPool::release(uint16_t sizeClass, uint16_t index) {
+    FreeList& freeList = m_freeLists[sizeClass];
+    uint32_t head = freeList.head.load(std::memory_order_relaxed);
+    do {
+        freeList.next[index].store(head & 0xFFFF, std::memory_order_relaxed);
+    } while (!freeList.head.compare_exchange_weak(head, MakeHead(head, index), std::memory_order_release, std::memory_order_relaxed));
+    freeList.available.fetch_add(1, std::memory_order_relaxed);
+}
+
+Drivers::DmaPool& Drivers::DmaPool::Shared() {
+    // Small blocks for command and touch transfers, large ones hold two RGB565 rows of 320 pixels
+    static DmaPool s_pool({ { 64, 16 }, { 1280, 4 } });
+    return s_pool;
+}
+
+} // namespace evms
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+
+namespace evms {
+
+namespace Drivers {
+    /*
+    *   Fixed-block pool of DMA capable, word aligned internal memory. Each size class is
+    *   one slab allocated up front with a lock-free free list of its blocks, so acquiring
+    *   and releasing are a CAS each, never touch the heap and can't fragment it. Any task
+    *   may acquire and release. Blocks are RAII handles and must not outlive their pool.
+    *   On the host slabs come from plain malloc.
+    */
+    class DmaPool {
+    public:
+        struct SizeClass {
+            size_t blockSize;
+            size_t blockCount;
+        };
+
+        static constexpr size_t MaxSizeClasses = 4;
+        static constexpr size_t MaxBlocksPerClass = 0xFFFF;
+
+        // DMA descriptors take word aligned buffers, block sizes are rounded up to this
+        static constexpr size_t Alignment = 4;
+
+        class Block {
+        private:
+            friend class DmaPool;
+
+            DmaPool* m_pool = nullptr;
+            uint8_t* m_data = nullptr;
+            uint16_t m_sizeClass = 0;
+            uint16_t m_index = 0;
+
+        private:
+            Block(DmaPool* pool, uint16_t sizeClass, uint16_t index);
+
+        public:
+            Block() = default;
+
+            Block(const Block& other) = delete;
+
+            Block(Block&& other) noexcept;
+
+            ~Block();
+
+        public:
+            Block& operator=(const Block& other) = delete;
+
+            Block& operator=(Block&& other) noexcept;
+
+        public:
+            // Give the block back to the pool early
+            void release();
+
+            // Capacity of the block, at least what was asked for
+            size_t size() const;
+
+        public:
+            inline uint8_t* data() const {
+                return m_data;
+            }
+
+            template <typename T>
+            inline T* as() const {
+                return reinterpret_cast<T*>(m_data);
+            }
+
+            explicit operator bool() const {
+                return m_data != nullptr;
+            }
+        };
+
+    private:
+        struct FreeList {
+            uint8_t* slab = nullptr;
+            size_t blockSize = 0;
+            size_t blockCount = 0;
+
+            // Next free block of every block, only meaningful while it's free
+            std::unique_ptr<std::atomic<uint16_t>[]> next;
+
+            // Index of the first free block in the low half, a change counter against ABA in the high half
+            std::atomic<uint32_t> head = 0;
+            std::atomic<uint32_t> available = 0;
+        };
+
+    private:
+        std::array<FreeList, MaxSizeClasses> m_freeLists;
+        size_t m_sizeClassCount = 0;
+
+    private:
+        void release(uint16_t sizeClass, uint16_t index);
+
+    public:
+        /*
+        *   Size classes in ascending block size, up to MaxSizeClasses. A class whose slab
+        *   can't be allocated has no blocks (see capacity()) instead of failing the pool.
+        */
+        DmaPool(std::initializer_list<SizeClass> sizeClasses);
+
+        DmaPool(const DmaPool& other) = delete;
+
+        ~DmaPool();
+
+    public:
+        DmaPool& operator=(const DmaPool& other) = delete;
+
+    public:
+        // Block from the smallest class that fits size and has one free, empty if there's none
+        Block acquire(size_t size);
+
+        // Shared by drivers and screens, sized for touch transfers and full pixel rows
+        static DmaPool& Shared();
+
+    public:
+        inline size_t sizeClassCount() const {
+            return m_sizeClassCount;
+        }
+
+        inline size_t blockSize(size_t sizeClass) const {
+            return m_freeLists[sizeClass].blockSize;
+        }
+
+        inline size_t capacity(size_t sizeClass) const {
+            return m_freeLists[sizeClass].blockCount;
+        }
+
+        inline size_t available(size_t sizeClass) const {
+            return m_freeLists[sizeClass].available.load(std::memory_order_relaxed);
+        }
+    };
+}
+
+} // namespace evms
@@ -39,10 +39,13 @@ Drivers::GpioPin::GpioPin(const char* logName, gpio_num_t pin, gpio_mode_t mode)
 Drivers::GpioPin::GpioPin(GpioPin&& other) noexcept
     : m_logTag(std::move(other.m_logTag)) 
     , m_pin(std::exchange(other.m_pin, GPIO_NUM_MAX))
+    , m_interrupt(std::exchange(other.m_interrupt, false))
 {}
 
 Drivers::GpioPin::~GpioPin() {
     if (m_pin != GPIO_NUM_MAX) {
+        if (m_interrupt)
+            gpio_isr_handler_remove(m_pin);
         gpio_reset_pin(m_pin);
         ESP_LOGI(m_logTag.c_str(), "Deinitialized");
     }
@@ -52,6 +55,7 @@ Drivers::GpioPin& Drivers::GpioPin::operator=(GpioPin&& other) noexcept {
     if (&other != this) {
         m_logTag = std::move(other.m_logTag);
         m_pin = std::exchange(other.m_pin, GPIO_NUM_MAX);        
+        m_interrupt = std::exchange(other.m_interrupt, false);
     }
     return *this;
 }
@@ -64,4 +68,31 @@ bool Drivers::GpioPin::read() const {
     return gpio_get_level(m_pin);
 }
 
+bool Drivers::GpioPin::setInterrupt(gpio_int_type_t type, gpio_isr_t handler, void* argument) {
+    if (m_interrupt) {
+        gpio_isr_handler_remove(m_pin);
+        m_interrupt = false;
+    }
+    gpio_set_intr_type(m_pin, type);
+    if (type == GPIO_INTR_DISABLE || handler == nullptr)
+        return true;
+
+    // Service is shared by all pins, another one may have installed it already
+    esp_err_t error = gpio_install_isr_service(0);
+    if (error != ESP_OK && error != ESP_ERR_INVALID_STATE) {
+        ESP_LOGE(m_logTag.c_str(), "Couldn't install GPIO ISR service: %s", esp_err_to_name(error));
+        return false;
+    }
+
+    error = gpio_isr_handler_add(m_pin, handler, argument);
+    if (error != ESP_OK) {
+        ESP_LOGE(m_logTag.c_str(), "Couldn't add interrupt handler: %s", esp_err_to_name(error));
+        gpio_set_intr_type(m_pin, GPIO_INTR_DISABLE);
+        return false;
+    }
+    m_interrupt = true;
+    ESP_LOGI(m_logTag.c_str(), "Interrupt handler added");
+    return true;
+}
+
 } // namespace evms
@@ -11,6 +11,7 @@ namespace Drivers {
     private:
         std::string m_logTag;
         gpio_num_t m_pin;
+        bool m_interrupt = false;
 
     public:
         GpioPin(const char* logName, gpio_num_t pin, gpio_mode_t mode);
@@ -30,6 +31,13 @@ namespace Drivers {
         void write(bool level);
 
         bool read() const;
+
+        /*
+        *   Call handler(argument) from an ISR on every edge of type. Handler must be in IRAM and
+        *   argument must outlive the pin (or the next setInterrupt()), moving the pin keeps it.
+        *   GPIO_INTR_DISABLE removes the handler. Returns false if the ISR service can't be set up.
+        */
+        bool setInterrupt(gpio_int_type_t type, gpio_isr_t handler = nullptr, void* argument = nullptr);
     };
 }
 
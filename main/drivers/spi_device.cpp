@@ -1,9 +1,12 @@
 #include "spi_device.hpp"
 
+#include <cstring>
 #include <utility>
 
 #include <esp_log.h>
+#include <esp_memory_utils.h>
 
+#include "drivers/dma_pool.hpp"
 #include "spi_bus.hpp"
 
 namespace evms {
@@ -14,6 +17,13 @@ static std::string MakeLogTag(const std::string& logName, spi_host_device_t host
     return logName + " SpiDevice [" + hostStr + ", CS_" + csPinStr + "]";
 }
 
+// Received lengths must be whole words too, or the driver bounces them anyway
+static bool DmaReady(const void* buffer, size_t length, bool receive) {
+    if (!esp_ptr_dma_capable(buffer) || reinterpret_cast<uintptr_t>(buffer) % Drivers::DmaPool::Alignment != 0)
+        return false;
+    return !receive || length % Drivers::DmaPool::Alignment == 0;
+}
+
 Drivers::SpiDevice::SpiDevice(const char* logName, spi_host_device_t host, gpio_num_t csPin, int frequency, bool fullDuplex)
     : m_logTag(MakeLogTag(logName, host, csPin))
     , m_handle(0) {
@@ -47,43 +57,56 @@ Drivers::SpiDevice& Drivers::SpiDevice::operator=(SpiDevice&& other) noexcept {
     return *this;
 }
 
-std::vector<uint8_t> Drivers::SpiDevice::transfer(const std::vector<uint8_t>& data, size_t responseLength) const {
-    std::vector<uint8_t> response(responseLength);
+void Drivers::SpiDevice::transfer(const uint8_t* data, size_t length, uint8_t* response, size_t responseLength) const {
     spi_transaction_t transaction = {};
-    transaction.length = data.size() * 8;
-    transaction.tx_buffer = data.data();
-    transaction.rxlength = response.size() * 8;
-    transaction.rx_buffer = response.data();
+    transaction.length = length * 8;
+    transaction.rxlength = responseLength * 8;
+
+    DmaPool::Block txBlock;
+    if (length && length <= sizeof(transaction.tx_data)) {
+        transaction.flags |= SPI_TRANS_USE_TXDATA;
+        std::memcpy(transaction.tx_data, data, length);
+    }
+    else if (length && !DmaReady(data, length, false) && (txBlock = DmaPool::Shared().acquire(length))) {
+        std::memcpy(txBlock.data(), data, length);
+        transaction.tx_buffer = txBlock.data();
+    }
+    else {
+        transaction.tx_buffer = data;
+    }
+
+    DmaPool::Block rxBlock;
+    if (responseLength && responseLength <= sizeof(transaction.rx_data))
+        transaction.flags |= SPI_TRANS_USE_RXDATA;
+    else if (responseLength && !DmaReady(response, responseLength, true) && (rxBlock = DmaPool::Shared().acquire(responseLength)))
+        transaction.rx_buffer = rxBlock.data();
+    else
+        transaction.rx_buffer = response;
+
     ESP_ERROR_CHECK(spi_device_transmit(m_handle, &transaction));
+    if (transaction.flags & SPI_TRANS_USE_RXDATA)
+        std::memcpy(response, transaction.rx_data, responseLength);
+    else if (rxBlock)
+        std::memcpy(response, rxBlock.data(), responseLength);
+}
+
+Drivers::SpiDevice::Buffer Drivers::SpiDevice::transfer(const Buffer& data, size_t responseLength) const {
+    Buffer response(responseLength);
+    transfer(data.data(), data.size(), response.data(), response.size());
     return response;
 }
 
-void Drivers::SpiDevice::send(const std::vector<uint8_t>& data) const {
-    spi_transaction_t transaction = {};
-    transaction.length = data.size() * 8;
-    transaction.tx_buffer = data.data();
-    transaction.rxlength = 0;
-    transaction.rx_buffer = nullptr;
-    ESP_ERROR_CHECK(spi_device_transmit(m_handle, &transaction));
+void Drivers::SpiDevice::send(const Buffer& data) const {
+    transfer(data.data(), data.size(), nullptr, 0);
 }
 
 void Drivers::SpiDevice::send(const uint8_t* data, size_t length) const {
-    spi_transaction_t transaction = {};
-    transaction.length = length * 8;
-    transaction.tx_buffer = data;
-    transaction.rxlength = 0;
-    transaction.rx_buffer = nullptr;
-    ESP_ERROR_CHECK(spi_device_transmit(m_handle, &transaction));
+    transfer(data, length, nullptr, 0);
 }
 
-std::vector<uint8_t> Drivers::SpiDevice::receive(size_t length) const {
-    std::vector<uint8_t> buffer(length);
-    spi_transaction_t transaction = {};
-    transaction.length = 0;
-    transaction.tx_buffer = nullptr;
-    transaction.rxlength = buffer.size() * 8;
-    transaction.rx_buffer = buffer.data();
-    ESP_ERROR_CHECK(spi_device_transmit(m_handle, &transaction));
+Drivers::SpiDevice::Buffer Drivers::SpiDevice::receive(size_t length) const {
+    Buffer buffer(length);
+    transfer(nullptr, 0, buffer.data(), buffer.size());
     return buffer;
 }
 
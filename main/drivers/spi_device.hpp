@@ -7,10 +7,15 @@
 #include <driver/gpio.h>
 #include <driver/spi_master.h>
 
+#include "diagnostics/memory_report.hpp"
+
 namespace evms {
 
 namespace Drivers {
     class SpiDevice {
+    public:
+        using Buffer = Diagnostics::TaggedVector<uint8_t, Diagnostics::Subsystem::Spi>;
+
     private:
         std::string m_logTag;
         spi_device_handle_t m_handle;
@@ -30,13 +35,21 @@ namespace Drivers {
         SpiDevice& operator=(SpiDevice&& other) noexcept;
 
     public:
-        std::vector<uint8_t> transfer(const std::vector<uint8_t>& data, size_t responseLength) const;
+        /*
+        *   Send length bytes of data, then or meanwhile (full duplex) receive responseLength bytes.
+        *   Up to 4 bytes each way travel inside the transaction. Longer buffers that DMA can't use
+        *   in place (not DMA capable or not word aligned) are staged through Drivers::DmaPool
+        *   instead of the driver allocating a bounce buffer for every transaction.
+        */
+        void transfer(const uint8_t* data, size_t length, uint8_t* response, size_t responseLength) const;
+
+        Buffer transfer(const Buffer& data, size_t responseLength) const;
 
-        void send(const std::vector<uint8_t>& data) const;
+        void send(const Buffer& data) const;
 
         void send(const uint8_t* data, size_t length) const;
 
-        std::vector<uint8_t> receive(size_t length) const;
+        Buffer receive(size_t length) const;
     };
 }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "display/sprite_atlas.hpp"
 #include "display/types.hpp"
 
 namespace evms {
@@ -258,6 +259,9 @@ namespace Bitmaps {
         0xFFFF, 0xFFFF, 0xFFFF,
         0xFFFF, 0xFFFF, 0xFFFF,
     }};
+
+    // Frame 0 is DvdLogo, frame 1 is Dot
+    static constexpr auto Sprites = Display::PackAtlas(DvdLogo, Dot);
 }
 
 } // namespace evms
@@ -1,17 +1,60 @@
+#include <future>
 #include <iostream>
-#include <thread>
 #include <algorithm>
-
+#include <cmath>
+#include <optional>
+
+#include "esp_random.h"
+
+#include "app/demo.hpp"
+#include "assets/asset_pack.hpp"
+#include "diagnostics/memory_report.hpp"
+#include "diagnostics/snapshot_stream.hpp"
+#include "assets/pack_storage.hpp"
+#include "display/controllers/ili9341.hpp"
+#include "display/latency_probe.hpp"
 #include "display/screen.hpp"
 #include "display/touch.hpp"
+#include "display/transports/spi.hpp"
 #include "drivers/pwm_led.hpp"
 #include "drivers/spi_bus.hpp"
+#include "motion/tweener.hpp"
+#include "replay/session_log.hpp"
 #include "utility/random.hpp"
 #include "utility/math.hpp"
 #include "utility/time.hpp"
-#include "bitmaps.hpp"
 using namespace evms;
 
+using Panel = Display::Controllers::Ili9341;
+using Screen = Display::Screen<Panel, Display::Transports::Spi>;
+
+// Session recording buffer (menuconfig: EVMS), 0 disables recording
+constexpr size_t RecordBytes = CONFIG_EVMS_RECORD_SESSION_BYTES;
+
+// Touch-to-photon latency measurement (menuconfig: EVMS)
+#ifdef CONFIG_EVMS_LATENCY_PROBE
+constexpr bool ProbeLatency = true;
+constexpr size_t LatencyReportPresses = CONFIG_EVMS_LATENCY_REPORT_PRESSES;
+#else
+constexpr bool ProbeLatency = false;
+constexpr size_t LatencyReportPresses = 1;
+#endif
+
+// Memory budget report interval (menuconfig: EVMS), 0 disables reports
+#ifdef CONFIG_EVMS_MEMORY_REPORT
+constexpr int64_t MemoryReportMicroseconds = CONFIG_EVMS_MEMORY_REPORT_SECONDS * 1'000'000LL;
+#else
+constexpr int64_t MemoryReportMicroseconds = 0;
+#endif
+
+// Framebuffer snapshots over the console (menuconfig: EVMS), 0 disables them
+constexpr int64_t SnapshotMicroseconds = CONFIG_EVMS_SNAPSHOT_SECONDS * 1'000'000LL;
+#ifdef CONFIG_EVMS_SNAPSHOT_BYTES_PER_FRAME
+constexpr size_t SnapshotBytesPerFrame = CONFIG_EVMS_SNAPSHOT_BYTES_PER_FRAME;
+#else
+constexpr size_t SnapshotBytesPerFrame = 0;
+#endif
+
 /*
 *   Connection to the 2.4" TFT display:
 *   Screen      ESP32
@@ -28,148 +71,116 @@ using namespace evms;
 *   T_IRQ        5
 */
 
-static void EnableBacklightSmoothly(Drivers::PwmLed& backlight) {
-    for (float percentage = 0.0f; percentage <= 100.0f; percentage += 3.3f) {
-        backlight.setDutyPercent(percentage);
-        Utility::Sleep(0.1f);
-    }
-}
-
-static bool AllNotZero(const uint16_t* base, int length, int stride) {
-    for (int index = 0; index < length; ++index)
-        if (base[index * stride] != 0)
-            return false;
-    return true;
-}
-
-static bool ColumnNotZero(Display::Screen& screen, int x, int y, int height) {
-    constexpr int ScreenHeight = Display::Screen::Dimensions.height;
-    if (y + height >= ScreenHeight)
-        height -= (y + height) - ScreenHeight;
-
-    constexpr int ScreenWidth = Display::Screen::Dimensions.width;
-    const auto& framebuffer = screen.framebuffer();
-    const uint16_t* begin = framebuffer.data() + ((y * ScreenWidth) + x);
-    return !AllNotZero(begin, height, ScreenWidth);
-}
-
-static bool RowNotZero(Display::Screen& screen, int x, int y, int width) {
-    constexpr int ScreenWidth = Display::Screen::Dimensions.width;
-    if (x + width >= ScreenWidth)
-        width -= (x + width) - ScreenWidth;
-
-    const auto& framebuffer = screen.framebuffer();
-    const uint16_t* begin = framebuffer.data() + ((y * ScreenWidth) + x);
-    return !AllNotZero(begin, width, 1);
-}
-
 static Display::Position GetPosition(const Display::Touch& touch) {
     Display::Position pos = touch.getTouchPosition();
     if (pos.x < 0 || pos.y < 0)
         return pos;
 
-    // Manually calibrated for now
-    pos.x = static_cast<int>(std::round(Utility::ConvertRange(
-        static_cast<float>(pos.x),
-        300.0f, 3900.0f,
-        0.0f, 320.0f
-    )));
-    pos.y = static_cast<int>(std::round(Utility::ConvertRange(
+    // Manually calibrated for now, touch axes are swapped relative to the panel
+    int x = static_cast<int>(std::round(Utility::ConvertRange(
         static_cast<float>(pos.y),
         250.0f, 3900.0f,
         0.0f, 240.0f
     )));
-    return pos;
+    int y = static_cast<int>(std::round(Utility::ConvertRange(
+        static_cast<float>(pos.x),
+        300.0f, 3900.0f,
+        0.0f, 320.0f
+    )));
+    return Screen::FromNative({ x, y });
 }
 
 extern "C" void app_main() {
     Drivers::SpiBus spiBus("Main", SPI2_HOST, GPIO_NUM_18, GPIO_NUM_23, GPIO_NUM_19);
-    Display::Screen display(spiBus, GPIO_NUM_15, GPIO_NUM_4, GPIO_NUM_2);
+    Screen display(spiBus, GPIO_NUM_15, GPIO_NUM_4, GPIO_NUM_2, Panel::Frequency, Panel::Name);
     Display::Touch touch(spiBus, GPIO_NUM_21, GPIO_NUM_5);
     Drivers::PwmLed backlight("Backlight", LEDC_CHANNEL_0, GPIO_NUM_22);
-    std::thread backlightThread;
+    Motion::Tweener<8> tweener;
 
-    constexpr Display::Dimensions2D ScreenDims = Display::Screen::Dimensions;
-    constexpr Display::Dimensions2D LogoDims = Bitmaps::DvdLogo.dimensions();
-    constexpr int Speed = 1;
-    int xSpeed = Utility::RandomInteger(0, 1) ? Speed : -Speed;
-    int ySpeed = Utility::RandomInteger(0, 1) ? Speed : -Speed;
-    int canvasHits = 0, borderHits = 0, cornerHits = 0;
-    int x = Utility::RandomInteger(0, ScreenDims.width - LogoDims.width);
-    int y = Utility::RandomInteger(0, ScreenDims.height - LogoDims.height);
+    if (!display) {
+        std::cout << "Not enough memory for the framebuffer\n";
+        return;
+    }
 
-    while (true) {
-        Display::Position pos = GetPosition(touch);
-        if (pos.x >= 0 && pos.y >= 0) {
-            display.draw(pos.y - 1, pos.x - 1, Bitmaps::Dot);
-            display.render();
-        }
+    // Panel bring-up is mostly waiting, set everything else up meanwhile
+    std::future<void> displayReady = display.begin();
+
+    // Seed is part of a recorded session, replaying it reproduces the logo's start
+    uint32_t seed = esp_random();
+    Utility::SeedRandom(seed);
+    Replay::Recorder recorder(seed, RecordBytes);
+    bool recording = RecordBytes > 0;
+
+    // Logo comes from the asset pack when it has one, so it can be replaced without a rebuild
+    Assets::PackStorage assetStorage("assets");
+    Assets::AssetPack assets(assetStorage.bytes());
+    Display::PixelView packLogo = assets.asset("logo").view();
+    Display::PixelView logoImage = App::Demo<Screen>::PickLogo(packLogo);
+    if (packLogo && logoImage.data() != packLogo.data())
+        std::cout << "Pack logo is larger than the canvas, using the built-in one\n";
+    App::Demo<Screen> demo(display, logoImage);
+
+    // Without the edge interrupt presses are timed from their first sample
+    Display::LatencyProbe latencyProbe;
+    if (ProbeLatency) {
+        touch.enableEdgeTimestamps();
+        display.setLatencyProbe(&latencyProbe);
+        demo.setLatencyProbe(&latencyProbe);
+    }
 
-        bool horizontalBorderHit = false;
-        if (x <= 0) {
-            xSpeed = Speed;
-            horizontalBorderHit = true;
-        }
-        else if (x + LogoDims.width >= (ScreenDims.width - 1)) {
-            xSpeed = -Speed;
-            horizontalBorderHit = true;
-        }
-        
-        bool xCanvasHit = false;
-        if (x >= 1 && ColumnNotZero(display, x - 1, y, LogoDims.height)) {
-            xSpeed = Speed;
-            xCanvasHit = true;
-        }
-        else if (x + LogoDims.width < ScreenDims.width && ColumnNotZero(display, x + 1 + LogoDims.width, y, LogoDims.height)) {
-            xSpeed = -Speed;
-            xCanvasHit = true;
-        }
+    displayReady.get();
 
-        bool verticalBorderHit = false;
-        if (y <= 0) {
-            ySpeed = Speed;
-            verticalBorderHit = true;
-        }
-        else if (y + LogoDims.height >= (ScreenDims.height - 1)) {
-            ySpeed = -Speed;
-            verticalBorderHit = true;
-        }
+    // Backlight fades in with the frame clock once the panel shows something
+    int backlightDuty = 0;
+    Motion::Tweener<8>::Id backlightFade = tweener.tween(0, 255, 3'000'000, Motion::Easing::Linear, Motion::Tweener<8>::Repeat::Once,
+        [](void* context) { static_cast<Drivers::PwmLed*>(context)->setDuty(255); }, &backlight);
 
-        bool yCanvasHit = false;
-        if (y >= 1 && RowNotZero(display, x, y - 1, LogoDims.width)) {
-            ySpeed = Speed;
-            yCanvasHit = true;
-        }
-        else if (y + LogoDims.height < ScreenDims.height && RowNotZero(display, x, y + 1 + LogoDims.height, LogoDims.width)) {
-            ySpeed = -Speed;
-            yCanvasHit = true;
+    // Receive with tools/snapshot_receiver
+    std::optional<Diagnostics::SnapshotStreamer> snapshots;
+    if (SnapshotMicroseconds)
+        snapshots.emplace(display.framebuffer(), std::cout);
+
+    int64_t nextMemoryReport = Utility::TimeMicroseconds() + MemoryReportMicroseconds;
+    int64_t nextSnapshot = Utility::TimeMicroseconds();
+    int64_t lastFrame = Utility::TimeMicroseconds();
+    while (true) {
+        int64_t now = Utility::TimeMicroseconds();
+        tweener.advance(static_cast<uint32_t>(now - lastFrame));
+        lastFrame = now;
+        if (tweener.active(backlightFade) && tweener.value(backlightFade) != backlightDuty) {
+            backlightDuty = tweener.value(backlightFade);
+            backlight.setDuty(static_cast<uint8_t>(backlightDuty));
         }
 
-        if (horizontalBorderHit && verticalBorderHit)
-            ++cornerHits;
-        else if (horizontalBorderHit || verticalBorderHit)
-            ++borderHits;
-        else if (xCanvasHit || yCanvasHit)
-            ++canvasHits;
+        Display::Position screenPos = GetPosition(touch);
+        size_t measuredPresses = latencyProbe.count();
+        if (ProbeLatency)
+            latencyProbe.sample(screenPos, touch.takeEdgeTime());
+        if (recording && !recorder.frame(Utility::TimeMicroseconds(), screenPos)) {
+            // Replay with tools/replay_runner
+            recorder.dump(std::cout);
+            recording = false;
+        }
 
-        if (xCanvasHit || yCanvasHit || horizontalBorderHit || verticalBorderHit) {
+        if (demo.frame(screenPos)) {
             std::cout << "Time: " << Utility::TimeSeconds() << "s, ";
-            std::cout << "canvas hits: " << canvasHits << ", ";
-            std::cout << "border hits: " << borderHits << ", ";
-            std::cout << "corner hits: " << cornerHits << '\n';
+            std::cout << "canvas hits: " << demo.canvasHits() << ", ";
+            std::cout << "border hits: " << demo.borderHits() << ", ";
+            std::cout << "corner hits: " << demo.cornerHits() << '\n';
         }
+        if (latencyProbe.count() != measuredPresses && latencyProbe.count() % LatencyReportPresses == 0)
+            latencyProbe.report(std::cout);
 
-        display.clear(x, y, LogoDims);
-        x += xSpeed;
-        y += ySpeed;
-        display.draw(x, y, Bitmaps::DvdLogo);
-        display.render();
-        Utility::Sleep(0.01);
-
-        static bool s_firstTime = true;
-        if (s_firstTime) {
-            backlightThread = std::thread(&EnableBacklightSmoothly, std::ref(backlight));
-            s_firstTime = false;
+        Diagnostics::FrameEnded();
+        if (MemoryReportMicroseconds && Utility::TimeMicroseconds() >= nextMemoryReport) {
+            Diagnostics::Report(std::cout);
+            nextMemoryReport += MemoryReportMicroseconds;
         }
+        if (snapshots) {
+            if (Utility::TimeMicroseconds() >= nextSnapshot && snapshots->begin())
+                nextSnapshot += SnapshotMicroseconds;
+            snapshots->step(SnapshotBytesPerFrame);
+        }
+        Utility::Sleep(0.01);
     }
 }
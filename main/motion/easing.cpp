@@ -0,0 +1,59 @@
+#include "easing.hpp"
+
+namespace evms {
+
+// Curves of t in [0, 1], evaluated at compile time only
+static constexpr double Curve(Motion::Easing easing, double t) {
+    switch (easing) {
+        case Motion::Easing::InQuad:
+            return t * t;
+        case Motion::Easing::OutQuad:
+            return 1 - (1 - t) * (1 - t);
+        case Motion::Easing::InOutQuad:
+            return t < 0.5 ? 2 * t * t : 1 - 2 * (1 - t) * (1 - t);
+        case Motion::Easing::InCubic:
+            return t * t * t;
+        case Motion::Easing::OutCubic:
+            return 1 - (1 - t) * (1 - t) * (1 - t);
+        case Motion::Easing::InOutCubic:
+            return t < 0.5 ? 4 * t * t * t : 1 - 4 * (1 - t) * (1 - t) * (1 - t);
+        case Motion::Easing::OutBack: {
+            constexpr double Overshoot = 1.70158;
+            double u = t - 1;
+            return 1 + (Overshoot + 1) * u * u * u + Overshoot * u * u;
+        }
+        case Motion::Easing::OutBounce: {
+            constexpr double Scale = 7.5625, Width = 2.75;
+            if (t < 1 / Width)
+                return Scale * t * t;
+            if (t < 2 / Width) {
+                t -= 1.5 / Width;
+                return Scale * t * t + 0.75;
+            }
+            if (t < 2.5 / Width) {
+                t -= 2.25 / Width;
+                return Scale * t * t + 0.9375;
+            }
+            t -= 2.625 / Width;
+            return Scale * t * t + 0.984375;
+        }
+        default:
+            return t;
+    }
+}
+
+static constexpr auto MakeEasingTables() {
+    std::array<std::array<int16_t, Motion::EasingTableSize>, Motion::EasingCount> tables = {};
+    for (size_t easing = 0; easing < Motion::EasingCount; ++easing) {
+        for (size_t index = 0; index < Motion::EasingTableSize; ++index) {
+            double value = Curve(static_cast<Motion::Easing>(easing), index / double(Motion::EasingTableSize - 1));
+            double scaled = value * (1 << Motion::EasedBits);
+            tables[easing][index] = static_cast<int16_t>(scaled < 0 ? scaled - 0.5 : scaled + 0.5);
+        }
+    }
+    return tables;
+}
+
+constinit const std::array<std::array<int16_t, Motion::EasingTableSize>, Motion::EasingCount> Motion::EasingTables = MakeEasingTables();
+
+} // namespace evms
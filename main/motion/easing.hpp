@@ -0,0 +1,44 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace evms {
+
+namespace Motion {
+    enum class Easing : uint8_t {
+        Linear,
+        InQuad,
+        OutQuad,
+        InOutQuad,
+        InCubic,
+        OutCubic,
+        InOutCubic,
+        OutBack,        // Overshoots by ~10% before settling
+        OutBounce,
+    };
+    constexpr size_t EasingCount = static_cast<size_t>(Easing::OutBounce) + 1;
+
+    // Progress is Q16 (65536 is done), eased values are Q14 (16384 is the end value)
+    constexpr int ProgressBits = 16;
+    constexpr int EasedBits = 14;
+
+    // Curves sampled at 256 even steps plus the end point, interpolated linearly in between
+    constexpr size_t EasingTableSize = 257;
+    extern const std::array<std::array<int16_t, EasingTableSize>, EasingCount> EasingTables;
+
+    // Eased progress in Q14, may leave [0, 16384] for overshooting curves
+    inline int32_t Ease(Easing easing, uint32_t progress) {
+        if (progress >= (1u << ProgressBits))
+            return 1 << EasedBits;
+
+        const std::array<int16_t, EasingTableSize>& table = EasingTables[static_cast<size_t>(easing)];
+        uint32_t index = progress >> 8;
+        int32_t fraction = progress & 0xFF;
+        int32_t start = table[index];
+        return start + (((table[index + 1] - start) * fraction) >> 8);
+    }
+}
+
+} // namespace evms
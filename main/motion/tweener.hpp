@@ -0,0 +1,161 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "display/dirty_regions.hpp"
+#include "display/types.hpp"
+#include "motion/easing.hpp"
+
+namespace evms {
+
+namespace Motion {
+    /*
+    *   Fixed-capacity set of tweens advanced together once per frame tick. Tween state
+    *   is kept as structure of arrays and advance() is one pass over it in fixed point:
+    *   a multiply for progress, an easing table lookup and a multiply for the value.
+    *   Values are polled (value(), position(), color()) by whatever they drive: widget
+    *   positions, colors, PWM duty, scroll offsets. Position tweens given a size report
+    *   the rects they vacate and enter, so moved content can be redrawn and sent.
+    *   Ids stay valid until their tween finishes or is stopped, a reused slot gets a new id.
+    */
+    template <size_t Capacity>
+    class Tweener {
+    public:
+        // Negative if the tweener was full
+        using Id = int32_t;
+
+        // Completion callback, gets the context it was started with
+        using Callback = void (*)(void* context);
+
+        enum class Repeat : uint8_t {
+            Once,
+            Loop,       // Jumps back to the start value
+            PingPong,   // Runs back and forth
+        };
+
+    private:
+        enum class Kind : uint8_t {
+            Scalar,
+            Position,
+            Color,
+        };
+
+        static_assert(Capacity <= 0xFFFF, "Ids hold the slot in 16 bits");
+
+    private:
+        // Slots up to m_end may be in use
+        size_t m_end = 0;
+        size_t m_active = 0;
+
+        std::array<bool, Capacity> m_used = {};
+        std::array<uint16_t, Capacity> m_generation = {};
+        std::array<Kind, Capacity> m_kind = {};
+        std::array<Easing, Capacity> m_easing = {};
+        std::array<Repeat, Capacity> m_repeat = {};
+
+        // Times in microseconds, inverse duration is 2^32 / duration
+        std::array<uint32_t, Capacity> m_elapsed = {};
+        std::array<uint32_t, Capacity> m_duration = {};
+        std::array<uint32_t, Capacity> m_inverseDuration = {};
+
+        // Second components are only used by positions. Colors keep both ends in from, RGB565 in panel byte order.
+        std::array<int32_t, Capacity> m_fromA = {};
+        std::array<int32_t, Capacity> m_fromB = {};
+        std::array<int32_t, Capacity> m_deltaA = {};
+        std::array<int32_t, Capacity> m_deltaB = {};
+        std::array<int32_t, Capacity> m_valueA = {};
+        std::array<int32_t, Capacity> m_valueB = {};
+
+        // Size of the content a position tween moves, empty if it reports no dirty rects
+        std::array<Display::Dimensions2D, Capacity> m_size = {};
+
+        std::array<Callback, Capacity> m_onComplete = {};
+        std::array<void*, Capacity> m_onCompleteContext = {};
+
+    private:
+        Id add(Kind kind, int32_t fromA, int32_t fromB, int32_t toA, int32_t toB, uint32_t durationMicroseconds,
+            Easing easing, Repeat repeat, Callback onComplete, void* context);
+
+        int slot(Id id) const;
+
+        void free(size_t index);
+
+        // Value of the tween at index for eased progress in Q14
+        void evaluate(size_t index, int32_t eased);
+
+        // Swap start and end, for ping-pong
+        void flip(size_t index);
+
+        template <typename DirtyCallback>
+        void step(uint32_t microseconds, DirtyCallback&& dirty);
+
+    public:
+        Tweener() = default;
+
+        // Completion contexts may point into the owner
+        Tweener(const Tweener& other) = delete;
+
+    public:
+        Tweener& operator=(const Tweener& other) = delete;
+
+    public:
+        Id tween(int from, int to, uint32_t durationMicroseconds, Easing easing = Easing::Linear,
+            Repeat repeat = Repeat::Once, Callback onComplete = nullptr, void* context = nullptr);
+
+        // Content of size at the position, empty size doesn't report dirty rects
+        Id tweenPosition(Display::Position from, Display::Position to, Display::Dimensions2D size, uint32_t durationMicroseconds,
+            Easing easing = Easing::Linear, Repeat repeat = Repeat::Once, Callback onComplete = nullptr, void* context = nullptr);
+
+        // Channels are blended separately and clamped, so overshooting curves don't wrap around
+        Id tweenColor(uint16_t from, uint16_t to, uint32_t durationMicroseconds, Easing easing = Easing::Linear,
+            Repeat repeat = Repeat::Once, Callback onComplete = nullptr, void* context = nullptr);
+
+        // Returns false if id isn't active. With complete, jumps to the end value and runs the callback.
+        bool stop(Id id, bool complete = false);
+
+        // Stops everything without running callbacks
+        void clear();
+
+        // Move every tween forward. Completion callbacks run afterwards and may start new tweens.
+        void advance(uint32_t microseconds);
+
+        // Rects that moving position tweens vacated and entered are added to dirty
+        template <size_t DirtyCapacity>
+        void advance(uint32_t microseconds, Display::DirtyRegions<DirtyCapacity>& dirty) {
+            step(microseconds, [&dirty](const Display::Rect& rect) {
+                dirty.add(rect);
+            });
+        }
+
+    public:
+        inline bool active(Id id) const {
+            return slot(id) >= 0;
+        }
+
+        // Current values, zero (or { -1, -1 }) for ids that aren't active
+        inline int value(Id id) const {
+            int index = slot(id);
+            return index < 0 ? 0 : m_valueA[index];
+        }
+
+        inline Display::Position position(Id id) const {
+            int index = slot(id);
+            return index < 0 ? Display::Position{ -1, -1 } : Display::Position{ m_valueA[index], m_valueB[index] };
+        }
+
+        inline uint16_t color(Id id) const {
+            int index = slot(id);
+            return index < 0 ? 0 : static_cast<uint16_t>(m_valueA[index]);
+        }
+
+        inline size_t size() const {
+            return m_active;
+        }
+    };
+}
+
+} // namespace evms
+
+#include "tweener.inl"
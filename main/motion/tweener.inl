@@ -0,0 +1,205 @@
+#include <algorithm>
+#include <utility>
+
+namespace evms {
+
+namespace Motion {
+    template <size_t Capacity>
+    typename Tweener<Capacity>::Id Tweener<Capacity>::add(Kind kind, int32_t fromA, int32_t fromB, int32_t toA, int32_t toB,
+        uint32_t durationMicroseconds, Easing easing, Repeat repeat, Callback onComplete, void* context) {
+        size_t index = 0;
+        while (index < m_end && m_used[index])
+            ++index;
+        if (index == Capacity) {
+            // Tweener is full!
+            return -1;
+        }
+        m_end = std::max(m_end, index + 1);
+        ++m_active;
+
+        m_used[index] = true;
+        m_kind[index] = kind;
+        m_easing[index] = easing;
+        m_repeat[index] = repeat;
+        m_elapsed[index] = 0;
+        m_duration[index] = std::max<uint32_t>(durationMicroseconds, 1);
+        // Rounded up, so progress doesn't fall short of the exact ratio
+        uint64_t divisor = std::max<uint32_t>(durationMicroseconds, 2);
+        m_inverseDuration[index] = static_cast<uint32_t>(((uint64_t(1) << 32) + divisor - 1) / divisor);
+        m_fromA[index] = fromA;
+        m_fromB[index] = fromB;
+        m_deltaA[index] = toA - fromA;
+        m_deltaB[index] = toB - fromB;
+        m_size[index] = {};
+        m_onComplete[index] = onComplete;
+        m_onCompleteContext[index] = context;
+        evaluate(index, 0);
+        return (static_cast<Id>(m_generation[index]) << 16) | static_cast<Id>(index);
+    }
+
+    template <size_t Capacity>
+    int Tweener<Capacity>::slot(Id id) const {
+        if (id < 0)
+            return -1;
+        size_t index = id & 0xFFFF;
+        if (index >= m_end || !m_used[index] || m_generation[index] != (id >> 16))
+            return -1;
+        return static_cast<int>(index);
+    }
+
+    template <size_t Capacity>
+    void Tweener<Capacity>::free(size_t index) {
+        m_used[index] = false;
+        m_generation[index] = (m_generation[index] + 1) & 0x7FFF;
+        m_onComplete[index] = nullptr;
+        m_onCompleteContext[index] = nullptr;
+        --m_active;
+        while (m_end > 0 && !m_used[m_end - 1])
+            --m_end;
+    }
+
+    template <size_t Capacity>
+    void Tweener<Capacity>::evaluate(size_t index, int32_t eased) {
+        if (m_kind[index] != Kind::Color) {
+            m_valueA[index] = m_fromA[index] + static_cast<int32_t>((int64_t(m_deltaA[index]) * eased) >> EasedBits);
+            m_valueB[index] = m_fromB[index] + static_cast<int32_t>((int64_t(m_deltaB[index]) * eased) >> EasedBits);
+            return;
+        }
+
+        // Blend in native RGB565, channel by channel
+        uint16_t from = static_cast<uint16_t>(m_fromA[index]), to = static_cast<uint16_t>(m_fromB[index]);
+        from = static_cast<uint16_t>((from >> 8) | (from << 8));
+        to = static_cast<uint16_t>((to >> 8) | (to << 8));
+        auto blend = [eased](int from, int to, int maximum) {
+            return std::clamp(from + (((to - from) * eased) >> EasedBits), 0, maximum);
+        };
+        int red = blend(from >> 11, to >> 11, 31);
+        int green = blend((from >> 5) & 0x3F, (to >> 5) & 0x3F, 63);
+        int blue = blend(from & 0x1F, to & 0x1F, 31);
+        uint16_t color = static_cast<uint16_t>((red << 11) | (green << 5) | blue);
+        m_valueA[index] = static_cast<uint16_t>((color >> 8) | (color << 8));
+    }
+
+    template <size_t Capacity>
+    void Tweener<Capacity>::flip(size_t index) {
+        if (m_kind[index] == Kind::Color) {
+            std::swap(m_fromA[index], m_fromB[index]);
+            return;
+        }
+        m_fromA[index] += m_deltaA[index];
+        m_fromB[index] += m_deltaB[index];
+        m_deltaA[index] = -m_deltaA[index];
+        m_deltaB[index] = -m_deltaB[index];
+    }
+
+    template <size_t Capacity>
+    template <typename DirtyCallback>
+    void Tweener<Capacity>::step(uint32_t microseconds, DirtyCallback&& dirty) {
+        bool anyFinished = false;
+
+        for (size_t index = 0; index < m_end; ++index) {
+            if (!m_used[index])
+                continue;
+
+            uint32_t duration = m_duration[index];
+            uint64_t elapsed = uint64_t(m_elapsed[index]) + microseconds;
+            int32_t eased = 1 << EasedBits;
+            if (elapsed >= duration) {
+                if (m_repeat[index] == Repeat::Once) {
+                    elapsed = duration;
+                    anyFinished = true;
+                }
+                else {
+                    if (m_repeat[index] == Repeat::PingPong && (elapsed / duration) % 2)
+                        flip(index);
+                    elapsed %= duration;
+                }
+            }
+            if (elapsed < duration)
+                eased = Ease(m_easing[index], static_cast<uint32_t>((elapsed * m_inverseDuration[index]) >> 16));
+            m_elapsed[index] = static_cast<uint32_t>(elapsed);
+
+            int32_t previousA = m_valueA[index], previousB = m_valueB[index];
+            evaluate(index, eased);
+
+            // Old and new place of moved content
+            const Display::Dimensions2D& size = m_size[index];
+            if (size.width > 0 && (m_valueA[index] != previousA || m_valueB[index] != previousB)) {
+                dirty(Display::Rect{ previousA, previousB, size.width, size.height });
+                dirty(Display::Rect{ m_valueA[index], m_valueB[index], size.width, size.height });
+            }
+        }
+
+        if (!anyFinished)
+            return;
+
+        /*
+        *   Finished tweens are the ones that ran once to their end, tweens started since have
+        *   no time elapsed. Each slot is free before its callback runs, so callbacks can start
+        *   new tweens right away and stop ones that haven't been reported yet.
+        */
+        for (size_t index = 0; index < m_end; ++index) {
+            if (!m_used[index] || m_repeat[index] != Repeat::Once || m_elapsed[index] < m_duration[index])
+                continue;
+
+            Callback onComplete = m_onComplete[index];
+            void* context = m_onCompleteContext[index];
+            free(index);
+            if (onComplete)
+                onComplete(context);
+        }
+    }
+
+    template <size_t Capacity>
+    typename Tweener<Capacity>::Id Tweener<Capacity>::tween(int from, int to, uint32_t durationMicroseconds,
+        Easing easing, Repeat repeat, Callback onComplete, void* context) {
+        return add(Kind::Scalar, from, 0, to, 0, durationMicroseconds, easing, repeat, onComplete, context);
+    }
+
+    template <size_t Capacity>
+    typename Tweener<Capacity>::Id Tweener<Capacity>::tweenPosition(Display::Position from, Display::Position to, Display::Dimensions2D size,
+        uint32_t durationMicroseconds, Easing easing, Repeat repeat, Callback onComplete, void* context) {
+        Id id = add(Kind::Position, from.x, from.y, to.x, to.y, durationMicroseconds, easing, repeat, onComplete, context);
+        if (id >= 0)
+            m_size[id & 0xFFFF] = size;
+        return id;
+    }
+
+    template <size_t Capacity>
+    typename Tweener<Capacity>::Id Tweener<Capacity>::tweenColor(uint16_t from, uint16_t to, uint32_t durationMicroseconds,
+        Easing easing, Repeat repeat, Callback onComplete, void* context) {
+        return add(Kind::Color, from, to, from, to, durationMicroseconds, easing, repeat, onComplete, context);
+    }
+
+    template <size_t Capacity>
+    bool Tweener<Capacity>::stop(Id id, bool complete) {
+        int index = slot(id);
+        if (index < 0)
+            return false;
+
+        Callback onComplete = m_onComplete[index];
+        void* context = m_onCompleteContext[index];
+        if (complete)
+            evaluate(index, 1 << EasedBits);
+        free(index);
+        if (complete && onComplete)
+            onComplete(context);
+        return true;
+    }
+
+    template <size_t Capacity>
+    void Tweener<Capacity>::clear() {
+        for (size_t index = 0; index < m_end; ++index) {
+            if (m_used[index])
+                free(index);
+        }
+        m_end = 0;
+    }
+
+    template <size_t Capacity>
+    void Tweener<Capacity>::advance(uint32_t microseconds) {
+        step(microseconds, [](const Display::Rect&) {});
+    }
+}
+
+} // namespace evms
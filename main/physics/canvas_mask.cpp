@@ -0,0 +1,22 @@
+#include "canvas_mask.hpp"
+
+namespace evms {
+
+bool Physics::Painted(Display::PixelView canvas, const Display::Rect& area) {
+    Display::PixelView region = canvas.subview(area.x, area.y, area.dimensions());
+    if (!region)
+        return false;
+
+    // OR the whole row together and test once, rows are short and mostly empty
+    for (int row = 0; row < region.height(); ++row) {
+        const uint16_t* pixels = region.row(row);
+        uint16_t painted = 0;
+        for (int column = 0; column < region.width(); ++column)
+            painted |= pixels[column];
+        if (painted)
+            return true;
+    }
+    return false;
+}
+
+} // namespace evms
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "display/types.hpp"
+
+namespace evms {
+
+namespace Physics {
+    // Check if any pixel inside area (clipped to canvas) is painted, i.e. non-zero
+    bool Painted(Display::PixelView canvas, const Display::Rect& area);
+}
+
+} // namespace evms
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <algorithm>
+#include <span>
+
+#include "display/types.hpp"
+
+namespace evms {
+
+namespace Physics {
+    /*
+    *   Uniform grid over Bounds, rebuilt from scratch every step with a counting sort.
+    *   A body is stored in every cell it overlaps. Bodies spanning more than MaxCellsPerBody
+    *   cells are kept in a separate list instead, they are expected to be few.
+    */
+    template <size_t Capacity, Display::Dimensions2D Bounds, int CellSize = 16>
+    class SpatialHash {
+    public:
+        static constexpr int Columns = (Bounds.width + CellSize - 1) / CellSize;
+        static constexpr int Rows = (Bounds.height + CellSize - 1) / CellSize;
+        static constexpr int MaxCellsPerBody = 4;
+
+    private:
+        std::array<uint32_t, Columns * Rows + 1> m_cellStarts = {};
+        std::array<uint16_t, Capacity * MaxCellsPerBody> m_entries = {};
+        std::array<uint16_t, Capacity> m_large = {};
+        size_t m_largeCount = 0;
+        std::array<bool, Capacity> m_isLarge = {};
+
+    private:
+        static inline int CellColumn(int x) {
+            return std::clamp(x / CellSize, 0, Columns - 1);
+        }
+
+        static inline int CellRow(int y) {
+            return std::clamp(y / CellSize, 0, Rows - 1);
+        }
+
+    public:
+        // Bounds are given as arrays of x, y, width and height
+        void build(size_t count, const int16_t* x, const int16_t* y, const int16_t* width, const int16_t* height);
+
+        // Call callback(first, second) once for every pair of bodies with intersecting bounds
+        template <typename Callback>
+        void forEachPair(size_t count, const int16_t* x, const int16_t* y, const int16_t* width, const int16_t* height, Callback&& callback) const;
+
+    public:
+        static inline int CellOf(int x, int y) {
+            return CellRow(y) * Columns + CellColumn(x);
+        }
+
+        inline std::span<const uint16_t> cell(int index) const {
+            return { m_entries.data() + m_cellStarts[index], m_entries.data() + m_cellStarts[index + 1] };
+        }
+
+        inline std::span<const uint16_t> large() const {
+            return { m_large.data(), m_largeCount };
+        }
+    };
+}
+
+} // namespace evms
+
+#include "spatial_hash.inl"
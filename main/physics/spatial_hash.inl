@@ -0,0 +1,82 @@
+namespace evms {
+
+namespace Physics {
+    template <size_t Capacity, Display::Dimensions2D Bounds, int CellSize>
+    void SpatialHash<Capacity, Bounds, CellSize>::build(size_t count, const int16_t* x, const int16_t* y, const int16_t* width, const int16_t* height) {
+        m_cellStarts.fill(0);
+        m_largeCount = 0;
+        std::fill_n(m_isLarge.begin(), count, false);
+
+        // Count entries per cell, shifted by one so the prefix sum yields start offsets
+        for (size_t body = 0; body < count; ++body) {
+            int columnStart = CellColumn(x[body]), columnEnd = CellColumn(x[body] + width[body] - 1);
+            int rowStart = CellRow(y[body]), rowEnd = CellRow(y[body] + height[body] - 1);
+            if ((columnEnd - columnStart + 1) * (rowEnd - rowStart + 1) > MaxCellsPerBody) {
+                m_large[m_largeCount++] = static_cast<uint16_t>(body);
+                m_isLarge[body] = true;
+                continue;
+            }
+
+            for (int row = rowStart; row <= rowEnd; ++row) {
+                for (int column = columnStart; column <= columnEnd; ++column)
+                    ++m_cellStarts[row * Columns + column + 1];
+            }
+        }
+
+        for (size_t cell = 1; cell < m_cellStarts.size(); ++cell)
+            m_cellStarts[cell] += m_cellStarts[cell - 1];
+
+        // Fill using the start of the next cell as a running cursor, then shift back
+        std::array<uint32_t, Columns * Rows> cursors;
+        std::copy(m_cellStarts.begin(), m_cellStarts.end() - 1, cursors.begin());
+        for (size_t body = 0; body < count; ++body) {
+            if (m_isLarge[body])
+                continue;
+
+            int columnStart = CellColumn(x[body]), columnEnd = CellColumn(x[body] + width[body] - 1);
+            int rowStart = CellRow(y[body]), rowEnd = CellRow(y[body] + height[body] - 1);
+            for (int row = rowStart; row <= rowEnd; ++row) {
+                for (int column = columnStart; column <= columnEnd; ++column)
+                    m_entries[cursors[row * Columns + column]++] = static_cast<uint16_t>(body);
+            }
+        }
+    }
+
+    template <size_t Capacity, Display::Dimensions2D Bounds, int CellSize>
+    template <typename Callback>
+    void SpatialHash<Capacity, Bounds, CellSize>::forEachPair(size_t count, const int16_t* x, const int16_t* y, const int16_t* width, const int16_t* height, Callback&& callback) const {
+        auto intersects = [&](int first, int second) {
+            return (
+                x[first] < x[second] + width[second] && x[second] < x[first] + width[first] &&
+                y[first] < y[second] + height[second] && y[second] < y[first] + height[first]
+            );
+        };
+
+        for (int index = 0; index < Columns * Rows; ++index) {
+            std::span<const uint16_t> bodies = cell(index);
+            for (size_t first = 0; first < bodies.size(); ++first) {
+                for (size_t second = first + 1; second < bodies.size(); ++second) {
+                    int a = bodies[first], b = bodies[second];
+                    if (!intersects(a, b))
+                        continue;
+
+                    // A pair sharing several cells is reported only by the cell holding the top-left of their intersection
+                    if (CellOf(std::max(x[a], x[b]), std::max(y[a], y[b])) == index)
+                        callback(a, b);
+                }
+            }
+        }
+
+        // Large bodies are tested against everything, large pairs only once
+        for (int a : large()) {
+            for (int b = 0; b < static_cast<int>(count); ++b) {
+                if (b == a || (m_isLarge[b] && b < a))
+                    continue;
+                if (intersects(a, b))
+                    callback(a, b);
+            }
+        }
+    }
+}
+
+} // namespace evms
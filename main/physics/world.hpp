@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <span>
+
+#include "display/types.hpp"
+#include "physics/spatial_hash.hpp"
+
+namespace evms {
+
+namespace Physics {
+    struct Event {
+        enum class Type {
+            Border,     // Body bounced off one screen border
+            Corner,     // Body bounced off two screen borders at once
+            Canvas,     // Body bounced off painted canvas content
+            Body,       // Two bodies collided
+        };
+
+        Type type;
+        uint16_t body;
+        uint16_t other;     // Only meaningful for Body events
+    };
+
+    /*
+    *   Axis-aligned bodies with integer velocity (pixels per step) bouncing inside Bounds.
+    *   Body state is kept as structure of arrays, every step runs batch passes over it:
+    *   borders, canvas probing, integration and then body pairs from the spatial hash.
+    *   CellSize of the hash should be about the size of typical bodies: smaller cells put
+    *   fewer bodies in each, but bodies spanning more than four are tested against all.
+    */
+    template <size_t Capacity, Display::Dimensions2D Bounds, size_t EventCapacity = 256, int CellSize = 16>
+    class World {
+    private:
+        enum Hit : uint8_t {
+            HorizontalBorder = 1 << 0,
+            VerticalBorder = 1 << 1,
+            CanvasHit = 1 << 2,
+        };
+
+    private:
+        size_t m_size = 0;
+        std::array<int16_t, Capacity> m_x = {};
+        std::array<int16_t, Capacity> m_y = {};
+        std::array<int16_t, Capacity> m_width = {};
+        std::array<int16_t, Capacity> m_height = {};
+        std::array<int16_t, Capacity> m_xVelocity = {};
+        std::array<int16_t, Capacity> m_yVelocity = {};
+        std::array<uint8_t, Capacity> m_hits = {};
+
+        SpatialHash<Capacity, Bounds, CellSize> m_grid;
+        bool m_bodyCollisions = true;
+
+        std::array<Event, EventCapacity> m_events = {};
+        size_t m_eventCount = 0;
+        size_t m_droppedEvents = 0;
+
+    private:
+        void pushEvent(Event::Type type, int body, int other = 0);
+
+        void collideBorders();
+
+        void collideCanvas(Display::PixelView canvas);
+
+        void integrate();
+
+        void collideBodies();
+
+    public:
+        // Returns body index or -1 if world is full
+        int add(const Display::Rect& bounds, Display::Position velocity);
+
+        // Index of the last body is reused for the removed one
+        void remove(int index);
+
+        void setBodyCollisions(bool enabled);
+
+        // Run one step. Canvas (if given) is probed for painted pixels along leading edges.
+        void step(Display::PixelView canvas = {});
+
+    public:
+        inline size_t size() const {
+            return m_size;
+        }
+
+        inline Display::Rect bounds(int index) const {
+            return { m_x[index], m_y[index], m_width[index], m_height[index] };
+        }
+
+        inline Display::Position velocity(int index) const {
+            return { m_xVelocity[index], m_yVelocity[index] };
+        }
+
+        // Events produced by the last step
+        inline std::span<const Event> events() const {
+            return { m_events.data(), m_eventCount };
+        }
+
+        // Events that didn't fit into EventCapacity during the last step
+        inline size_t droppedEvents() const {
+            return m_droppedEvents;
+        }
+    };
+}
+
+} // namespace evms
+
+#include "world.inl"
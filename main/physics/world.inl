@@ -0,0 +1,164 @@
+#include <cstdlib>
+
+#include "physics/canvas_mask.hpp"
+
+namespace evms {
+
+namespace Physics {
+    template <size_t Capacity, Display::Dimensions2D Bounds, size_t EventCapacity, int CellSize>
+    void World<Capacity, Bounds, EventCapacity, CellSize>::pushEvent(Event::Type type, int body, int other) {
+        if (m_eventCount == EventCapacity) {
+            ++m_droppedEvents;
+            return;
+        }
+        m_events[m_eventCount++] = { type, static_cast<uint16_t>(body), static_cast<uint16_t>(other) };
+    }
+
+    template <size_t Capacity, Display::Dimensions2D Bounds, size_t EventCapacity, int CellSize>
+    int World<Capacity, Bounds, EventCapacity, CellSize>::add(const Display::Rect& bounds, Display::Position velocity) {
+        if (m_size == Capacity) {
+            // World is full!
+            return -1;
+        }
+
+        size_t index = m_size++;
+        m_x[index] = static_cast<int16_t>(bounds.x);
+        m_y[index] = static_cast<int16_t>(bounds.y);
+        m_width[index] = static_cast<int16_t>(bounds.width);
+        m_height[index] = static_cast<int16_t>(bounds.height);
+        m_xVelocity[index] = static_cast<int16_t>(velocity.x);
+        m_yVelocity[index] = static_cast<int16_t>(velocity.y);
+        m_hits[index] = 0;
+        return static_cast<int>(index);
+    }
+
+    template <size_t Capacity, Display::Dimensions2D Bounds, size_t EventCapacity, int CellSize>
+    void World<Capacity, Bounds, EventCapacity, CellSize>::remove(int index) {
+        if (index < 0 || static_cast<size_t>(index) >= m_size)
+            return;
+
+        size_t last = --m_size;
+        m_x[index] = m_x[last];
+        m_y[index] = m_y[last];
+        m_width[index] = m_width[last];
+        m_height[index] = m_height[last];
+        m_xVelocity[index] = m_xVelocity[last];
+        m_yVelocity[index] = m_yVelocity[last];
+        m_hits[index] = m_hits[last];
+    }
+
+    template <size_t Capacity, Display::Dimensions2D Bounds, size_t EventCapacity, int CellSize>
+    void World<Capacity, Bounds, EventCapacity, CellSize>::setBodyCollisions(bool enabled) {
+        m_bodyCollisions = enabled;
+    }
+
+    template <size_t Capacity, Display::Dimensions2D Bounds, size_t EventCapacity, int CellSize>
+    void World<Capacity, Bounds, EventCapacity, CellSize>::collideBorders() {
+        for (size_t body = 0; body < m_size; ++body) {
+            uint8_t hits = 0;
+            int16_t xSpeed = static_cast<int16_t>(std::abs(m_xVelocity[body]));
+            if (m_x[body] <= 0) {
+                m_xVelocity[body] = xSpeed;
+                hits |= HorizontalBorder;
+            }
+            else if (m_x[body] + m_width[body] >= Bounds.width) {
+                m_xVelocity[body] = -xSpeed;
+                hits |= HorizontalBorder;
+            }
+
+            int16_t ySpeed = static_cast<int16_t>(std::abs(m_yVelocity[body]));
+            if (m_y[body] <= 0) {
+                m_yVelocity[body] = ySpeed;
+                hits |= VerticalBorder;
+            }
+            else if (m_y[body] + m_height[body] >= Bounds.height) {
+                m_yVelocity[body] = -ySpeed;
+                hits |= VerticalBorder;
+            }
+            m_hits[body] = hits;
+        }
+    }
+
+    template <size_t Capacity, Display::Dimensions2D Bounds, size_t EventCapacity, int CellSize>
+    void World<Capacity, Bounds, EventCapacity, CellSize>::collideCanvas(Display::PixelView canvas) {
+        for (size_t body = 0; body < m_size; ++body) {
+            // Probe the column and the row the body is about to move into
+            if (m_xVelocity[body] != 0) {
+                int column = m_xVelocity[body] < 0 ? m_x[body] - 1 : m_x[body] + m_width[body];
+                if (Painted(canvas, { column, m_y[body], 1, m_height[body] })) {
+                    m_xVelocity[body] = -m_xVelocity[body];
+                    m_hits[body] |= CanvasHit;
+                }
+            }
+
+            if (m_yVelocity[body] != 0) {
+                int row = m_yVelocity[body] < 0 ? m_y[body] - 1 : m_y[body] + m_height[body];
+                if (Painted(canvas, { m_x[body], row, m_width[body], 1 })) {
+                    m_yVelocity[body] = -m_yVelocity[body];
+                    m_hits[body] |= CanvasHit;
+                }
+            }
+        }
+    }
+
+    template <size_t Capacity, Display::Dimensions2D Bounds, size_t EventCapacity, int CellSize>
+    void World<Capacity, Bounds, EventCapacity, CellSize>::integrate() {
+        for (size_t body = 0; body < m_size; ++body)
+            m_x[body] += m_xVelocity[body];
+        for (size_t body = 0; body < m_size; ++body)
+            m_y[body] += m_yVelocity[body];
+    }
+
+    template <size_t Capacity, Display::Dimensions2D Bounds, size_t EventCapacity, int CellSize>
+    void World<Capacity, Bounds, EventCapacity, CellSize>::collideBodies() {
+        m_grid.build(m_size, m_x.data(), m_y.data(), m_width.data(), m_height.data());
+        m_grid.forEachPair(m_size, m_x.data(), m_y.data(), m_width.data(), m_height.data(), [this](int a, int b) {
+            int xOverlap = std::min(m_x[a] + m_width[a], m_x[b] + m_width[b]) - std::max(m_x[a], m_x[b]);
+            int yOverlap = std::min(m_y[a] + m_height[a], m_y[b] + m_height[b]) - std::max(m_y[a], m_y[b]);
+
+            // Equal masses: exchange velocities along the axis of least penetration if bodies approach.
+            // Bodies that keep overlapping while moving apart (or resting) don't collide again.
+            bool approaching;
+            if (xOverlap <= yOverlap) {
+                int direction = m_x[a] < m_x[b] ? 1 : -1;
+                approaching = (m_xVelocity[a] - m_xVelocity[b]) * direction > 0;
+                if (approaching)
+                    std::swap(m_xVelocity[a], m_xVelocity[b]);
+            }
+            else {
+                int direction = m_y[a] < m_y[b] ? 1 : -1;
+                approaching = (m_yVelocity[a] - m_yVelocity[b]) * direction > 0;
+                if (approaching)
+                    std::swap(m_yVelocity[a], m_yVelocity[b]);
+            }
+            if (approaching)
+                pushEvent(Event::Type::Body, a, b);
+        });
+    }
+
+    template <size_t Capacity, Display::Dimensions2D Bounds, size_t EventCapacity, int CellSize>
+    void World<Capacity, Bounds, EventCapacity, CellSize>::step(Display::PixelView canvas) {
+        m_eventCount = 0;
+        m_droppedEvents = 0;
+
+        collideBorders();
+        if (canvas)
+            collideCanvas(canvas);
+
+        for (size_t body = 0; body < m_size; ++body) {
+            uint8_t hits = m_hits[body];
+            if ((hits & HorizontalBorder) && (hits & VerticalBorder))
+                pushEvent(Event::Type::Corner, static_cast<int>(body));
+            else if (hits & (HorizontalBorder | VerticalBorder))
+                pushEvent(Event::Type::Border, static_cast<int>(body));
+            else if (hits & CanvasHit)
+                pushEvent(Event::Type::Canvas, static_cast<int>(body));
+        }
+
+        integrate();
+        if (m_bodyCollisions && m_size > 1)
+            collideBodies();
+    }
+}
+
+} // namespace evms
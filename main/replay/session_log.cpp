@@ -0,0 +1,130 @@
+#include "session_log.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
+namespace evms {
+
+static constexpr size_t BytesPerDumpLine = 32;
+
+static int HexValue(char character) {
+    if (character >= '0' && character <= '9')
+        return character - '0';
+    if (character >= 'a' && character <= 'f')
+        return character - 'a' + 10;
+    if (character >= 'A' && character <= 'F')
+        return character - 'A' + 10;
+    return -1;
+}
+
+Replay::Recorder::Recorder(uint32_t seed, size_t capacity)
+    : m_capacity(capacity) {
+    uint8_t header[LogHeaderSize] = {
+        uint8_t(LogMagic[0]), uint8_t(LogMagic[1]), uint8_t(LogMagic[2]), uint8_t(LogMagic[3]),
+        LogVersion, 0, 0, 0,
+        uint8_t(seed), uint8_t(seed >> 8), uint8_t(seed >> 16), uint8_t(seed >> 24)
+    };
+    m_bytes.reserve(std::max(capacity, LogHeaderSize));
+    m_bytes.assign(header, header + LogHeaderSize);
+}
+
+bool Replay::Recorder::frame(int64_t timeMicroseconds, Display::Position touch) {
+    // Longest record: 10 byte varint and a position
+    if (m_bytes.size() + 14 > m_capacity)
+        return false;
+
+    bool touched = touch.x >= 0 && touch.y >= 0;
+    uint64_t delta = m_lastTime < 0 ? 0 : static_cast<uint64_t>(timeMicroseconds - m_lastTime);
+    m_lastTime = timeMicroseconds;
+
+    uint64_t value = (delta << 1) | touched;
+    do {
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        m_bytes.push_back(value ? (byte | 0x80) : byte);
+    } while (value);
+
+    if (touched) {
+        m_bytes.insert(m_bytes.end(), {
+            static_cast<uint8_t>(touch.x), static_cast<uint8_t>(touch.x >> 8),
+            static_cast<uint8_t>(touch.y), static_cast<uint8_t>(touch.y >> 8)
+        });
+    }
+    ++m_frames;
+    return true;
+}
+
+void Replay::Recorder::dump(std::ostream& stream) const {
+    static constexpr char Digits[] = "0123456789abcdef";
+    for (size_t offset = 0; offset < m_bytes.size(); offset += BytesPerDumpLine) {
+        stream << DumpPrefix;
+        for (size_t index = offset; index < m_bytes.size() && index < offset + BytesPerDumpLine; ++index)
+            stream << Digits[m_bytes[index] >> 4] << Digits[m_bytes[index] & 0x0F];
+        stream << '\n';
+    }
+    stream.flush();
+}
+
+Replay::Reader::Reader(std::span<const uint8_t> bytes) {
+    if (bytes.size() < LogHeaderSize || std::memcmp(bytes.data(), LogMagic, sizeof(LogMagic)) != 0 || bytes[4] != LogVersion)
+        return;
+
+    m_bytes = bytes;
+    m_seed = bytes[8] | (bytes[9] << 8) | (bytes[10] << 16) | (uint32_t(bytes[11]) << 24);
+}
+
+bool Replay::Reader::next(FrameSample& sample) {
+    uint64_t value = 0;
+    for (int shift = 0;; shift += 7) {
+        if (m_position >= m_bytes.size() || shift > 63)
+            return false;
+        uint8_t byte = m_bytes[m_position++];
+        value |= uint64_t(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            break;
+    }
+
+    m_time += static_cast<int64_t>(value >> 1);
+    sample.timeMicroseconds = m_time;
+    sample.touch = { -1, -1 };
+    if (value & 1) {
+        if (m_bytes.size() - m_position < 4)
+            return false;
+        const uint8_t* position = m_bytes.data() + m_position;
+        sample.touch = { int16_t(position[0] | (position[1] << 8)), int16_t(position[2] | (position[3] << 8)) };
+        m_position += 4;
+    }
+    return true;
+}
+
+void Replay::Reader::restart() {
+    m_position = LogHeaderSize;
+    m_time = 0;
+}
+
+std::vector<uint8_t> Replay::ParseDump(std::span<const uint8_t> text) {
+    std::vector<uint8_t> bytes;
+    std::string_view remaining(reinterpret_cast<const char*>(text.data()), text.size());
+    std::string_view prefix(DumpPrefix);
+    while (!remaining.empty()) {
+        size_t lineEnd = remaining.find('\n');
+        std::string_view line = remaining.substr(0, lineEnd);
+        remaining = lineEnd == std::string_view::npos ? std::string_view() : remaining.substr(lineEnd + 1);
+
+        // Log lines may carry timestamps or colors in front of the prefix
+        size_t start = line.find(prefix);
+        if (start == std::string_view::npos)
+            continue;
+        line.remove_prefix(start + prefix.size());
+        for (size_t index = 0; index + 1 < line.size(); index += 2) {
+            int high = HexValue(line[index]), low = HexValue(line[index + 1]);
+            if (high < 0 || low < 0)
+                break;
+            bytes.push_back(static_cast<uint8_t>((high << 4) | low));
+        }
+    }
+    return bytes;
+}
+
+} // namespace evms
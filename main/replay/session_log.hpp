@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <vector>
+
+#include "diagnostics/memory_report.hpp"
+#include "display/types.hpp"
+
+namespace evms {
+
+namespace Replay {
+    /*
+    *   Session log, everything that makes two runs of the frame loop differ:
+    *   a header with the RNG seed, then one record per frame tick. A record is a
+    *   LEB128 varint of (microseconds since the previous tick << 1 | touched), followed
+    *   by the touch position as two little-endian 16-bit values if touched.
+    *   An untouched frame at 100 fps takes 3 bytes, a touched one 7.
+    */
+    constexpr char LogMagic[4] = { 'E', 'V', 'R', 'L' };
+    // Version 2: seeds feed Utility::RandomEngine instead of std::mt19937
+    constexpr uint8_t LogVersion = 2;
+    constexpr size_t LogHeaderSize = 12;
+
+    // Prefix of the console lines a log is dumped as
+    constexpr const char* DumpPrefix = "replay: ";
+
+    struct FrameSample {
+        int64_t timeMicroseconds = 0;   // Since the first frame
+        Display::Position touch = { -1, -1 };
+    };
+
+    // Appends to a buffer that's reserved up front, so recording doesn't allocate per frame
+    class Recorder {
+    private:
+        Diagnostics::TaggedVector<uint8_t, Diagnostics::Subsystem::Replay> m_bytes;
+        size_t m_capacity;
+        int64_t m_lastTime = -1;
+        size_t m_frames = 0;
+
+    public:
+        Recorder(uint32_t seed, size_t capacity);
+
+    public:
+        // Position { -1, -1 } means not touched. False once the log is full.
+        bool frame(int64_t timeMicroseconds, Display::Position touch);
+
+        // Hex lines starting with DumpPrefix, for capturing from the serial console
+        void dump(std::ostream& stream) const;
+
+    public:
+        inline std::span<const uint8_t> bytes() const {
+            return m_bytes;
+        }
+
+        inline size_t frames() const {
+            return m_frames;
+        }
+    };
+
+    class Reader {
+    private:
+        std::span<const uint8_t> m_bytes;
+        size_t m_position = LogHeaderSize;
+        int64_t m_time = 0;
+        uint32_t m_seed = 0;
+
+    public:
+        Reader() = default;
+
+        // Empty reader if bytes don't start with a valid header
+        explicit Reader(std::span<const uint8_t> bytes);
+
+    public:
+        // False at the end of the log
+        bool next(FrameSample& sample);
+
+        // Back to the first frame
+        void restart();
+
+    public:
+        inline uint32_t seed() const {
+            return m_seed;
+        }
+
+        explicit operator bool() const {
+            return !m_bytes.empty();
+        }
+    };
+
+    // Extracts a log from console output (or anything else) holding DumpPrefix lines
+    std::vector<uint8_t> ParseDump(std::span<const uint8_t> text);
+}
+
+} // namespace evms
@@ -0,0 +1,47 @@
+#include "button.hpp"
+
+#include <utility>
+
+#include "display/kernels.hpp"
+
+namespace evms {
+
+Ui::Button::Button(const Display::Rect& bounds, const Display::Font& font, std::string_view text, std::function<void()> onClick, uint16_t foreground, uint16_t background, uint16_t pressedBackground)
+    : Label(bounds, font, text, foreground, background)
+    , m_onClick(std::move(onClick))
+    , m_pressedBackground(pressedBackground) {
+    m_alignment = Alignment::Center;
+}
+
+void Ui::Button::draw(Display::MutablePixelView canvas) const {
+    drawText(canvas, m_foreground, m_pressed ? m_pressedBackground : m_background);
+
+    // One pixel border in text color
+    int width = canvas.width(), height = canvas.height();
+    Display::Kernels::Fill(canvas, { 0, 0, width, 1 }, m_foreground);
+    Display::Kernels::Fill(canvas, { 0, height - 1, width, 1 }, m_foreground);
+    Display::Kernels::Fill(canvas, { 0, 0, 1, height }, m_foreground);
+    Display::Kernels::Fill(canvas, { width - 1, 0, 1, height }, m_foreground);
+}
+
+bool Ui::Button::touch(Display::Position position, bool pressed) {
+    bool inside = m_bounds.contains(position);
+    if (pressed) {
+        // Dragging out of the button cancels the press
+        if (m_pressed != inside) {
+            m_pressed = inside;
+            invalidate();
+        }
+        return true;
+    }
+
+    if (m_pressed) {
+        m_pressed = false;
+        invalidate();
+        if (m_onClick)
+            m_onClick();
+    }
+    return true;
+}
+
+} // namespace evms
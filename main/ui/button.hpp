@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+#include "ui/label.hpp"
+
+namespace evms {
+
+namespace Ui {
+    // Label with a border that reacts to touch. Click fires on release if the touch stayed inside.
+    class Button : public Label {
+    private:
+        std::function<void()> m_onClick;
+        uint16_t m_pressedBackground;
+        bool m_pressed = false;
+
+    public:
+        Button(const Display::Rect& bounds, const Display::Font& font, std::string_view text, std::function<void()> onClick, uint16_t foreground = 0xFFFF, uint16_t background = 0x0000, uint16_t pressedBackground = 0x1084);
+
+    public:
+        void draw(Display::MutablePixelView canvas) const override;
+
+        bool touch(Display::Position position, bool pressed) override;
+
+    public:
+        inline bool pressed() const {
+            return m_pressed;
+        }
+    };
+}
+
+} // namespace evms
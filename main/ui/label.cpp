@@ -0,0 +1,60 @@
+#include "label.hpp"
+
+#include <algorithm>
+
+#include "display/kernels.hpp"
+#include "display/text.hpp"
+
+namespace evms {
+
+Ui::Label::Label(const Display::Rect& bounds, const Display::Font& font, std::string_view text, uint16_t foreground, uint16_t background)
+    : Widget(bounds)
+    , m_font(font)
+    , m_foreground(foreground)
+    , m_background(background) {
+    setText(text);
+}
+
+void Ui::Label::drawText(Display::MutablePixelView canvas, uint16_t foreground, uint16_t background) const {
+    Display::Kernels::Fill(canvas, background);
+
+    Display::Rect textBounds = Display::MeasureText(m_font, text());
+    int x = 0;
+    if (m_alignment == Alignment::Center)
+        x = (canvas.width() - textBounds.width) / 2;
+    else if (m_alignment == Alignment::Right)
+        x = canvas.width() - textBounds.width;
+    int y = (canvas.height() - textBounds.height) / 2;
+    Display::DrawText(canvas, x, y, m_font, text(), foreground, background);
+}
+
+void Ui::Label::draw(Display::MutablePixelView canvas) const {
+    drawText(canvas, m_foreground, m_background);
+}
+
+void Ui::Label::setText(std::string_view text) {
+    text = text.substr(0, MaxLength);
+    if (text == this->text())
+        return;
+
+    std::copy(text.begin(), text.end(), m_text.begin());
+    m_length = text.size();
+    invalidate();
+}
+
+void Ui::Label::setAlignment(Alignment alignment) {
+    if (m_alignment != alignment) {
+        m_alignment = alignment;
+        invalidate();
+    }
+}
+
+void Ui::Label::setColors(uint16_t foreground, uint16_t background) {
+    if (m_foreground != foreground || m_background != background) {
+        m_foreground = foreground;
+        m_background = background;
+        invalidate();
+    }
+}
+
+} // namespace evms
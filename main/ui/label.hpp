@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <string_view>
+
+#include "display/font.hpp"
+#include "ui/widget.hpp"
+
+namespace evms {
+
+namespace Ui {
+    class Label : public Widget {
+    public:
+        static constexpr size_t MaxLength = 31;
+
+        enum class Alignment {
+            Left,
+            Center,
+            Right,
+        };
+
+    protected:
+        const Display::Font& m_font;
+        std::array<char, MaxLength> m_text = {};
+        size_t m_length = 0;
+        Alignment m_alignment = Alignment::Left;
+        uint16_t m_foreground;
+        uint16_t m_background;
+
+    protected:
+        // Draw background and text with given colors, text is vertically centered
+        void drawText(Display::MutablePixelView canvas, uint16_t foreground, uint16_t background) const;
+
+    public:
+        Label(const Display::Rect& bounds, const Display::Font& font, std::string_view text = {}, uint16_t foreground = 0xFFFF, uint16_t background = 0x0000);
+
+    public:
+        void draw(Display::MutablePixelView canvas) const override;
+
+    public:
+        // Text longer than MaxLength is truncated. Invalidates only if text changes.
+        void setText(std::string_view text);
+
+        void setAlignment(Alignment alignment);
+
+        void setColors(uint16_t foreground, uint16_t background);
+
+    public:
+        inline std::string_view text() const {
+            return { m_text.data(), m_length };
+        }
+    };
+}
+
+} // namespace evms
@@ -0,0 +1,31 @@
+#include "numeric_readout.hpp"
+
+#include <algorithm>
+#include <charconv>
+
+namespace evms {
+
+Ui::NumericReadout::NumericReadout(const Display::Rect& bounds, const Display::Font& font, std::string_view prefix, uint16_t foreground, uint16_t background)
+    : Label(bounds, font, {}, foreground, background) {
+    // Prefix is limited so that any int fits after it
+    prefix = prefix.substr(0, MaxLength - 11);
+    std::copy(prefix.begin(), prefix.end(), m_prefix.begin());
+    m_prefixLength = prefix.size();
+    m_alignment = Alignment::Right;
+    setValue(0);
+}
+
+void Ui::NumericReadout::setValue(int value) {
+    if (m_formatted && value == m_value)
+        return;
+
+    std::array<char, MaxLength> text;
+    char* end = std::copy_n(m_prefix.begin(), m_prefixLength, text.begin());
+    end = std::to_chars(end, text.data() + text.size(), value).ptr;
+    setText({ text.data(), static_cast<size_t>(end - text.data()) });
+
+    m_value = value;
+    m_formatted = true;
+}
+
+} // namespace evms
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <string_view>
+
+#include "ui/label.hpp"
+
+namespace evms {
+
+namespace Ui {
+    // Right-aligned integer with optional prefix (copied), reformatted only when the value changes
+    class NumericReadout : public Label {
+    private:
+        std::array<char, MaxLength> m_prefix = {};
+        size_t m_prefixLength = 0;
+        int m_value = 0;
+        bool m_formatted = false;
+
+    public:
+        NumericReadout(const Display::Rect& bounds, const Display::Font& font, std::string_view prefix = {}, uint16_t foreground = 0xFFFF, uint16_t background = 0x0000);
+
+    public:
+        void setValue(int value);
+
+    public:
+        inline int value() const {
+            return m_value;
+        }
+    };
+}
+
+} // namespace evms
@@ -0,0 +1,33 @@
+#include "progress_bar.hpp"
+
+#include <algorithm>
+
+#include "display/kernels.hpp"
+
+namespace evms {
+
+Ui::ProgressBar::ProgressBar(const Display::Rect& bounds, int maximum, uint16_t foreground, uint16_t background)
+    : Widget(bounds)
+    , m_maximum(std::max(maximum, 1))
+    , m_foreground(foreground)
+    , m_background(background) {
+}
+
+int Ui::ProgressBar::filledWidth(int value) const {
+    return static_cast<int>((static_cast<int64_t>(value) * m_bounds.width) / m_maximum);
+}
+
+void Ui::ProgressBar::draw(Display::MutablePixelView canvas) const {
+    int filled = filledWidth(m_value);
+    Display::Kernels::Fill(canvas, { 0, 0, filled, canvas.height() }, m_foreground);
+    Display::Kernels::Fill(canvas, { filled, 0, canvas.width() - filled, canvas.height() }, m_background);
+}
+
+void Ui::ProgressBar::setValue(int value) {
+    value = std::clamp(value, 0, m_maximum);
+    if (filledWidth(value) != filledWidth(m_value))
+        invalidate();
+    m_value = value;
+}
+
+} // namespace evms
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+
+#include "ui/widget.hpp"
+
+namespace evms {
+
+namespace Ui {
+    // Horizontal bar filled proportionally to value in [0, maximum]
+    class ProgressBar : public Widget {
+    private:
+        int m_value = 0;
+        int m_maximum;
+        uint16_t m_foreground;
+        uint16_t m_background;
+
+    private:
+        int filledWidth(int value) const;
+
+    public:
+        ProgressBar(const Display::Rect& bounds, int maximum = 100, uint16_t foreground = 0xFFFF, uint16_t background = 0x0000);
+
+    public:
+        void draw(Display::MutablePixelView canvas) const override;
+
+    public:
+        // Invalidates only if the filled part changes by at least a pixel
+        void setValue(int value);
+
+    public:
+        inline int value() const {
+            return m_value;
+        }
+    };
+}
+
+} // namespace evms
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+#include "display/kernels.hpp"
+#include "ui/widget.hpp"
+
+namespace evms {
+
+namespace Ui {
+    /*
+    *   Fixed set of widgets over a background.
+    *   render() draws only invalidated widgets straight into the screen canvas and
+    *   invalidates their bounds on the screen, so one Screen::render() per frame sends
+    *   everything that changed and nothing if nothing did.
+    */
+    template <size_t Capacity>
+    class Scene {
+    private:
+        std::array<Widget*, Capacity> m_widgets = {};
+        size_t m_size = 0;
+        Widget* m_captured = nullptr;
+        uint16_t m_background;
+
+    public:
+        explicit Scene(uint16_t background = 0x0000)
+            : m_background(background)
+        {}
+
+    public:
+        // Widgets added later are on top. Returns false if scene is full.
+        bool add(Widget& widget) {
+            if (m_size == Capacity)
+                return false;
+            m_widgets[m_size++] = &widget;
+            return true;
+        }
+
+        void invalidate() {
+            for (size_t index = 0; index < m_size; ++index)
+                m_widgets[index]->invalidate();
+        }
+
+        // Position { -1, -1 } means not touched. Returns true if a widget consumed the touch.
+        bool touch(Display::Position position) {
+            bool pressed = position.x >= 0 && position.y >= 0;
+            if (!pressed) {
+                if (!m_captured)
+                    return false;
+                Widget* captured = m_captured;
+                m_captured = nullptr;
+                return captured->touch(position, false);
+            }
+
+            // The topmost widget under the first touch sample keeps receiving the touch until release
+            if (!m_captured) {
+                for (size_t index = m_size; index-- > 0;) {
+                    if (m_widgets[index]->hitTest(position)) {
+                        m_captured = m_widgets[index];
+                        break;
+                    }
+                }
+            }
+            return m_captured && m_captured->touch(position, true);
+        }
+
+        // Returns the number of widgets redrawn. Widgets not fully on screen are skipped.
+        template <typename ScreenType>
+        size_t render(ScreenType& screen) {
+            Display::MutablePixelView canvas = screen.canvas();
+            size_t redrawn = 0;
+            for (size_t index = 0; index < m_size; ++index) {
+                Widget& widget = *m_widgets[index];
+                if (!widget.dirty())
+                    continue;
+
+                const Display::Rect& bounds = widget.bounds();
+                Display::MutablePixelView area = canvas.subview(bounds.x, bounds.y, bounds.dimensions());
+                if (area.dimensions().width == bounds.width && area.dimensions().height == bounds.height) {
+                    if (widget.visible())
+                        widget.draw(area);
+                    else
+                        Display::Kernels::Fill(area, m_background);
+                    screen.invalidate(bounds);
+                    ++redrawn;
+                }
+                widget.validate();
+            }
+            return redrawn;
+        }
+    };
+}
+
+} // namespace evms
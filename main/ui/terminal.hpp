@@ -0,0 +1,56 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+
+#include "display/font.hpp"
+#include "display/text.hpp"
+
+namespace evms {
+
+namespace Ui {
+    /*
+    *   Log view on top of the screen's hardware vertical scrolling.
+    *   Once full, appending a line scrolls the area by one line height and draws
+    *   only the new line into the rows that just wrapped around to the bottom,
+    *   so each append sends one line of pixels no matter how tall the view is.
+    */
+    template <typename ScreenType>
+    class Terminal {
+    private:
+        ScreenType& m_screen;
+        const Display::Font& m_font;
+        int m_top;
+        int m_lineCount;
+        int m_usedLines = 0;
+        uint16_t m_foreground;
+        uint16_t m_background;
+
+    public:
+        // Takes over rows [top, top + height) as the screen's scroll area, height is rounded down to whole lines
+        Terminal(ScreenType& screen, const Display::Font& font, int top, int height, uint16_t foreground = 0xFFFF, uint16_t background = 0x0000);
+
+        Terminal(const Terminal& other) = delete;
+
+        ~Terminal() = default;
+
+    public:
+        Terminal& operator=(const Terminal& other) = delete;
+
+    public:
+        // Line is clipped to screen width. Changes are sent by the next screen render().
+        void append(std::string_view line);
+
+        void clear();
+
+    public:
+        inline int lineCount() const {
+            return m_lineCount;
+        }
+    };
+}
+
+} // namespace evms
+
+#include "terminal.inl"
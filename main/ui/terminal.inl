@@ -0,0 +1,46 @@
+namespace evms {
+
+namespace Ui {
+    template <typename ScreenType>
+    Terminal<ScreenType>::Terminal(ScreenType& screen, const Display::Font& font, int top, int height, uint16_t foreground, uint16_t background)
+        : m_screen(screen)
+        , m_font(font)
+        , m_top(top)
+        , m_lineCount(font.lineHeight ? height / font.lineHeight : 0)
+        , m_foreground(foreground)
+        , m_background(background) {
+        m_screen.setScrollArea(m_top, m_lineCount * m_font.lineHeight);
+        clear();
+    }
+
+    template <typename ScreenType>
+    void Terminal<ScreenType>::append(std::string_view line) {
+        if (m_lineCount == 0)
+            return;
+
+        int lineHeight = m_font.lineHeight;
+        int y;
+        if (m_usedLines < m_lineCount) {
+            y = m_top + (m_usedLines++ * lineHeight);
+        }
+        else {
+            // Oldest line wraps around to become the bottom one
+            m_screen.scrollBy(lineHeight);
+            y = m_top + ((m_lineCount - 1) * lineHeight);
+        }
+
+        // Text fills its own background, only the rest of the line is cleared separately
+        int width = ScreenType::Dimensions.width;
+        int textWidth = std::min(Display::MeasureText(m_font, line).width, width);
+        m_screen.drawText(0, y, m_font, line, m_foreground, m_background);
+        m_screen.fill(textWidth, y, { width - textWidth, lineHeight }, m_background);
+    }
+
+    template <typename ScreenType>
+    void Terminal<ScreenType>::clear() {
+        m_usedLines = 0;
+        m_screen.fill(0, m_top, { ScreenType::Dimensions.width, m_lineCount * m_font.lineHeight }, m_background);
+    }
+}
+
+} // namespace evms
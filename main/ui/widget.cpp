@@ -0,0 +1,28 @@
+#include "widget.hpp"
+
+namespace evms {
+
+Ui::Widget::Widget(const Display::Rect& bounds)
+    : m_bounds(bounds) {
+}
+
+bool Ui::Widget::touch(Display::Position, bool) {
+    return false;
+}
+
+void Ui::Widget::invalidate() {
+    m_dirty = true;
+}
+
+void Ui::Widget::validate() {
+    m_dirty = false;
+}
+
+void Ui::Widget::setVisible(bool visible) {
+    if (m_visible != visible) {
+        m_visible = visible;
+        invalidate();
+    }
+}
+
+} // namespace evms
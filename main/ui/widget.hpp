@@ -0,0 +1,62 @@
+#pragma once
+
+#include "display/types.hpp"
+
+namespace evms {
+
+namespace Ui {
+    /*
+    *   Base of retained widgets.
+    *   A widget redraws only after being invalidated, Scene collects invalidated
+    *   widgets once per frame and feeds their bounds into a single screen flush.
+    */
+    class Widget {
+    protected:
+        Display::Rect m_bounds;
+        bool m_dirty = true;
+        bool m_visible = true;
+
+    public:
+        explicit Widget(const Display::Rect& bounds);
+
+        Widget(const Widget& other) = delete;
+
+        virtual ~Widget() = default;
+
+    public:
+        Widget& operator=(const Widget& other) = delete;
+
+    public:
+        // Canvas is exactly the widget bounds, every pixel of it must be drawn
+        virtual void draw(Display::MutablePixelView canvas) const = 0;
+
+        // Position is in screen coordinates, pressed is false on release. Returns true if consumed.
+        virtual bool touch(Display::Position position, bool pressed);
+
+    public:
+        void invalidate();
+
+        void validate();
+
+        void setVisible(bool visible);
+
+    public:
+        inline const Display::Rect& bounds() const {
+            return m_bounds;
+        }
+
+        inline bool dirty() const {
+            return m_dirty;
+        }
+
+        inline bool visible() const {
+            return m_visible;
+        }
+
+        inline bool hitTest(Display::Position position) const {
+            return m_visible && m_bounds.contains(position);
+        }
+    };
+}
+
+} // namespace evms
@@ -1,20 +1,174 @@
 #pragma once
 
-#include <random>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
 
+#ifdef ESP_PLATFORM
 #include "esp_random.h"
+#else
+#include <random>
+#endif
 
 namespace evms {
 
 namespace Utility {
+    // 32 bits of hardware entropy (RF noise on ESP32, std::random_device on the host)
+    inline uint32_t HardwareRandom() {
+#ifdef ESP_PLATFORM
+        return esp_random();
+#else
+        return std::random_device{}();
+#endif
+    }
+
+    /*
+    *   xoshiro128++: 16 bytes of state, a handful of ALU ops per 32-bit output and good
+    *   enough statistics for graphics and simulations (not for cryptography). Bounded
+    *   integers use Lemire's multiply-shift, which only divides in the rare case a draw
+    *   has to be rejected, so results are unbiased. Satisfies UniformRandomBitGenerator,
+    *   <random> distributions work with it too. Not thread-safe, give each task its own.
+    */
+    class RandomEngine {
+    public:
+        using result_type = uint32_t;
+
+    private:
+        uint32_t m_state[4];
+
+    private:
+        static constexpr uint32_t RotateLeft(uint32_t value, int bits) {
+            return (value << bits) | (value >> (32 - bits));
+        }
+
+    public:
+        explicit RandomEngine(uint32_t seed) {
+            this->seed(seed);
+        }
+
+    public:
+        // Same seed, same sequence on every platform
+        void seed(uint32_t seed) {
+            // SplitMix64 spreads the seed over the state, which must not be all zeros
+            uint64_t mix = seed;
+            for (int index = 0; index < 4; index += 2) {
+                uint64_t value = (mix += 0x9E3779B97F4A7C15);
+                value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9;
+                value = (value ^ (value >> 27)) * 0x94D049BB133111EB;
+                value ^= value >> 31;
+                m_state[index] = static_cast<uint32_t>(value);
+                m_state[index + 1] = static_cast<uint32_t>(value >> 32);
+            }
+        }
+
+        // Fresh sequence from hardware entropy
+        void reseed() {
+            seed(HardwareRandom());
+        }
+
+        uint32_t operator()() {
+            uint32_t result = RotateLeft(m_state[0] + m_state[3], 7) + m_state[0];
+            uint32_t shifted = m_state[1] << 9;
+            m_state[2] ^= m_state[0];
+            m_state[3] ^= m_state[1];
+            m_state[1] ^= m_state[2];
+            m_state[0] ^= m_state[3];
+            m_state[2] ^= shifted;
+            m_state[3] = RotateLeft(m_state[3], 11);
+            return result;
+        }
+
+        // [0, bound), bound must not be 0
+        uint32_t below(uint32_t bound) {
+            uint64_t product = uint64_t((*this)()) * bound;
+            uint32_t low = static_cast<uint32_t>(product);
+            if (low < bound) {
+                uint32_t threshold = -bound % bound;
+                while (low < threshold) {
+                    product = uint64_t((*this)()) * bound;
+                    low = static_cast<uint32_t>(product);
+                }
+            }
+            return static_cast<uint32_t>(product >> 32);
+        }
+
+        // [min, max]
+        int integer(int min, int max) {
+            uint32_t span = static_cast<uint32_t>(max) - static_cast<uint32_t>(min);
+            if (span == std::numeric_limits<uint32_t>::max())
+                return static_cast<int>((*this)());
+            return static_cast<int>(static_cast<uint32_t>(min) + below(span + 1));
+        }
+
+        // [0, 1) with 24 bits of precision, every value a float can represent exactly
+        float unit() {
+            return ((*this)() >> 8) * 0x1p-24f;
+        }
+
+        // [min, max)
+        float real(float min, float max) {
+            return min + unit() * (max - min);
+        }
+
+        // Batch fills hoist the range setup out of the loop and keep state in registers
+
+        void fill(std::span<uint32_t> values) {
+            for (uint32_t& value : values)
+                value = (*this)();
+        }
+
+        void fillIntegers(std::span<int> values, int min, int max) {
+            uint32_t span = static_cast<uint32_t>(max) - static_cast<uint32_t>(min);
+            if (span == std::numeric_limits<uint32_t>::max()) {
+                for (int& value : values)
+                    value = static_cast<int>((*this)());
+                return;
+            }
+
+            uint32_t bound = span + 1;
+            uint32_t threshold = -bound % bound;
+            for (int& value : values) {
+                uint64_t product = uint64_t((*this)()) * bound;
+                while (static_cast<uint32_t>(product) < threshold)
+                    product = uint64_t((*this)()) * bound;
+                value = static_cast<int>(static_cast<uint32_t>(min) + static_cast<uint32_t>(product >> 32));
+            }
+        }
+
+        void fillFloats(std::span<float> values, float min, float max) {
+            float scale = (max - min) * 0x1p-24f;
+            for (float& value : values)
+                value = min + ((*this)() >> 8) * scale;
+        }
+
+    public:
+        static constexpr result_type min() {
+            return 0;
+        }
+
+        static constexpr result_type max() {
+            return std::numeric_limits<uint32_t>::max();
+        }
+    };
+
+    // Engine of the calling task, seeded from hardware entropy on first use
+    inline RandomEngine& RandomGenerator() {
+        thread_local RandomEngine generator(HardwareRandom());
+        return generator;
+    }
+
+    // Makes everything random on the calling task reproducible from now on, e.g. for session record/replay
+    inline void SeedRandom(uint32_t seed) {
+        RandomGenerator().seed(seed);
+    }
+
     inline int RandomInteger(int min, int max) {
-        static std::mt19937 generator(esp_random());
-        return std::uniform_int_distribution(min, max)(generator);
+        return RandomGenerator().integer(min, max);
     }
 
     inline float RandomFloat(float min, float max) {
-        static std::mt19937 generator(esp_random());
-        return std::uniform_real_distribution(min, max)(generator);
+        return RandomGenerator().real(min, max);
     }
 }
 
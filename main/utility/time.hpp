@@ -1,15 +1,22 @@
 #pragma once
 
+#ifdef ESP_PLATFORM
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 
 #include <rom/ets_sys.h>
 
 #include "esp_timer.h"
+#else
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#endif
 
 namespace evms {
 
 namespace Utility {
+#ifdef ESP_PLATFORM
     inline void Sleep(float seconds) {
         if (seconds <= 0)
             return;
@@ -27,6 +34,27 @@ namespace Utility {
         int64_t microseconds = esp_timer_get_time();
         return microseconds / 1'000'000.0f;
     }
+
+    // Float seconds lose precision over long uptimes, use this for timestamps and intervals
+    inline int64_t TimeMicroseconds() {
+        return esp_timer_get_time();
+    }
+#else
+    // Host builds (tools): same interface, time counts from the first call
+    inline void Sleep(float seconds) {
+        if (seconds > 0)
+            std::this_thread::sleep_for(std::chrono::duration<float>(seconds));
+    }
+
+    inline int64_t TimeMicroseconds() {
+        static const auto start = std::chrono::steady_clock::now();
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    inline float TimeSeconds() {
+        return TimeMicroseconds() / 1'000'000.0f;
+    }
+#endif
 }
 
 } // namespace evms
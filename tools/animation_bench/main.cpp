@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "assets/animation.hpp"
+#include "assets/pack_storage.hpp"
+#include "common/animation_writer.hpp"
+#include "display/animation_player.hpp"
+#include "display/controllers/ili9341.hpp"
+#include "display/screen.hpp"
+#include "display/transports/mock.hpp"
+using namespace evms;
+
+/*
+*   Measures animation playback on the host:
+*       animation_bench [<anim.bin>]
+*   Without an argument a synthetic animation (a square bouncing over a gradient) is
+*   encoded first and every played frame is checked against its source.
+*   Reports decode time per frame and what the player sends to the panel through a mock
+*   transport, with the wire time that takes at the panel's SPI clock. Host decode time
+*   only ranks changes against each other, wire time is what bounds the frame rate.
+*/
+
+namespace {
+    using Panel = Display::Controllers::Ili9341;
+    using Screen = Display::Screen<Panel, Display::Transports::Mock>;
+
+    constexpr Display::Dimensions2D SyntheticDimensions = { 240, 320 };
+    constexpr int SyntheticFrames = 120;
+    constexpr int SquareSize = 48;
+}
+
+static std::vector<uint16_t> SyntheticFrame(int index) {
+    std::vector<uint16_t> pixels(SyntheticDimensions.width * SyntheticDimensions.height);
+    for (int y = 0; y < SyntheticDimensions.height; ++y) {
+        uint16_t color = static_cast<uint16_t>((y * 31 / SyntheticDimensions.height) << 11);
+        std::fill_n(pixels.begin() + y * SyntheticDimensions.width, SyntheticDimensions.width, static_cast<uint16_t>((color >> 8) | (color << 8)));
+    }
+
+    int rangeX = SyntheticDimensions.width - SquareSize, rangeY = SyntheticDimensions.height - SquareSize;
+    int x = (index * 5) % (2 * rangeX), y = (index * 7) % (2 * rangeY);
+    x = x < rangeX ? x : 2 * rangeX - x;
+    y = y < rangeY ? y : 2 * rangeY - y;
+    for (int row = 0; row < SquareSize; ++row)
+        std::fill_n(pixels.begin() + (y + row) * SyntheticDimensions.width + x, SquareSize, 0xFFFF);
+    return pixels;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 2) {
+        std::cerr << "Usage: " << argv[0] << " [<anim.bin>]\n";
+        return 1;
+    }
+
+    std::vector<uint8_t> encoded;
+    Assets::PackStorage storage(argc == 2 ? argv[1] : "");
+    if (argc == 1) {
+        Tools::AnimationWriter writer(SyntheticDimensions, 33);
+        for (int frame = 0; frame < SyntheticFrames; ++frame)
+            writer.add(SyntheticFrame(frame));
+        encoded = writer.build();
+    }
+
+    Assets::Animation animation(argc == 2 ? storage.bytes() : std::span<const uint8_t>(encoded));
+    if (animation.empty()) {
+        std::cerr << (argc == 2 ? argv[1] : "synthetic") << ": not a valid animation\n";
+        return 1;
+    }
+
+    Display::Dimensions2D dimensions = animation.dimensions();
+    if (dimensions.width > Screen::Dimensions.width || dimensions.height > Screen::Dimensions.height) {
+        std::cerr << "Animation is larger than " << Screen::Dimensions.width << 'x' << Screen::Dimensions.height << '\n';
+        return 1;
+    }
+
+    // Decode alone, into a plain buffer
+    std::vector<uint16_t> target(dimensions.width * dimensions.height);
+    Display::MutablePixelView view = { target.data(), dimensions };
+    double decodeTotal = 0, decodeWorst = 0;
+    for (int frame = 0; frame < animation.frameCount(); ++frame) {
+        auto start = std::chrono::steady_clock::now();
+        bool decoded = animation.decode(animation.frame(frame), view);
+        double microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        if (!decoded) {
+            std::cerr << "Frame " << frame << " is malformed\n";
+            return 1;
+        }
+        decodeTotal += microseconds;
+        decodeWorst = std::max(decodeWorst, microseconds);
+    }
+
+    // Played through a screen, counting what goes over the wire
+    Screen screen;
+    screen.begin().get();
+    screen.render();
+    Display::AnimationPlayer player(animation, { 0, 0 }, false);
+    size_t bytesTotal = 0, bytesWorst = 0, windowsTotal = 0, mismatches = 0;
+    for (int frame = 0; frame < animation.frameCount(); ++frame) {
+        screen.transport().clear();
+        player.step(screen);
+
+        size_t bytes = screen.transport().bytesWritten();
+        bytesTotal += bytes;
+        bytesWorst = std::max(bytesWorst, bytes);
+        for (const auto& write : screen.transport().writes())
+            windowsTotal += write.command && write.bytes[0] == Display::Controllers::MipiDcs::MemoryWrite;
+
+        if (argc == 1) {
+            std::vector<uint16_t> expected = SyntheticFrame(frame);
+            for (int y = 0; y < dimensions.height; ++y)
+                mismatches += !std::equal(expected.begin() + y * dimensions.width, expected.begin() + (y + 1) * dimensions.width, screen.framebuffer().row(y));
+        }
+    }
+
+    int frames = animation.frameCount();
+    double wireAverage = bytesTotal * 8.0 / frames / Panel::Frequency * 1000;
+    double wireWorst = bytesWorst * 8.0 / Panel::Frequency * 1000;
+    std::printf("%d frames %dx%d, %d tiles of %d px, %.0f fps target\n",
+        frames, dimensions.width, dimensions.height, animation.tileCount(), animation.tileSize(), 1e6 / animation.frameMicroseconds());
+    std::printf("decode:  %8.1f us/frame average, %8.1f us worst\n", decodeTotal / frames, decodeWorst);
+    std::printf("sent:    %8zu bytes/frame average, %8zu worst, %.1f windows/frame\n", bytesTotal / frames, bytesWorst, double(windowsTotal) / frames);
+    std::printf("wire:    %8.2f ms/frame average, %8.2f ms worst at %d Hz (full frame %.2f ms)\n",
+        wireAverage, wireWorst, Panel::Frequency, dimensions.width * dimensions.height * 16.0 / Panel::Frequency * 1000);
+    std::printf("player:  %zu bytes of state, no frame buffers\n", sizeof(Display::AnimationPlayer));
+    if (argc == 1)
+        std::printf("check:   %s\n", mismatches ? "MISMATCH" : "every frame matches its source");
+    return mismatches ? 1 : 0;
+}
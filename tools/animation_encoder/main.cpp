@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "common/animation_writer.hpp"
+#include "common/image.hpp"
+#include "common/pack_writer.hpp"
+using namespace evms;
+
+/*
+*   Encodes a sequence of PNG/PPM frames into a delta-compressed animation:
+*       animation_encoder (--out <anim.bin> | --pack <out.bin> --name <name>)
+*                         [--fps <n>] [--tile <pixels>] [--keyframe <frames>] <frame> ...
+*   --fps       Playback rate stored in the animation, 30 by default.
+*   --tile      Tile size, 8 to 64 pixels, 16 by default. Smaller tiles track small
+*               changes more closely, larger ones cost fewer address windows to send.
+*   --keyframe  Make every n-th frame a keyframe, only the first one by default.
+*   --pack      Write an asset pack holding just the animation, for the "assets" partition.
+*   A per-frame size report goes to stdout.
+*/
+
+namespace {
+    struct Options {
+        std::string outputPath;
+        std::string packPath;
+        std::string name;
+        int fps = 30;
+        int tileSize = 16;
+        int keyFrameInterval = 0;
+        std::vector<std::string> frames;
+    };
+}
+
+static bool ParseOptions(int argc, char** argv, Options& options) {
+    for (int index = 1; index < argc; ++index) {
+        std::string argument = argv[index];
+        bool hasValue = index + 1 < argc;
+        if (argument == "--out" && hasValue)
+            options.outputPath = argv[++index];
+        else if (argument == "--pack" && hasValue)
+            options.packPath = argv[++index];
+        else if (argument == "--name" && hasValue)
+            options.name = argv[++index];
+        else if (argument == "--fps" && hasValue)
+            options.fps = std::stoi(argv[++index]);
+        else if (argument == "--tile" && hasValue)
+            options.tileSize = std::stoi(argv[++index]);
+        else if (argument == "--keyframe" && hasValue)
+            options.keyFrameInterval = std::stoi(argv[++index]);
+        else if (argument.starts_with("--"))
+            return false;
+        else
+            options.frames.push_back(argument);
+    }
+
+    if (options.outputPath.empty() == options.packPath.empty() || (!options.packPath.empty() && options.name.empty()))
+        return false;
+    if (options.fps < 1 || options.fps > 1000 || options.tileSize < 8 || options.tileSize > 64 || options.keyFrameInterval < 0)
+        return false;
+    return !options.frames.empty();
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0] << " (--out <anim.bin> | --pack <out.bin> --name <name>)\n";
+        std::cerr << "       [--fps <n>] [--tile <8..64>] [--keyframe <frames>] <frame> ...\n";
+        return 1;
+    }
+
+    Display::Dimensions2D dimensions = {};
+    std::optional<Tools::AnimationWriter> encoder;
+    for (const std::string& path : options.frames) {
+        Tools::Image image = Tools::LoadImage(path);
+        if (!image) {
+            std::cerr << path << ": couldn't load, expected PNG or binary PPM (P6)\n";
+            return 1;
+        }
+        if (!encoder) {
+            dimensions = image.dimensions;
+            encoder.emplace(dimensions, 1000 / options.fps, options.tileSize, options.keyFrameInterval);
+        }
+        if (image.dimensions.width != dimensions.width || image.dimensions.height != dimensions.height) {
+            std::cerr << path << ": frames must all be " << dimensions.width << 'x' << dimensions.height << '\n';
+            return 1;
+        }
+        if (!encoder->add(Tools::ToRgb565(image))) {
+            std::cerr << path << ": too many frames\n";
+            return 1;
+        }
+    }
+
+    const Tools::AnimationWriter& writer = *encoder;
+    std::vector<uint8_t> bytes = writer.build();
+    size_t raw = static_cast<size_t>(dimensions.width) * dimensions.height * sizeof(uint16_t);
+    size_t largest = 0;
+    for (size_t frame = 0; frame < writer.size(); ++frame) {
+        int index = static_cast<int>(frame);
+        largest = std::max(largest, writer.frameSize(index));
+        std::printf("%5zu %s %4d/%d tiles %8zu bytes\n", frame, writer.keyFrame(index) ? "key  " : "delta",
+            writer.changedTiles(index), writer.tileCount(), writer.frameSize(index));
+    }
+    std::printf("%zu frames %dx%d @ %d fps: %zu bytes (raw %zu, %.1f%%), largest frame %zu bytes\n",
+        writer.size(), dimensions.width, dimensions.height, options.fps, bytes.size(),
+        raw * writer.size(), 100.0 * bytes.size() / (raw * writer.size()), largest);
+
+    if (!options.outputPath.empty()) {
+        if (!writer.write(options.outputPath)) {
+            std::cerr << options.outputPath << ": couldn't write\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    Tools::PackWriter pack;
+    if (!pack.add(options.name, dimensions, Assets::PixelFormat::Animation, 0, std::move(bytes))) {
+        std::cerr << options.name << ": name is empty or longer than " << Assets::NameSize << " characters\n";
+        return 1;
+    }
+    if (!pack.write(options.packPath)) {
+        std::cerr << options.packPath << ": couldn't write\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include <iostream>
+#include <string>
+
+#include "assets/asset_pack.hpp"
+#include "assets/pack_storage.hpp"
+#include "common/image.hpp"
+#include "common/pack_writer.hpp"
+using namespace evms;
+
+/*
+*   Builds an asset pack for the "assets" flash partition:
+*       asset_packer <output.bin> <name>=<image.ppm>[:rle] ...
+*   Lists the contents of an existing pack, reading it the way the firmware does:
+*       asset_packer --list <pack.bin>
+*/
+
+static int List(const char* path) {
+    Assets::PackStorage storage(path);
+    Assets::AssetPack pack(storage.bytes());
+    if (pack.empty()) {
+        std::cerr << path << ": not a valid asset pack\n";
+        return 1;
+    }
+
+    for (size_t index = 0; index < pack.size(); ++index) {
+        Assets::Asset asset = pack.asset(static_cast<int>(index));
+        std::cout << asset.name << ": " << asset.dimensions.width << 'x' << asset.dimensions.height;
+        std::cout << ", " << asset.data.size() << " bytes" << (asset.compressed ? " (RLE)" : "") << '\n';
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc == 3 && std::string(argv[1]) == "--list")
+        return List(argv[2]);
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <output.bin> <name>=<image.ppm>[:rle] ...\n";
+        std::cerr << "       " << argv[0] << " --list <pack.bin>\n";
+        return 1;
+    }
+
+    Tools::PackWriter writer;
+    for (int index = 2; index < argc; ++index) {
+        std::string argument = argv[index];
+        size_t equals = argument.find('=');
+        if (equals == std::string::npos) {
+            std::cerr << argument << ": expected <name>=<image.ppm>[:rle]\n";
+            return 1;
+        }
+
+        std::string name = argument.substr(0, equals);
+        std::string path = argument.substr(equals + 1);
+        bool compress = path.ends_with(":rle");
+        if (compress)
+            path.resize(path.size() - 4);
+
+        Tools::Image image = Tools::LoadPpm(path);
+        if (!image) {
+            std::cerr << path << ": couldn't load, expected binary PPM (P6) with 8-bit channels\n";
+            return 1;
+        }
+        if (!writer.addPixels(name, image.dimensions, Tools::ToRgb565(image), compress)) {
+            std::cerr << name << ": name is empty, longer than " << Assets::NameSize << " characters or taken\n";
+            return 1;
+        }
+    }
+
+    if (!writer.write(argv[1])) {
+        std::cerr << argv[1] << ": couldn't write\n";
+        return 1;
+    }
+    return List(argv[1]);
+}
@@ -0,0 +1,106 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "display/color.hpp"
+using namespace evms;
+
+/*
+*   Measures RGB888 to RGB565 conversion on the host:
+*       color_bench
+*   Converts a 240 pixel row (one ILI9341 line) over and over with the plain and
+*   dithered span kernels and a straightforward per-pixel reference, checks the plain
+*   kernel against the reference and reports pixels per second. Both kernels look up
+*   the same channel tables, the plain one with a zero threshold. Also shows how far a
+*   shallow gradient drifts from its 8-bit colors when averaged over 4x4 blocks, which
+*   is what the eye does and what dithering is for.
+*/
+
+namespace {
+    constexpr int RowLength = 240;
+    constexpr double MinimumSeconds = 0.3;
+}
+
+static void Reference(uint16_t* destination, const uint8_t* rgb, int length, int, int) {
+    for (int index = 0; index < length; ++index, rgb += 3) {
+        uint16_t pixel = ((rgb[0] & 0xF8) << 8) | ((rgb[1] & 0xFC) << 3) | (rgb[2] >> 3);
+        destination[index] = static_cast<uint16_t>((pixel >> 8) | (pixel << 8));
+    }
+}
+
+static void Plain(uint16_t* destination, const uint8_t* rgb, int length, int, int) {
+    Display::Color::FromRgb888Span(destination, rgb, length);
+}
+
+template <typename Kernel>
+static double PixelsPerSecond(Kernel kernel, const std::vector<uint8_t>& rgb, std::vector<uint16_t>& row) {
+    long long pixels = 0;
+    double seconds = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int y = 0; seconds < MinimumSeconds; ++y) {
+        for (int repeat = 0; repeat < 1000; ++repeat, ++y)
+            kernel(row.data(), rgb.data(), RowLength, 0, y);
+        pixels += 1000LL * RowLength;
+        asm volatile("" : : "r"(row.data()) : "memory");
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    return pixels / seconds;
+}
+
+// Average over 4x4 blocks of a 240x4 patch, compared with the 8-bit source, in 8-bit units
+static double BlockError(const std::vector<uint8_t>& rgb, bool dithered) {
+    std::vector<uint16_t> rows(RowLength * 4);
+    for (int y = 0; y < 4; ++y) {
+        if (dithered)
+            Display::Color::FromRgb888SpanDithered(rows.data() + y * RowLength, rgb.data(), RowLength, 0, y);
+        else
+            Display::Color::FromRgb888Span(rows.data() + y * RowLength, rgb.data(), RowLength);
+    }
+
+    double error = 0;
+    for (int block = 0; block < RowLength / 4; ++block) {
+        double sum = 0, expected = 0;
+        for (int y = 0; y < 4; ++y) {
+            for (int x = block * 4; x < block * 4 + 4; ++x) {
+                uint16_t pixel = rows[y * RowLength + x];
+                sum += pixel & 0xF8;     // Red, top bits of the first byte in memory
+                expected += rgb[x * 3];
+            }
+        }
+        error += std::fabs(sum - expected) / 16;
+    }
+    return error / (RowLength / 4);
+}
+
+int main() {
+    std::vector<uint8_t> rgb(RowLength * 3);
+    uint32_t noise = 1;
+    for (uint8_t& channel : rgb) {
+        noise = noise * 1103515245 + 12345;
+        channel = static_cast<uint8_t>(noise >> 16);
+    }
+
+    std::vector<uint16_t> expected(RowLength), row(RowLength);
+    Reference(expected.data(), rgb.data(), RowLength, 0, 0);
+    Plain(row.data(), rgb.data(), RowLength, 0, 0);
+    bool matches = row == expected;
+
+    // Misaligned source takes the scalar path, it must agree too
+    std::vector<uint8_t> shifted(rgb.size() + 1);
+    std::copy(rgb.begin(), rgb.end(), shifted.begin() + 1);
+    Display::Color::FromRgb888Span(row.data(), shifted.data() + 1, RowLength);
+    matches &= row == expected;
+
+    std::printf("reference: %7.1f Mpx/s\n", PixelsPerSecond(Reference, rgb, row) / 1e6);
+    std::printf("plain:     %7.1f Mpx/s %s\n", PixelsPerSecond(Plain, rgb, row) / 1e6, matches ? "(matches reference)" : "(MISMATCH)");
+    std::printf("dithered:  %7.1f Mpx/s\n", PixelsPerSecond(Display::Color::FromRgb888SpanDithered, rgb, row) / 1e6);
+
+    // Red ramp from 64 to 96 across the row: only four RGB565 levels without dithering
+    for (int x = 0; x < RowLength; ++x) {
+        rgb[x * 3] = static_cast<uint8_t>(64 + x * 32 / RowLength);
+        rgb[x * 3 + 1] = rgb[x * 3 + 2] = 0;
+    }
+    std::printf("gradient error over 4x4 blocks: plain %.2f, dithered %.2f (8-bit units)\n", BlockError(rgb, false), BlockError(rgb, true));
+    return matches ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+#include "animation_writer.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include "assets/animation.hpp"
+#include "assets/rle.hpp"
+
+namespace evms {
+
+Tools::AnimationWriter::AnimationWriter(Display::Dimensions2D dimensions, int frameMilliseconds, int tileSize, int keyFrameInterval)
+    : m_dimensions(dimensions)
+    , m_frameMilliseconds(frameMilliseconds)
+    , m_tileSize(tileSize)
+    , m_keyFrameInterval(keyFrameInterval)
+{}
+
+bool Tools::AnimationWriter::add(const std::vector<uint16_t>& pixels) {
+    if (pixels.size() < static_cast<size_t>(m_dimensions.width * m_dimensions.height) || m_frames.size() >= 0xFFFF)
+        return false;
+
+    EncodedFrame frame;
+    frame.keyFrame = m_frames.empty() || (m_keyFrameInterval > 0 && m_frames.size() % m_keyFrameInterval == 0);
+
+    int tilesX = (m_dimensions.width + m_tileSize - 1) / m_tileSize;
+    frame.data.resize((tileCount() + 7) / 8);
+    std::vector<uint16_t> changed;
+    for (int tile = 0; tile < tileCount(); ++tile) {
+        int x = (tile % tilesX) * m_tileSize, y = (tile / tilesX) * m_tileSize;
+        int width = std::min(m_tileSize, m_dimensions.width - x);
+        int height = std::min(m_tileSize, m_dimensions.height - y);
+
+        bool differs = frame.keyFrame;
+        for (int row = 0; row < height && !differs; ++row) {
+            size_t start = (y + row) * m_dimensions.width + x;
+            differs = !std::equal(pixels.begin() + start, pixels.begin() + start + width, m_previous.begin() + start);
+        }
+        if (!differs)
+            continue;
+
+        frame.data[tile / 8] |= 0x80 >> (tile % 8);
+        ++frame.changedTiles;
+        for (int row = 0; row < height; ++row) {
+            size_t start = (y + row) * m_dimensions.width + x;
+            changed.insert(changed.end(), pixels.begin() + start, pixels.begin() + start + width);
+        }
+    }
+
+    std::vector<uint8_t> stream = Assets::Rle::Encode(changed);
+    frame.data.insert(frame.data.end(), stream.begin(), stream.end());
+    m_previous.assign(pixels.begin(), pixels.begin() + m_dimensions.width * m_dimensions.height);
+    m_frames.push_back(std::move(frame));
+    return true;
+}
+
+std::vector<uint8_t> Tools::AnimationWriter::build() const {
+    Assets::AnimationHeader header = {};
+    std::memcpy(header.magic, Assets::AnimationMagic, sizeof(header.magic));
+    header.width = static_cast<uint16_t>(m_dimensions.width);
+    header.height = static_cast<uint16_t>(m_dimensions.height);
+    header.frameCount = static_cast<uint16_t>(m_frames.size());
+    header.frameMilliseconds = static_cast<uint16_t>(m_frameMilliseconds);
+    header.tileSize = static_cast<uint8_t>(m_tileSize);
+
+    std::vector<uint8_t> output(sizeof(header) + m_frames.size() * sizeof(uint32_t));
+    std::memcpy(output.data(), &header, sizeof(header));
+    for (size_t index = 0; index < m_frames.size(); ++index) {
+        const EncodedFrame& frame = m_frames[index];
+        uint32_t offset = static_cast<uint32_t>(output.size());
+        std::memcpy(output.data() + sizeof(header) + index * sizeof(uint32_t), &offset, sizeof(offset));
+
+        Assets::FrameHeader frameHeader = {};
+        frameHeader.flags = frame.keyFrame ? Assets::KeyFrameFlag : 0;
+        frameHeader.changedTiles = static_cast<uint16_t>(frame.changedTiles);
+        frameHeader.size = static_cast<uint32_t>(frame.data.size());
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&frameHeader);
+        output.insert(output.end(), bytes, bytes + sizeof(frameHeader));
+        output.insert(output.end(), frame.data.begin(), frame.data.end());
+    }
+    return output;
+}
+
+bool Tools::AnimationWriter::write(const std::string& path) const {
+    std::vector<uint8_t> bytes = build();
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    return static_cast<bool>(file);
+}
+
+} // namespace evms
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "display/types.hpp"
+
+namespace evms {
+
+namespace Tools {
+    // Encodes frames in the format Assets::Animation reads
+    class AnimationWriter {
+    private:
+        struct EncodedFrame {
+            bool keyFrame = false;
+            int changedTiles = 0;
+            std::vector<uint8_t> data;  // Tile map and RLE stream
+        };
+
+    private:
+        Display::Dimensions2D m_dimensions;
+        int m_frameMilliseconds;
+        int m_tileSize;
+        int m_keyFrameInterval;
+        std::vector<uint16_t> m_previous;
+        std::vector<EncodedFrame> m_frames;
+
+    public:
+        // Keyframe interval of 0 makes only the first frame a keyframe
+        AnimationWriter(Display::Dimensions2D dimensions, int frameMilliseconds, int tileSize = 16, int keyFrameInterval = 0);
+
+    public:
+        // Pixels in panel byte order, false if there are too few of them or too many frames
+        bool add(const std::vector<uint16_t>& pixels);
+
+        std::vector<uint8_t> build() const;
+
+        bool write(const std::string& path) const;
+
+    public:
+        inline size_t size() const {
+            return m_frames.size();
+        }
+
+        inline bool keyFrame(int frame) const {
+            return m_frames[frame].keyFrame;
+        }
+
+        inline int changedTiles(int frame) const {
+            return m_frames[frame].changedTiles;
+        }
+
+        inline size_t frameSize(int frame) const {
+            return m_frames[frame].data.size();
+        }
+
+        inline int tileCount() const {
+            return ((m_dimensions.width + m_tileSize - 1) / m_tileSize) * ((m_dimensions.height + m_tileSize - 1) / m_tileSize);
+        }
+    };
+}
+
+} // namespace evms
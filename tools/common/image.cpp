@@ -0,0 +1,153 @@
+#include "image.hpp"
+
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+
+#ifdef EVMS_HAVE_PNG
+#include <png.h>
+#endif
+
+#include "display/color.hpp"
+
+namespace evms {
+
+static bool ReadPpmNumber(std::istream& stream, int& number) {
+    // Whitespace and comments may separate header fields
+    while (true) {
+        int character = stream.peek();
+        if (character == '#')
+            stream.ignore(1 << 16, '\n');
+        else if (std::isspace(character))
+            stream.get();
+        else
+            break;
+    }
+    return static_cast<bool>(stream >> number);
+}
+
+static uint16_t ToPanelOrder(uint16_t pixel) {
+    return static_cast<uint16_t>((pixel << 8) | (pixel >> 8));
+}
+
+Tools::Image Tools::LoadPpm(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    std::string magic;
+    int width = 0, height = 0, maxValue = 0;
+    if (!(file >> magic) || magic != "P6")
+        return {};
+    if (!ReadPpmNumber(file, width) || !ReadPpmNumber(file, height) || !ReadPpmNumber(file, maxValue))
+        return {};
+    if (width <= 0 || height <= 0 || width > 0xFFFF || height > 0xFFFF || maxValue != 255)
+        return {};
+    file.get();
+
+    Image image = { { width, height }, std::vector<uint8_t>(static_cast<size_t>(width) * height * 3), {} };
+    if (!file.read(reinterpret_cast<char*>(image.rgb.data()), image.rgb.size()))
+        return {};
+    return image;
+}
+
+bool Tools::SavePpm(const std::string& path, const Image& image) {
+    std::ofstream file(path, std::ios::binary);
+    file << "P6\n" << image.dimensions.width << ' ' << image.dimensions.height << "\n255\n";
+    file.write(reinterpret_cast<const char*>(image.rgb.data()), image.rgb.size());
+    return static_cast<bool>(file);
+}
+
+Tools::Image Tools::LoadPng(const std::string& path) {
+#ifdef EVMS_HAVE_PNG
+    png_image png = {};
+    png.version = PNG_IMAGE_VERSION;
+    if (!png_image_begin_read_from_file(&png, path.c_str()))
+        return {};
+
+    png.format = PNG_FORMAT_RGBA;
+    std::vector<uint8_t> rgba(PNG_IMAGE_SIZE(png));
+    if (!png_image_finish_read(&png, nullptr, rgba.data(), 0, nullptr)) {
+        png_image_free(&png);
+        return {};
+    }
+
+    int width = static_cast<int>(png.width), height = static_cast<int>(png.height);
+    if (width > 0xFFFF || height > 0xFFFF)
+        return {};
+
+    Image image = { { width, height }, std::vector<uint8_t>(rgba.size() / 4 * 3), std::vector<uint8_t>(rgba.size() / 4) };
+    bool opaque = true;
+    for (size_t index = 0; index < image.alpha.size(); ++index) {
+        image.rgb[index * 3 + 0] = rgba[index * 4 + 0];
+        image.rgb[index * 3 + 1] = rgba[index * 4 + 1];
+        image.rgb[index * 3 + 2] = rgba[index * 4 + 2];
+        image.alpha[index] = rgba[index * 4 + 3];
+        opaque = opaque && image.alpha[index] == 255;
+    }
+    if (opaque)
+        image.alpha.clear();
+    return image;
+#else
+    std::fprintf(stderr, "%s: built without libpng, convert to PPM first\n", path.c_str());
+    return {};
+#endif
+}
+
+bool Tools::SavePng(const std::string& path, const Image& image) {
+#ifdef EVMS_HAVE_PNG
+    png_image png = {};
+    png.version = PNG_IMAGE_VERSION;
+    png.width = static_cast<png_uint_32>(image.dimensions.width);
+    png.height = static_cast<png_uint_32>(image.dimensions.height);
+    if (image.alpha.empty()) {
+        png.format = PNG_FORMAT_RGB;
+        return png_image_write_to_file(&png, path.c_str(), 0, image.rgb.data(), 0, nullptr);
+    }
+
+    png.format = PNG_FORMAT_RGBA;
+    std::vector<uint8_t> rgba(image.alpha.size() * 4);
+    for (size_t index = 0; index < image.alpha.size(); ++index) {
+        rgba[index * 4 + 0] = image.rgb[index * 3 + 0];
+        rgba[index * 4 + 1] = image.rgb[index * 3 + 1];
+        rgba[index * 4 + 2] = image.rgb[index * 3 + 2];
+        rgba[index * 4 + 3] = image.alpha[index];
+    }
+    return png_image_write_to_file(&png, path.c_str(), 0, rgba.data(), 0, nullptr);
+#else
+    std::fprintf(stderr, "%s: built without libpng, save as PPM instead\n", path.c_str());
+    return false;
+#endif
+}
+
+static bool IsPng(const std::string& path) {
+    std::string extension = path.substr(path.find_last_of('.') + 1);
+    for (char& character : extension)
+        character = static_cast<char>(std::tolower(static_cast<unsigned char>(character)));
+    return extension == "png";
+}
+
+Tools::Image Tools::LoadImage(const std::string& path) {
+    return IsPng(path) ? LoadPng(path) : LoadPpm(path);
+}
+
+bool Tools::SaveImage(const std::string& path, const Image& image) {
+    return IsPng(path) ? SavePng(path, image) : SavePpm(path, image);
+}
+
+std::vector<uint16_t> Tools::ToRgb565(const Image& image) {
+    std::vector<uint16_t> pixels(image.rgb.size() / 3);
+    Display::Color::FromRgb888Span(pixels.data(), image.rgb.data(), static_cast<int>(pixels.size()));
+    return pixels;
+}
+
+Tools::Image Tools::FromRgb565(const uint16_t* pixels, Display::Dimensions2D dimensions) {
+    Image image = { dimensions, std::vector<uint8_t>(static_cast<size_t>(dimensions.width) * dimensions.height * 3), {} };
+    for (size_t index = 0; index < image.rgb.size() / 3; ++index) {
+        uint16_t pixel = ToPanelOrder(pixels[index]);
+        uint8_t red = (pixel >> 11) & 0x1F, green = (pixel >> 5) & 0x3F, blue = pixel & 0x1F;
+        image.rgb[index * 3 + 0] = static_cast<uint8_t>((red << 3) | (red >> 2));
+        image.rgb[index * 3 + 1] = static_cast<uint8_t>((green << 2) | (green >> 4));
+        image.rgb[index * 3 + 2] = static_cast<uint8_t>((blue << 3) | (blue >> 2));
+    }
+    return image;
+}
+
+} // namespace evms
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "display/types.hpp"
+
+namespace evms {
+
+namespace Tools {
+    // 8-bit RGB image, rows top to bottom without padding
+    struct Image {
+        Display::Dimensions2D dimensions = {};
+        std::vector<uint8_t> rgb;
+        std::vector<uint8_t> alpha;     // Empty if the image is opaque
+
+        explicit operator bool() const {
+            return !rgb.empty();
+        }
+    };
+
+    // Binary PPM (P6) with 8-bit channels, empty image on error
+    Image LoadPpm(const std::string& path);
+
+    bool SavePpm(const std::string& path, const Image& image);
+
+    // Any bit depth and color type, alpha is kept. Empty image on error or if built without libpng.
+    Image LoadPng(const std::string& path);
+
+    // Alpha is kept if the image has it. False on error or if built without libpng.
+    bool SavePng(const std::string& path, const Image& image);
+
+    // PNG or PPM, picked by extension
+    Image LoadImage(const std::string& path);
+
+    bool SaveImage(const std::string& path, const Image& image);
+
+    // Pixels in panel byte order (big-endian RGB565), same as PixelMap literals
+    std::vector<uint16_t> ToRgb565(const Image& image);
+
+    Image FromRgb565(const uint16_t* pixels, Display::Dimensions2D dimensions);
+}
+
+} // namespace evms
@@ -0,0 +1,80 @@
+#include "pack_writer.hpp"
+
+#include <cstring>
+#include <fstream>
+
+#include "assets/rle.hpp"
+
+namespace evms {
+
+static size_t AlignUp(size_t value) {
+    return (value + Assets::DataAlignment - 1) / Assets::DataAlignment * Assets::DataAlignment;
+}
+
+bool Tools::PackWriter::add(const std::string& name, Display::Dimensions2D dimensions, Assets::PixelFormat format, uint8_t flags, std::vector<uint8_t> data) {
+    if (name.empty() || name.size() > Assets::NameSize)
+        return false;
+    for (const PendingAsset& asset : m_assets) {
+        if (std::strncmp(asset.entry.name, name.c_str(), Assets::NameSize) == 0)
+            return false;
+    }
+
+    PendingAsset asset = {};
+    std::memcpy(asset.entry.name, name.data(), name.size());
+    asset.entry.width = static_cast<uint16_t>(dimensions.width);
+    asset.entry.height = static_cast<uint16_t>(dimensions.height);
+    asset.entry.format = format;
+    asset.entry.flags = flags;
+    asset.data = std::move(data);
+    m_assets.push_back(std::move(asset));
+    return true;
+}
+
+bool Tools::PackWriter::addPixels(const std::string& name, Display::Dimensions2D dimensions, const std::vector<uint16_t>& pixels, bool allowCompression) {
+    const uint8_t* raw = reinterpret_cast<const uint8_t*>(pixels.data());
+    std::vector<uint8_t> data(raw, raw + pixels.size() * sizeof(uint16_t));
+    if (allowCompression) {
+        std::vector<uint8_t> compressed = Assets::Rle::Encode(pixels);
+        if (compressed.size() < data.size())
+            return add(name, dimensions, Assets::PixelFormat::Rgb565, Assets::CompressedFlag, std::move(compressed));
+    }
+    return add(name, dimensions, Assets::PixelFormat::Rgb565, 0, std::move(data));
+}
+
+std::vector<uint8_t> Tools::PackWriter::build() const {
+    size_t dataStart = AlignUp(sizeof(Assets::PackHeader) + m_assets.size() * sizeof(Assets::AssetEntry));
+    std::vector<Assets::AssetEntry> entries;
+    size_t offset = dataStart;
+    for (const PendingAsset& asset : m_assets) {
+        Assets::AssetEntry entry = asset.entry;
+        entry.offset = static_cast<uint32_t>(offset);
+        entry.size = static_cast<uint32_t>(asset.data.size());
+        entries.push_back(entry);
+        offset = AlignUp(offset + asset.data.size());
+    }
+
+    Assets::PackHeader header = {};
+    std::memcpy(header.magic, Assets::PackMagic, sizeof(header.magic));
+    header.version = Assets::PackVersion;
+    header.assetCount = static_cast<uint16_t>(m_assets.size());
+    header.totalSize = static_cast<uint32_t>(offset);
+
+    std::vector<uint8_t> pack(offset, 0);
+    std::memcpy(pack.data(), &header, sizeof(header));
+    if (!entries.empty())
+        std::memcpy(pack.data() + sizeof(header), entries.data(), entries.size() * sizeof(Assets::AssetEntry));
+    for (size_t index = 0; index < m_assets.size(); ++index) {
+        if (!m_assets[index].data.empty())
+            std::memcpy(pack.data() + entries[index].offset, m_assets[index].data.data(), m_assets[index].data.size());
+    }
+    return pack;
+}
+
+bool Tools::PackWriter::write(const std::string& path) const {
+    std::vector<uint8_t> pack = build();
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(pack.data()), pack.size());
+    return static_cast<bool>(file);
+}
+
+} // namespace evms
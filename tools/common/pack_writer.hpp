@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "assets/pack_format.hpp"
+#include "display/types.hpp"
+
+namespace evms {
+
+namespace Tools {
+    // Collects assets and writes them out in the format AssetPack reads
+    class PackWriter {
+    private:
+        struct PendingAsset {
+            Assets::AssetEntry entry;
+            std::vector<uint8_t> data;
+        };
+
+    private:
+        std::vector<PendingAsset> m_assets;
+
+    public:
+        // False if the name is too long or already taken
+        bool add(const std::string& name, Display::Dimensions2D dimensions, Assets::PixelFormat format, uint8_t flags, std::vector<uint8_t> data);
+
+        // RLE compresses pixels when that makes them smaller
+        bool addPixels(const std::string& name, Display::Dimensions2D dimensions, const std::vector<uint16_t>& pixels, bool allowCompression);
+
+        std::vector<uint8_t> build() const;
+
+        bool write(const std::string& path) const;
+
+    public:
+        inline size_t size() const {
+            return m_assets.size();
+        }
+    };
+}
+
+} // namespace evms
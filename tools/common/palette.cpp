@@ -0,0 +1,160 @@
+#include "palette.hpp"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <map>
+
+namespace evms {
+
+struct ColorCount {
+    std::array<int, 3> channels;    // 5, 6 and 5 bit
+    uint16_t pixel;                 // Panel byte order
+    size_t count;
+};
+
+static std::array<int, 3> Channels(uint16_t panelPixel) {
+    uint16_t pixel = static_cast<uint16_t>((panelPixel << 8) | (panelPixel >> 8));
+    return { (pixel >> 11) & 0x1F, (pixel >> 5) & 0x3F, pixel & 0x1F };
+}
+
+static uint16_t FromChannels(const std::array<int, 3>& channels) {
+    uint16_t pixel = static_cast<uint16_t>((channels[0] << 11) | (channels[1] << 5) | channels[2]);
+    return static_cast<uint16_t>((pixel << 8) | (pixel >> 8));
+}
+
+static int Distance(const std::array<int, 3>& first, const std::array<int, 3>& second) {
+    // Green has twice the levels, scale the other channels to match
+    int red = (first[0] - second[0]) * 2, green = first[1] - second[1], blue = (first[2] - second[2]) * 2;
+    return red * red + green * green + blue * blue;
+}
+
+size_t Tools::CountColors(const std::vector<uint16_t>& pixels) {
+    std::vector<uint16_t> sorted = pixels;
+    std::sort(sorted.begin(), sorted.end());
+    return std::unique(sorted.begin(), sorted.end()) - sorted.begin();
+}
+
+Tools::IndexedImage Tools::Quantize(const std::vector<uint16_t>& pixels, Display::Dimensions2D dimensions, int bitsPerPixel) {
+    std::map<uint16_t, size_t> histogram;
+    for (uint16_t pixel : pixels)
+        ++histogram[pixel];
+
+    std::vector<ColorCount> colors;
+    for (const auto& [pixel, count] : histogram)
+        colors.push_back({ Channels(pixel), pixel, count });
+
+    IndexedImage result = { dimensions, bitsPerPixel, {}, {}, true };
+    size_t maxColors = size_t(1) << bitsPerPixel;
+    if (colors.size() <= maxColors) {
+        for (const ColorCount& color : colors)
+            result.palette.push_back(color.pixel);
+    }
+    else {
+        // Median cut: keep splitting the box with the widest channel range at its weighted median
+        result.exact = false;
+        std::vector<std::pair<size_t, size_t>> boxes = { { 0, colors.size() } };
+        while (boxes.size() < maxColors) {
+            int bestBox = -1, bestChannel = 0, bestRange = 0;
+            for (size_t box = 0; box < boxes.size(); ++box) {
+                auto [begin, end] = boxes[box];
+                if (end - begin < 2)
+                    continue;
+                for (int channel = 0; channel < 3; ++channel) {
+                    auto [low, high] = std::minmax_element(colors.begin() + begin, colors.begin() + end, [channel](const ColorCount& first, const ColorCount& second) {
+                        return first.channels[channel] < second.channels[channel];
+                    });
+                    int range = (high->channels[channel] - low->channels[channel]) * (channel == 1 ? 1 : 2);
+                    if (range > bestRange) {
+                        bestBox = static_cast<int>(box);
+                        bestChannel = channel;
+                        bestRange = range;
+                    }
+                }
+            }
+            if (bestBox < 0)
+                break;
+
+            auto [begin, end] = boxes[bestBox];
+            std::sort(colors.begin() + begin, colors.begin() + end, [bestChannel](const ColorCount& first, const ColorCount& second) {
+                return first.channels[bestChannel] < second.channels[bestChannel];
+            });
+            size_t total = 0, half = 0, split = begin + 1;
+            for (size_t index = begin; index < end; ++index)
+                total += colors[index].count;
+            for (size_t index = begin; index < end - 1; ++index) {
+                half += colors[index].count;
+                split = index + 1;
+                if (half * 2 >= total)
+                    break;
+            }
+            boxes[bestBox] = { begin, split };
+            boxes.push_back({ split, end });
+        }
+
+        for (auto [begin, end] : boxes) {
+            std::array<size_t, 3> sums = {};
+            size_t total = 0;
+            for (size_t index = begin; index < end; ++index) {
+                for (int channel = 0; channel < 3; ++channel)
+                    sums[channel] += colors[index].channels[channel] * colors[index].count;
+                total += colors[index].count;
+            }
+            std::array<int, 3> average;
+            for (int channel = 0; channel < 3; ++channel)
+                average[channel] = static_cast<int>((sums[channel] + total / 2) / total);
+            result.palette.push_back(FromChannels(average));
+        }
+    }
+
+    // Nearest palette entry for every distinct color
+    std::map<uint16_t, uint8_t> mapping;
+    for (const auto& [pixel, count] : histogram) {
+        std::array<int, 3> channels = Channels(pixel);
+        int best = 0, bestDistance = std::numeric_limits<int>::max();
+        for (size_t index = 0; index < result.palette.size(); ++index) {
+            int distance = Distance(channels, Channels(result.palette[index]));
+            if (distance < bestDistance) {
+                best = static_cast<int>(index);
+                bestDistance = distance;
+            }
+        }
+        mapping[pixel] = static_cast<uint8_t>(best);
+    }
+
+    result.indices.reserve(pixels.size());
+    for (uint16_t pixel : pixels)
+        result.indices.push_back(mapping[pixel]);
+    return result;
+}
+
+std::vector<uint8_t> Tools::PackIndices(const IndexedImage& image) {
+    int width = image.dimensions.width, height = image.dimensions.height;
+    if (image.bitsPerPixel == 8)
+        return image.indices;
+
+    int rowBytes = (width + 1) / 2;
+    std::vector<uint8_t> packed(static_cast<size_t>(rowBytes) * height, 0);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            uint8_t index = image.indices[y * width + x] & 0x0F;
+            packed[y * rowBytes + x / 2] |= (x % 2) ? index : (index << 4);
+        }
+    }
+    return packed;
+}
+
+std::vector<uint8_t> Tools::PackMask(const std::vector<uint8_t>& alpha, Display::Dimensions2D dimensions) {
+    int width = dimensions.width, height = dimensions.height;
+    int rowBytes = (width + 7) / 8;
+    std::vector<uint8_t> packed(static_cast<size_t>(rowBytes) * height, 0);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (alpha.empty() || alpha[y * width + x] >= 128)
+                packed[y * rowBytes + x / 8] |= 0x80 >> (x % 8);
+        }
+    }
+    return packed;
+}
+
+} // namespace evms
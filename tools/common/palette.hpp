@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "display/types.hpp"
+
+namespace evms {
+
+namespace Tools {
+    struct IndexedImage {
+        Display::Dimensions2D dimensions = {};
+        int bitsPerPixel = 8;
+        std::vector<uint16_t> palette;      // Panel byte order
+        std::vector<uint8_t> indices;       // One per pixel, unpacked
+        bool exact = true;                  // False if colors had to be merged
+    };
+
+    size_t CountColors(const std::vector<uint16_t>& pixels);
+
+    /*
+    *   Reduce panel byte order RGB565 pixels to a palette of at most 2^bitsPerPixel colors.
+    *   Exact if the image has that few colors, median cut in RGB565 space otherwise.
+    */
+    IndexedImage Quantize(const std::vector<uint16_t>& pixels, Display::Dimensions2D dimensions, int bitsPerPixel);
+
+    // Rows packed as the asset pack stores them: 4-bit high nibble first or 8-bit, padded to a byte
+    std::vector<uint8_t> PackIndices(const IndexedImage& image);
+
+    // 1 bit per pixel, set where alpha is at least half, rows padded to a byte
+    std::vector<uint8_t> PackMask(const std::vector<uint8_t>& alpha, Display::Dimensions2D dimensions);
+}
+
+} // namespace evms
@@ -0,0 +1,84 @@
+#include "qoi_encoder.hpp"
+
+#include <array>
+
+#include "assets/qoi.hpp"
+
+namespace evms {
+
+namespace {
+    struct Color {
+        uint8_t r, g, b, a;
+
+        bool operator==(const Color&) const = default;
+    };
+}
+
+static void PutBigEndian32(std::vector<uint8_t>& output, uint32_t value) {
+    for (int shift = 24; shift >= 0; shift -= 8)
+        output.push_back(static_cast<uint8_t>(value >> shift));
+}
+
+std::vector<uint8_t> Tools::EncodeQoi(const Image& image) {
+    bool hasAlpha = !image.alpha.empty();
+    std::vector<uint8_t> output(Assets::Qoi::Magic, Assets::Qoi::Magic + sizeof(Assets::Qoi::Magic));
+    PutBigEndian32(output, image.dimensions.width);
+    PutBigEndian32(output, image.dimensions.height);
+    output.push_back(hasAlpha ? 4 : 3);
+    output.push_back(0);    // sRGB with linear alpha
+
+    std::array<Color, 64> index = {};
+    Color previous = { 0, 0, 0, 255 };
+    int run = 0;
+    size_t pixelCount = static_cast<size_t>(image.dimensions.width) * image.dimensions.height;
+    for (size_t pixelIndex = 0; pixelIndex < pixelCount; ++pixelIndex) {
+        const uint8_t* rgb = image.rgb.data() + pixelIndex * 3;
+        Color pixel = { rgb[0], rgb[1], rgb[2], hasAlpha ? image.alpha[pixelIndex] : uint8_t(255) };
+
+        if (pixel == previous) {
+            ++run;
+            if (run == 62 || pixelIndex + 1 == pixelCount) {
+                output.push_back(static_cast<uint8_t>(0xC0 | (run - 1)));
+                run = 0;
+            }
+            continue;
+        }
+        if (run) {
+            output.push_back(static_cast<uint8_t>(0xC0 | (run - 1)));
+            run = 0;
+        }
+
+        int hash = (pixel.r * 3 + pixel.g * 5 + pixel.b * 7 + pixel.a * 11) % 64;
+        if (index[hash] == pixel) {
+            output.push_back(static_cast<uint8_t>(hash));
+        }
+        else if (pixel.a != previous.a) {
+            output.insert(output.end(), { 0xFF, pixel.r, pixel.g, pixel.b, pixel.a });
+        }
+        else {
+            int8_t redDiff = static_cast<int8_t>(pixel.r - previous.r);
+            int8_t greenDiff = static_cast<int8_t>(pixel.g - previous.g);
+            int8_t blueDiff = static_cast<int8_t>(pixel.b - previous.b);
+            int8_t redGreen = static_cast<int8_t>(redDiff - greenDiff);
+            int8_t blueGreen = static_cast<int8_t>(blueDiff - greenDiff);
+
+            if (redDiff >= -2 && redDiff <= 1 && greenDiff >= -2 && greenDiff <= 1 && blueDiff >= -2 && blueDiff <= 1) {
+                output.push_back(static_cast<uint8_t>(0x40 | ((redDiff + 2) << 4) | ((greenDiff + 2) << 2) | (blueDiff + 2)));
+            }
+            else if (greenDiff >= -32 && greenDiff <= 31 && redGreen >= -8 && redGreen <= 7 && blueGreen >= -8 && blueGreen <= 7) {
+                output.push_back(static_cast<uint8_t>(0x80 | (greenDiff + 32)));
+                output.push_back(static_cast<uint8_t>(((redGreen + 8) << 4) | (blueGreen + 8)));
+            }
+            else {
+                output.insert(output.end(), { 0xFE, pixel.r, pixel.g, pixel.b });
+            }
+        }
+        index[hash] = pixel;
+        previous = pixel;
+    }
+
+    output.insert(output.end(), { 0, 0, 0, 0, 0, 0, 0, 1 });
+    return output;
+}
+
+} // namespace evms
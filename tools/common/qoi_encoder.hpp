@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common/image.hpp"
+
+namespace evms {
+
+namespace Tools {
+    // QOI as Assets::Qoi::Decoder reads it, 4 channels if the image has alpha
+    std::vector<uint8_t> EncodeQoi(const Image& image);
+}
+
+} // namespace evms
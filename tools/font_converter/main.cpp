@@ -0,0 +1,226 @@
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "common/image.hpp"
+#include "display/font.hpp"
+using namespace evms;
+
+/*
+*   Converts a sheet of glyph art into a Display::Font header:
+*       font_converter --header <out.hpp> --name <Name> [--namespace <name>]
+*                      [--cell <width>x<height>] [--bpp 1|4] [--first <char>] [--last <char>] <sheet>
+*   The sheet is a PNG/PPM grid of equally sized cells, one character per cell left to
+*   right and top to bottom starting at --first, as many columns as fit its width.
+*   Ink is dark on a light background, transparent pixels are background. Every
+*   glyph is trimmed to its ink box and advances by the cell width, the cell height
+*   is the line height. The command line is noted in the header.
+*   Defaults: --namespace Fonts --cell 6x8 --bpp 1 --first ' ' --last '~'
+*/
+
+namespace {
+    struct Options {
+        std::string headerPath;
+        std::string name;
+        std::string headerNamespace = "Fonts";
+        Display::Dimensions2D cell = { 6, 8 };
+        int bitsPerPixel = 1;
+        char first = ' ';
+        char last = '~';
+        std::string sheetPath;
+        std::string command;
+    };
+
+    struct Converted {
+        std::vector<uint8_t> bitmap;
+        std::vector<Display::Glyph> glyphs;
+        Display::Dimensions2D maxInk = {};
+    };
+}
+
+static bool ParseOptions(int argc, char** argv, Options& options) {
+    options.command = "font_converter";
+    for (int index = 1; index < argc; ++index)
+        options.command += std::string(" ") + argv[index];
+
+    for (int index = 1; index < argc; ++index) {
+        std::string argument = argv[index];
+        bool hasValue = index + 1 < argc;
+        if (argument == "--header" && hasValue)
+            options.headerPath = argv[++index];
+        else if (argument == "--name" && hasValue)
+            options.name = argv[++index];
+        else if (argument == "--namespace" && hasValue)
+            options.headerNamespace = argv[++index];
+        else if (argument == "--cell" && hasValue) {
+            if (std::sscanf(argv[++index], "%dx%d", &options.cell.width, &options.cell.height) != 2)
+                return false;
+        }
+        else if (argument == "--bpp" && hasValue)
+            options.bitsPerPixel = std::atoi(argv[++index]);
+        else if ((argument == "--first" || argument == "--last") && hasValue) {
+            std::string character = argv[++index];
+            if (character.size() != 1)
+                return false;
+            (argument == "--first" ? options.first : options.last) = character[0];
+        }
+        else if (options.sheetPath.empty() && !argument.starts_with("--"))
+            options.sheetPath = argument;
+        else
+            return false;
+    }
+
+    bool validCell = options.cell.width > 0 && options.cell.height > 0 && options.cell.width <= 127 && options.cell.height <= 127;
+    bool validBits = options.bitsPerPixel == 1 || options.bitsPerPixel == 4;
+    return !options.headerPath.empty() && !options.name.empty() && !options.sheetPath.empty() && validCell && validBits && options.first <= options.last;
+}
+
+// Coverage from 0 (background) to 255 (ink)
+static int Coverage(const Tools::Image& image, int x, int y) {
+    size_t index = static_cast<size_t>(y) * image.dimensions.width + x;
+    const uint8_t* rgb = &image.rgb[index * 3];
+    int luma = (rgb[0] * 77 + rgb[1] * 150 + rgb[2] * 29) >> 8;
+    int alpha = image.alpha.empty() ? 255 : image.alpha[index];
+    return (255 - luma) * alpha / 255;
+}
+
+static Converted Convert(const Options& options, const Tools::Image& image) {
+    Converted result;
+    int columns = image.dimensions.width / options.cell.width;
+    int maxValue = (1 << options.bitsPerPixel) - 1;
+    for (int character = options.first; character <= options.last; ++character) {
+        int index = character - options.first;
+        int cellX = index % columns * options.cell.width, cellY = index / columns * options.cell.height;
+
+        // Quantize the cell, then trim it to its ink box
+        std::vector<int> values(options.cell.width * options.cell.height);
+        int left = options.cell.width, top = options.cell.height, right = -1, bottom = -1;
+        for (int y = 0; y < options.cell.height; ++y) {
+            for (int x = 0; x < options.cell.width; ++x) {
+                int value = (Coverage(image, cellX + x, cellY + y) * maxValue + 127) / 255;
+                values[y * options.cell.width + x] = value;
+                if (value) {
+                    left = std::min(left, x);
+                    right = std::max(right, x);
+                    top = std::min(top, y);
+                    bottom = std::max(bottom, y);
+                }
+            }
+        }
+
+        Display::Glyph glyph = { static_cast<uint16_t>(result.bitmap.size()), 0, 0, 0, 0, static_cast<uint8_t>(options.cell.width) };
+        if (right >= 0) {
+            glyph.width = static_cast<uint8_t>(right - left + 1);
+            glyph.height = static_cast<uint8_t>(bottom - top + 1);
+            glyph.xOffset = static_cast<int8_t>(left);
+            glyph.yOffset = static_cast<int8_t>(top);
+            result.maxInk.width = std::max(result.maxInk.width, int(glyph.width));
+            result.maxInk.height = std::max(result.maxInk.height, int(glyph.height));
+
+            // One bit stream per glyph, most significant bits first
+            int bits = 0;
+            for (int y = top; y <= bottom; ++y) {
+                for (int x = left; x <= right; ++x, bits += options.bitsPerPixel) {
+                    if (bits % 8 == 0)
+                        result.bitmap.push_back(0);
+                    result.bitmap.back() |= static_cast<uint8_t>(values[y * options.cell.width + x] << (8 - options.bitsPerPixel - bits % 8));
+                }
+            }
+        }
+        result.glyphs.push_back(glyph);
+    }
+    return result;
+}
+
+static std::string CharacterComment(char character) {
+    switch (character) {
+        case '\'':  return "quote";
+        case '\\':  return "backslash";
+        default:    return std::string(1, character);
+    }
+}
+
+static bool WriteHeader(const Options& options, const Converted& font) {
+    std::ostringstream stream;
+    char buffer[64];
+    stream << "#pragma once\n\n";
+    stream << "#include \"display/font.hpp\"\n\n";
+    stream << "namespace evms {\n\nnamespace " << options.headerNamespace << " {\n";
+
+    bool ascii = options.first == ' ' && options.last == '~';
+    stream << "    // " << font.maxInk.width << 'x' << font.maxInk.height << (ascii ? " ASCII" : "") << " font in "
+        << options.cell.width << 'x' << options.cell.height << " cells, " << options.bitsPerPixel
+        << (options.bitsPerPixel == 1 ? " bit" : " bits") << " per pixel, generated from glyph art by tools/font_converter:\n";
+    stream << "    //     " << options.command << '\n';
+
+    stream << "    static constexpr uint8_t " << options.name << "Bitmap[] = {";
+    for (size_t index = 0; index < font.bitmap.size(); ++index) {
+        std::snprintf(buffer, sizeof(buffer), "0x%02X,", font.bitmap[index]);
+        stream << (index % 16 ? " " : "\n        ") << buffer;
+    }
+    stream << "\n    };\n\n";
+
+    stream << "    static constexpr Display::Glyph " << options.name << "Glyphs[] = {\n";
+    for (size_t index = 0; index < font.glyphs.size(); ++index) {
+        const Display::Glyph& glyph = font.glyphs[index];
+        std::snprintf(buffer, sizeof(buffer), "        { %3d, %d, %d, %d, %d, %d },   // ",
+            glyph.offset, glyph.width, glyph.height, glyph.xOffset, glyph.yOffset, glyph.advance);
+        stream << buffer << CharacterComment(static_cast<char>(options.first + index)) << '\n';
+    }
+    stream << "    };\n\n";
+
+    stream << "    static constexpr Display::Font " << options.name << " = {\n";
+    stream << "        .bitmap = " << options.name << "Bitmap,\n";
+    stream << "        .glyphs = " << options.name << "Glyphs,\n";
+    stream << "        .firstCharacter = " << (options.first == '\'' || options.first == '\\' ? "'\\" : "'") << options.first << "',\n";
+    stream << "        .lastCharacter = " << (options.last == '\'' || options.last == '\\' ? "'\\" : "'") << options.last << "',\n";
+    stream << "        .bitsPerPixel = " << options.bitsPerPixel << ",\n";
+    stream << "        .lineHeight = " << options.cell.height << ",\n";
+    stream << "    };\n}\n\n} // namespace evms\n";
+
+    std::ofstream file(options.headerPath);
+    file << stream.str();
+    return static_cast<bool>(file);
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0] << " --header <out.hpp> --name <Name> [--namespace <name>]\n";
+        std::cerr << "       [--cell <width>x<height>] [--bpp 1|4] [--first <char>] [--last <char>] <sheet.png|sheet.ppm>\n";
+        return 1;
+    }
+
+    Tools::Image sheet = Tools::LoadImage(options.sheetPath);
+    if (!sheet) {
+        std::cerr << options.sheetPath << ": couldn't load\n";
+        return 1;
+    }
+
+    int columns = sheet.dimensions.width / options.cell.width;
+    int rows = sheet.dimensions.height / options.cell.height;
+    int characters = options.last - options.first + 1;
+    if (columns * rows < characters) {
+        std::cerr << options.sheetPath << ": " << columns << 'x' << rows << " cells of " << options.cell.width << 'x' << options.cell.height
+            << " don't fit " << characters << " characters\n";
+        return 1;
+    }
+
+    Converted font = Convert(options, sheet);
+    if (font.bitmap.size() > UINT16_MAX) {
+        std::cerr << options.sheetPath << ": bitmap is larger than glyph offsets can address\n";
+        return 1;
+    }
+    std::printf("%-24s %3d glyphs, %dx%d ink box at most, %zu bitmap bytes\n",
+        options.name.c_str(), characters, font.maxInk.width, font.maxInk.height, font.bitmap.size());
+
+    if (!WriteHeader(options, font)) {
+        std::cerr << options.headerPath << ": couldn't write\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "display/controllers/ili9341.hpp"
+#include "display/frame_diff.hpp"
+#include "display/screen.hpp"
+#include "display/transports/mock.hpp"
+#include "main/bitmaps.hpp"
+#include "utility/random.hpp"
+using namespace evms;
+
+/*
+*   Measures frame diffing on the host:
+*       frame_diff_bench
+*   First checks Display::FindChangedSpan against a scalar scan on rows at every pair
+*   of alignments (odd offsets, a differing first or last pixel, single pixel rows).
+*   Then moves the DVD logo around a screen over the mock transport, clearing and
+*   redrawing it every frame, once with plain bounding box flushing and once with
+*   frame diffing, and reports bytes sent, their wire time and CPU time per frame.
+*   The logo alone sends exactly as many bytes either way: a diagonal move changes both
+*   ends of every row it touches, so its spans are as wide as the bounding box and
+*   diffing only adds CPU time. A second run also redraws a status bar that rarely
+*   changes every frame, the case diffing is meant for.
+*/
+
+namespace {
+    using Panel = Display::Controllers::Ili9341;
+    using Screen = Display::Screen<Panel, Display::Transports::Mock>;
+
+    constexpr int Frames = 2000;
+    constexpr int RowLength = 64;
+}
+
+static bool ScalarChangedSpan(const uint16_t* current, const uint16_t* previous, int length, int& first, int& last) {
+    first = 0;
+    while (first < length && current[first] == previous[first])
+        ++first;
+    if (first == length)
+        return false;
+    last = length - 1;
+    while (current[last] == previous[last])
+        --last;
+    return true;
+}
+
+// Returns the number of mismatching cases
+static int CheckChangedSpan() {
+    Utility::RandomEngine random(1);
+    std::vector<uint16_t> current(RowLength + 2), previous(RowLength + 2);
+    int cases = 0, mismatches = 0;
+    for (int currentOffset = 0; currentOffset < 2; ++currentOffset) {
+        for (int previousOffset = 0; previousOffset < 2; ++previousOffset) {
+            for (int length = 1; length <= RowLength; ++length) {
+                for (int changed = -3; changed < length; ++changed) {
+                    std::fill(current.begin(), current.end(), 0x1234);
+                    std::fill(previous.begin(), previous.end(), 0x1234);
+                    uint16_t* a = current.data() + currentOffset;
+                    uint16_t* b = previous.data() + previousOffset;
+
+                    // Special cases first: nothing, the first pixel, the last, then random spans
+                    if (changed == -2) {
+                        a[0] = 0xFFFF;
+                    }
+                    else if (changed == -1) {
+                        a[length - 1] = 0xFFFF;
+                    }
+                    else if (changed >= 0) {
+                        int end = changed + static_cast<int>(random.below(length - changed));
+                        for (int index = changed; index <= end; ++index)
+                            a[index] = random.below(4) ? 0xFFFF : 0x1234;
+                    }
+
+                    int first = -1, last = -1, expectedFirst = -1, expectedLast = -1;
+                    bool result = Display::FindChangedSpan(a, b, length, first, last);
+                    bool expected = ScalarChangedSpan(a, b, length, expectedFirst, expectedLast);
+                    ++cases;
+                    if (result != expected || (expected && (first != expectedFirst || last != expectedLast))) {
+                        if (++mismatches <= 5) {
+                            std::printf("mismatch: offsets %d/%d, length %d: got %d [%d, %d], expected %d [%d, %d]\n",
+                                currentOffset, previousOffset, length, result, first, last, expected, expectedFirst, expectedLast);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    std::printf("check:   %d FindChangedSpan cases, %s\n", cases, mismatches ? "MISMATCH" : "all match a scalar scan");
+    return mismatches;
+}
+
+struct Result {
+    double cpuMicroseconds = 0;
+    size_t bytes = 0;
+};
+
+static Result Run(bool frameDiffing, bool redrawBar) {
+    Screen screen;
+    screen.begin().get();
+    if (frameDiffing && !screen.setFrameDiffing(true)) {
+        std::printf("couldn't allocate the shadow buffer\n");
+        return {};
+    }
+    screen.render();
+
+    // Odd horizontal steps, so regions start on odd pixels half the time
+    Display::PixelView logo = Bitmaps::DvdLogo;
+    int rangeX = Screen::Dimensions.width - logo.width(), rangeY = Screen::Dimensions.height - logo.height();
+    int x = 0, y = 0, stepX = 3, stepY = 2;
+    screen.draw(x, y, logo);
+    screen.render();
+
+    Result result;
+    for (int frame = 0; frame < Frames; ++frame) {
+        screen.transport().clear();
+        auto start = std::chrono::steady_clock::now();
+        screen.clear(x, y, logo);
+        if (x + stepX < 0 || x + stepX > rangeX)
+            stepX = -stepX;
+        if (y + stepY < 0 || y + stepY > rangeY)
+            stepY = -stepY;
+        x += stepX;
+        y += stepY;
+        screen.draw(x, y, logo);
+        if (redrawBar) {
+            // Value in the middle of the bar changes every 50 frames
+            screen.fill(0, Screen::Dimensions.height - 12, { Screen::Dimensions.width, 12 }, 0x1F00);
+            screen.fill(100, Screen::Dimensions.height - 10, { 40, 8 }, (frame / 50) % 2 ? 0xFFFF : 0x00F8);
+        }
+        screen.render();
+        result.cpuMicroseconds += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        result.bytes += screen.transport().bytesWritten();
+    }
+    return result;
+}
+
+int main() {
+    int mismatches = CheckChangedSpan();
+
+    std::printf("%d frames of a %dx%d logo moving by (3, 2) px\n", Frames, Display::PixelView(Bitmaps::DvdLogo).width(), Display::PixelView(Bitmaps::DvdLogo).height());
+    std::printf("%-26s %12s %14s %13s\n", "", "bytes/frame", "wire ms/frame", "cpu us/frame");
+    for (bool redrawBar : { false, true }) {
+        for (bool frameDiffing : { false, true }) {
+            Result result = Run(frameDiffing, redrawBar);
+            double bytes = double(result.bytes) / Frames;
+            std::printf("%-12s %-13s %12.0f %14.3f %13.2f\n", redrawBar ? "logo + bar" : "logo", frameDiffing ? "diffing" : "bounding box",
+                bytes, bytes * 8 / Panel::Frequency * 1000, result.cpuMicroseconds / Frames);
+        }
+    }
+    return mismatches ? 1 : 0;
+}
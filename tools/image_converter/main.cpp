@@ -0,0 +1,289 @@
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "assets/pack_format.hpp"
+#include "assets/rle.hpp"
+#include "common/image.hpp"
+#include "common/pack_writer.hpp"
+#include "common/palette.hpp"
+#include "common/qoi_encoder.hpp"
+using namespace evms;
+
+/*
+*   Converts PNG/PPM images into firmware ready assets:
+*       image_converter (--header <out.hpp> [--namespace <name>] | --pack <out.bin>)
+*                       [--palette auto|4|8] [--rle | --qoi] [--mask] <name>=<image> ...
+*   --palette   Store as 4/8-bit palette indices. "auto" only does so when it's lossless.
+*   --rle       RLE compress RGB565 assets when that makes them smaller.
+*   --qoi       Store RGB565 assets as QOI images, decoded row by row with Assets::Qoi.
+*   --mask      Emit a 1-bit transparency mask (<name>_mask) for images with alpha.
+*   A size report goes to stdout.
+*/
+
+namespace {
+    struct Options {
+        std::string headerPath;
+        std::string packPath;
+        std::string headerNamespace = "Bitmaps";
+        std::string palette;        // Empty, "auto", "4" or "8"
+        bool rle = false;
+        bool qoi = false;
+        bool mask = false;
+        std::vector<std::pair<std::string, std::string>> inputs;
+    };
+
+    struct Converted {
+        std::string name;
+        Display::Dimensions2D dimensions;
+        Assets::PixelFormat format;
+        bool compressed = false;
+        std::vector<uint16_t> pixels;       // Rgb565, uncompressed
+        Tools::IndexedImage indexed;        // Indexed4/Indexed8
+        std::vector<uint8_t> data;          // Exactly what goes into a pack
+        std::vector<uint8_t> mask;          // Empty if none
+    };
+}
+
+static bool ParseOptions(int argc, char** argv, Options& options) {
+    for (int index = 1; index < argc; ++index) {
+        std::string argument = argv[index];
+        bool hasValue = index + 1 < argc;
+        if (argument == "--header" && hasValue)
+            options.headerPath = argv[++index];
+        else if (argument == "--pack" && hasValue)
+            options.packPath = argv[++index];
+        else if (argument == "--namespace" && hasValue)
+            options.headerNamespace = argv[++index];
+        else if (argument == "--palette" && hasValue)
+            options.palette = argv[++index];
+        else if (argument == "--rle")
+            options.rle = true;
+        else if (argument == "--qoi")
+            options.qoi = true;
+        else if (argument == "--mask")
+            options.mask = true;
+        else if (size_t equals = argument.find('='); equals != std::string::npos && equals > 0)
+            options.inputs.push_back({ argument.substr(0, equals), argument.substr(equals + 1) });
+        else
+            return false;
+    }
+
+    bool oneOutput = options.headerPath.empty() != options.packPath.empty();
+    bool validPalette = options.palette.empty() || options.palette == "auto" || options.palette == "4" || options.palette == "8";
+    return oneOutput && validPalette && !(options.rle && options.qoi) && !options.inputs.empty();
+}
+
+static std::vector<uint8_t> PaletteData(const Tools::IndexedImage& image) {
+    // Padded to 2^bitsPerPixel entries, the pack reader rejects anything else
+    std::vector<uint16_t> palette = image.palette;
+    palette.resize(size_t(1) << image.bitsPerPixel, 0);
+
+    std::vector<uint8_t> data;
+    data.push_back(static_cast<uint8_t>(palette.size()));
+    data.push_back(static_cast<uint8_t>(palette.size() >> 8));
+    for (uint16_t color : palette) {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&color);
+        data.insert(data.end(), bytes, bytes + 2);
+    }
+    std::vector<uint8_t> indices = Tools::PackIndices(image);
+    data.insert(data.end(), indices.begin(), indices.end());
+    return data;
+}
+
+static Converted Convert(const Options& options, const std::string& name, const Tools::Image& image) {
+    Converted result = { name, image.dimensions, Assets::PixelFormat::Rgb565, false, {}, {}, {}, {} };
+    result.pixels = Tools::ToRgb565(image);
+
+    if (options.mask && !image.alpha.empty()) {
+        result.mask = Tools::PackMask(image.alpha, image.dimensions);
+
+        // Hidden pixels don't matter, making them uniform helps palettes and RLE
+        for (size_t index = 0; index < result.pixels.size(); ++index) {
+            if (image.alpha[index] < 128)
+                result.pixels[index] = 0x0000;
+        }
+    }
+
+    int bitsPerPixel = 0;
+    size_t colors = Tools::CountColors(result.pixels);
+    if (options.palette == "auto")
+        bitsPerPixel = colors <= 16 ? 4 : colors <= 256 ? 8 : 0;
+    else if (!options.palette.empty())
+        bitsPerPixel = std::stoi(options.palette);
+
+    if (bitsPerPixel) {
+        result.format = bitsPerPixel == 4 ? Assets::PixelFormat::Indexed4 : Assets::PixelFormat::Indexed8;
+        result.indexed = Tools::Quantize(result.pixels, image.dimensions, bitsPerPixel);
+        result.data = PaletteData(result.indexed);
+        return result;
+    }
+
+    if (options.qoi) {
+        // Alpha lives in the mask, hidden pixels are made uniform the same way
+        Tools::Image opaque = { image.dimensions, image.rgb, {} };
+        for (size_t index = 0; index < image.alpha.size() && !result.mask.empty(); ++index) {
+            if (image.alpha[index] < 128)
+                std::fill_n(opaque.rgb.begin() + index * 3, 3, 0);
+        }
+        result.format = Assets::PixelFormat::Qoi;
+        result.data = Tools::EncodeQoi(opaque);
+        return result;
+    }
+
+    const uint8_t* raw = reinterpret_cast<const uint8_t*>(result.pixels.data());
+    result.data.assign(raw, raw + result.pixels.size() * sizeof(uint16_t));
+    if (options.rle) {
+        std::vector<uint8_t> compressed = Assets::Rle::Encode(result.pixels);
+        if (compressed.size() < result.data.size()) {
+            result.data = std::move(compressed);
+            result.compressed = true;
+        }
+    }
+    return result;
+}
+
+static const char* FormatName(Assets::PixelFormat format) {
+    switch (format) {
+        case Assets::PixelFormat::Indexed4: return "indexed4";
+        case Assets::PixelFormat::Indexed8: return "indexed8";
+        case Assets::PixelFormat::Mask1:    return "mask1";
+        case Assets::PixelFormat::Qoi:      return "qoi";
+        default:                            return "rgb565";
+    }
+}
+
+static void Report(const Converted& asset) {
+    size_t raw = asset.pixels.size() * sizeof(uint16_t);
+    size_t total = asset.data.size() + asset.mask.size();
+    std::printf(
+        "%-24s %4dx%-4d %-8s%s %7zu -> %7zu bytes (%3zu%%)%s%s\n",
+        asset.name.c_str(), asset.dimensions.width, asset.dimensions.height,
+        FormatName(asset.format), asset.compressed ? "+rle" : "    ",
+        raw, total, raw ? total * 100 / raw : 0,
+        asset.mask.empty() ? "" : ", with mask",
+        (asset.format == Assets::PixelFormat::Indexed4 || asset.format == Assets::PixelFormat::Indexed8) && !asset.indexed.exact ? ", lossy palette" : ""
+    );
+}
+
+template <typename Value>
+static void WriteArray(std::ostream& stream, const std::vector<Value>& values, size_t perLine, int indent = 8) {
+    char buffer[8];
+    for (size_t index = 0; index < values.size(); ++index) {
+        if (index % perLine == 0)
+            stream << (index ? "\n" : "") << std::string(indent, ' ');
+        std::snprintf(buffer, sizeof(buffer), sizeof(Value) == 2 ? "0x%04X" : "0x%02X", static_cast<unsigned>(values[index]));
+        bool lineEnd = index + 1 == values.size() || index % perLine == perLine - 1;
+        stream << buffer << (lineEnd ? "," : ", ");
+    }
+    stream << '\n';
+}
+
+static bool WriteHeader(const Options& options, const std::vector<Converted>& assets) {
+    std::ostringstream stream;
+    stream << "#pragma once\n\n";
+    stream << "// Generated by tools/image_converter, do not edit by hand\n\n";
+    stream << "#include <cstdint>\n\n";
+    stream << "#include \"display/indexed_pixel_map.hpp\"\n";
+    stream << "#include \"display/types.hpp\"\n\n";
+    stream << "namespace evms {\n\nnamespace " << options.headerNamespace << " {\n";
+
+    for (size_t index = 0; index < assets.size(); ++index) {
+        const Converted& asset = assets[index];
+        int width = asset.dimensions.width, height = asset.dimensions.height;
+        if (index)
+            stream << '\n';
+
+        if (asset.format == Assets::PixelFormat::Qoi) {
+            stream << "    // " << width << 'x' << height << ", decode with Assets::Qoi\n";
+            stream << "    static constexpr uint8_t " << asset.name << "Qoi[] = {\n";
+            WriteArray(stream, asset.data, 16);
+            stream << "    };\n";
+        }
+        else if (asset.format != Assets::PixelFormat::Rgb565) {
+            int bitsPerPixel = asset.format == Assets::PixelFormat::Indexed4 ? 4 : 8;
+            stream << "    static constexpr Display::IndexedPixelMap<{ " << width << ", " << height << " }, " << bitsPerPixel << "> " << asset.name << " {\n";
+            stream << "        {\n";
+            WriteArray(stream, asset.indexed.palette, 16, 12);
+            stream << "        },\n        {\n";
+            WriteArray(stream, Tools::PackIndices(asset.indexed), 16, 12);
+            stream << "        }\n    };\n";
+        }
+        else if (asset.compressed) {
+            stream << "    // " << width << 'x' << height << ", decode with Assets::Rle\n";
+            stream << "    static constexpr Display::Dimensions2D " << asset.name << "Dimensions = { " << width << ", " << height << " };\n";
+            stream << "    static constexpr uint8_t " << asset.name << "Rle[] = {\n";
+            WriteArray(stream, asset.data, 16);
+            stream << "    };\n";
+        }
+        else {
+            stream << "    static constexpr Display::PixelMap<{ " << width << ", " << height << " }> " << asset.name << " {{\n";
+            WriteArray(stream, asset.pixels, static_cast<size_t>(std::min(width, 16)));
+            stream << "    }};\n";
+        }
+
+        if (!asset.mask.empty()) {
+            stream << "    // 1 bit per pixel, rows padded to a byte, set means opaque\n";
+            stream << "    static constexpr uint8_t " << asset.name << "Mask[] = {\n";
+            WriteArray(stream, asset.mask, 16);
+            stream << "    };\n";
+        }
+    }
+    stream << "}\n\n} // namespace evms\n";
+
+    std::ofstream file(options.headerPath);
+    file << stream.str();
+    return static_cast<bool>(file);
+}
+
+static bool WritePack(const Options& options, const std::vector<Converted>& assets) {
+    Tools::PackWriter writer;
+    for (const Converted& asset : assets) {
+        uint8_t flags = asset.compressed ? Assets::CompressedFlag : 0;
+        if (!writer.add(asset.name, asset.dimensions, asset.format, flags, asset.data)) {
+            std::cerr << asset.name << ": name is longer than " << Assets::NameSize << " characters or taken\n";
+            return false;
+        }
+        if (!asset.mask.empty() && !writer.add(asset.name + "_mask", asset.dimensions, Assets::PixelFormat::Mask1, 0, asset.mask)) {
+            std::cerr << asset.name << "_mask: name is longer than " << Assets::NameSize << " characters or taken\n";
+            return false;
+        }
+    }
+    return writer.write(options.packPath);
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0] << " (--header <out.hpp> [--namespace <name>] | --pack <out.bin>)\n";
+        std::cerr << "       [--palette auto|4|8] [--rle | --qoi] [--mask] <name>=<image.png|image.ppm> ...\n";
+        return 1;
+    }
+
+    std::vector<Converted> assets;
+    size_t rawTotal = 0, outputTotal = 0;
+    for (const auto& [name, path] : options.inputs) {
+        Tools::Image image = Tools::LoadImage(path);
+        if (!image) {
+            std::cerr << path << ": couldn't load\n";
+            return 1;
+        }
+
+        assets.push_back(Convert(options, name, image));
+        Report(assets.back());
+        rawTotal += assets.back().pixels.size() * sizeof(uint16_t);
+        outputTotal += assets.back().data.size() + assets.back().mask.size();
+    }
+    std::printf("%-24s %9s %8s %7zu -> %7zu bytes\n", "Total", "", "", rawTotal, outputTotal);
+
+    bool written = options.headerPath.empty() ? WritePack(options, assets) : WriteHeader(options, assets);
+    if (!written) {
+        std::cerr << (options.headerPath.empty() ? options.packPath : options.headerPath) << ": couldn't write\n";
+        return 1;
+    }
+    return 0;
+}
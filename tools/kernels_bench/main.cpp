@@ -0,0 +1,187 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+#include "display/kernels.hpp"
+#include "utility/random.hpp"
+using namespace evms;
+
+/*
+*   Checks and measures the pixel kernels on the host:
+*       kernels_bench
+*   Runs fill, flips, rotations, scaling and blends (alpha and 50%) on regions in three
+*   layouts: aligned with even sizes and strides (the pair fast paths), both pointers
+*   off by one pixel with odd sizes and strides, and pointers of mixed alignment.
+*   Every result is compared with a naive scalar loop working on native RGB565 fields,
+*   then both are timed, in millions of pixels per second. Host compilers vectorize
+*   the scalar loops, so speedups here say little about the ESP32; the check is
+*   what matters, the times rank changes to a kernel against each other.
+*/
+
+namespace {
+    constexpr int BufferStride = 800;
+    constexpr int BufferRows = 800;
+    constexpr double MinimumSeconds = 0.05;
+    constexpr uint8_t Alpha = 100;
+
+    struct Layout {
+        const char* name;
+        int width;
+        int height;
+        int destinationOffset;
+        int sourceOffset;
+        int destinationStride;
+        int sourceStride;
+    };
+
+    constexpr Layout Layouts[] = {
+        { "aligned", 240, 64, 0, 0, 720, 242 },
+        { "unaligned", 239, 63, 1, 1, 719, 241 },
+        { "mixed", 239, 63, 0, 1, 720, 241 },
+    };
+
+    // Destination, its stride, source, its stride, width, height
+    using Kernel = std::function<void(uint16_t*, int, const uint16_t*, int, int, int)>;
+
+    struct Case {
+        const char* name;
+        Kernel kernel;
+        Kernel reference;
+    };
+}
+
+static uint16_t Swap(uint16_t pixel) {
+    return static_cast<uint16_t>((pixel >> 8) | (pixel << 8));
+}
+
+// Channel by channel in native RGB565, the way the kernels are specified
+template <typename Channel>
+static uint16_t PerChannel(uint16_t destination, uint16_t source, Channel channel) {
+    destination = Swap(destination);
+    source = Swap(source);
+    int red = channel(destination >> 11, source >> 11);
+    int green = channel((destination >> 5) & 0x3F, (source >> 5) & 0x3F);
+    int blue = channel(destination & 0x1F, source & 0x1F);
+    return Swap(static_cast<uint16_t>((red << 11) | (green << 5) | blue));
+}
+
+static std::vector<Case> Cases() {
+    constexpr uint16_t Color = 0x1F80;
+    std::vector<Case> cases;
+    cases.push_back({ "fill",
+        [](uint16_t* d, int ds, const uint16_t*, int, int w, int h) { Display::Kernels::Fill(d, w, h, ds, Color); },
+        [](uint16_t* d, int ds, const uint16_t*, int, int w, int h) {
+            for (int y = 0; y < h; ++y)
+                for (int x = 0; x < w; ++x)
+                    d[y * ds + x] = Color;
+        } });
+    cases.push_back({ "flip horizontal",
+        [](uint16_t* d, int ds, const uint16_t*, int, int w, int h) { Display::Kernels::FlipHorizontal(d, w, h, ds); },
+        [](uint16_t* d, int ds, const uint16_t*, int, int w, int h) {
+            for (int y = 0; y < h; ++y)
+                for (int x = 0; x < w / 2; ++x)
+                    std::swap(d[y * ds + x], d[y * ds + w - 1 - x]);
+        } });
+    cases.push_back({ "flip vertical",
+        [](uint16_t* d, int ds, const uint16_t*, int, int w, int h) { Display::Kernels::FlipVertical(d, w, h, ds); },
+        [](uint16_t* d, int ds, const uint16_t*, int, int w, int h) {
+            for (int y = 0; y < h / 2; ++y)
+                for (int x = 0; x < w; ++x)
+                    std::swap(d[y * ds + x], d[(h - 1 - y) * ds + x]);
+        } });
+    cases.push_back({ "rotate 180",
+        [](uint16_t* d, int ds, const uint16_t*, int, int w, int h) { Display::Kernels::Rotate180(d, w, h, ds); },
+        [](uint16_t* d, int ds, const uint16_t*, int, int w, int h) {
+            for (int index = 0; index < w * h / 2; ++index) {
+                int x = index % w, y = index / w;
+                std::swap(d[y * ds + x], d[(h - 1 - y) * ds + (w - 1 - x)]);
+            }
+        } });
+    cases.push_back({ "rotate 90",
+        [](uint16_t* d, int ds, const uint16_t* s, int ss, int w, int h) { Display::Kernels::Rotate90(s, w, h, ss, d, ds); },
+        [](uint16_t* d, int ds, const uint16_t* s, int ss, int w, int h) {
+            for (int y = 0; y < h; ++y)
+                for (int x = 0; x < w; ++x)
+                    d[x * ds + (h - 1 - y)] = s[y * ss + x];
+        } });
+    cases.push_back({ "rotate 270",
+        [](uint16_t* d, int ds, const uint16_t* s, int ss, int w, int h) { Display::Kernels::Rotate270(s, w, h, ss, d, ds); },
+        [](uint16_t* d, int ds, const uint16_t* s, int ss, int w, int h) {
+            for (int y = 0; y < h; ++y)
+                for (int x = 0; x < w; ++x)
+                    d[(w - 1 - x) * ds + y] = s[y * ss + x];
+        } });
+    for (int factor : { 2, 3 }) {
+        cases.push_back({ factor == 2 ? "scale x2" : "scale x3",
+            [factor](uint16_t* d, int ds, const uint16_t* s, int ss, int w, int h) { Display::Kernels::Scale(s, w, h, ss, d, ds, factor); },
+            [factor](uint16_t* d, int ds, const uint16_t* s, int ss, int w, int h) {
+                for (int y = 0; y < h * factor; ++y)
+                    for (int x = 0; x < w * factor; ++x)
+                        d[y * ds + x] = s[(y / factor) * ss + (x / factor)];
+            } });
+    }
+    cases.push_back({ "blend 50%",
+        [](uint16_t* d, int ds, const uint16_t* s, int ss, int w, int h) { Display::Kernels::Blend50(d, ds, s, ss, w, h); },
+        [](uint16_t* d, int ds, const uint16_t* s, int ss, int w, int h) {
+            for (int y = 0; y < h; ++y)
+                for (int x = 0; x < w; ++x)
+                    d[y * ds + x] = PerChannel(d[y * ds + x], s[y * ss + x], [](int a, int b) { return (a + b) >> 1; });
+        } });
+    cases.push_back({ "blend alpha",
+        [](uint16_t* d, int ds, const uint16_t* s, int ss, int w, int h) { Display::Kernels::Blend(d, ds, s, ss, w, h, Alpha); },
+        [](uint16_t* d, int ds, const uint16_t* s, int ss, int w, int h) {
+            // Alpha is quantized to 1/32 steps
+            int alpha = (Alpha + 4) >> 3;
+            for (int y = 0; y < h; ++y)
+                for (int x = 0; x < w; ++x)
+                    d[y * ds + x] = PerChannel(d[y * ds + x], s[y * ss + x], [alpha](int a, int b) { return (b * alpha + a * (32 - alpha)) >> 5; });
+        } });
+    return cases;
+}
+
+// Millions of source pixels per second
+static double Measure(const Kernel& kernel, std::vector<uint16_t>& destination, const std::vector<uint16_t>& source, const Layout& layout) {
+    long long pixels = 0;
+    double seconds = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (seconds < MinimumSeconds) {
+        for (int repeat = 0; repeat < 20; ++repeat) {
+            kernel(destination.data() + layout.destinationOffset, layout.destinationStride,
+                source.data() + layout.sourceOffset, layout.sourceStride, layout.width, layout.height);
+        }
+        pixels += 20LL * layout.width * layout.height;
+        asm volatile("" : : "r"(destination.data()) : "memory");
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    return pixels / seconds / 1e6;
+}
+
+int main() {
+    Utility::RandomEngine random(1);
+    std::vector<uint16_t> source(BufferStride * BufferRows), initial(BufferStride * BufferRows);
+    for (uint16_t& pixel : source)
+        pixel = static_cast<uint16_t>(random());
+    for (uint16_t& pixel : initial)
+        pixel = static_cast<uint16_t>(random());
+
+    int mismatches = 0;
+    std::printf("%-16s %-10s %12s %12s %8s  %s\n", "kernel", "layout", "Mpx/s", "scalar", "speedup", "check");
+    for (const Case& test : Cases()) {
+        for (const Layout& layout : Layouts) {
+            std::vector<uint16_t> result = initial, expected = initial;
+            test.kernel(result.data() + layout.destinationOffset, layout.destinationStride,
+                source.data() + layout.sourceOffset, layout.sourceStride, layout.width, layout.height);
+            test.reference(expected.data() + layout.destinationOffset, layout.destinationStride,
+                source.data() + layout.sourceOffset, layout.sourceStride, layout.width, layout.height);
+            bool matches = result == expected;
+            mismatches += !matches;
+
+            double fast = Measure(test.kernel, result, source, layout);
+            double scalar = Measure(test.reference, expected, source, layout);
+            std::printf("%-16s %-10s %12.1f %12.1f %7.2fx  %s\n", test.name, layout.name, fast, scalar, fast / scalar, matches ? "ok" : "MISMATCH");
+        }
+    }
+    return mismatches ? 1 : 0;
+}
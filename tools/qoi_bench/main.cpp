@@ -0,0 +1,119 @@
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "assets/qoi.hpp"
+#include "common/image.hpp"
+#include "common/qoi_encoder.hpp"
+#include "display/controllers/ili9341.hpp"
+#include "display/screen.hpp"
+#include "display/transports/mock.hpp"
+using namespace evms;
+
+/*
+*   Measures QOI decoding on the host:
+*       qoi_bench [<image.png|image.ppm> ...]
+*   Without arguments a smooth gradient (photo-like) and flat UI-like art are used.
+*   Every image is encoded, decoded row by row and checked against a direct RGB565
+*   conversion, then streamed through Screen::stream into a mock transport and checked
+*   again. Throughput is reported in MB/s of RGB565 output.
+*/
+
+namespace {
+    using Screen = Display::Screen<Display::Controllers::Ili9341, Display::Transports::Mock>;
+
+    constexpr double MinimumSeconds = 0.3;
+}
+
+static Tools::Image Synthetic(bool flat) {
+    Tools::Image image;
+    image.dimensions = Screen::Dimensions;
+    image.rgb.resize(image.dimensions.width * image.dimensions.height * 3);
+    uint32_t noise = 1;
+    for (int y = 0; y < image.dimensions.height; ++y) {
+        for (int x = 0; x < image.dimensions.width; ++x) {
+            uint8_t* pixel = image.rgb.data() + (y * image.dimensions.width + x) * 3;
+            noise = noise * 1103515245 + 12345;
+            if (flat) {
+                bool button = (x / 60 + y / 40) % 3 == 0;
+                pixel[0] = button ? 40 : 230;
+                pixel[1] = button ? 120 : 230;
+                pixel[2] = button ? 200 : 230;
+            }
+            else {
+                pixel[0] = static_cast<uint8_t>(x + ((noise >> 16) & 3));
+                pixel[1] = static_cast<uint8_t>(y * 255 / image.dimensions.height);
+                pixel[2] = static_cast<uint8_t>((x + y) / 3 + ((noise >> 20) & 7));
+            }
+        }
+    }
+    return image;
+}
+
+static bool Bench(const std::string& name, const Tools::Image& image) {
+    std::vector<uint8_t> encoded = Tools::EncodeQoi(image);
+    std::vector<uint16_t> expected = Tools::ToRgb565(image);
+    Display::Dimensions2D dimensions = image.dimensions;
+
+    std::vector<uint16_t> decoded(expected.size());
+    Assets::Qoi::Decoder decoder(encoded);
+    if (!decoder.decode({ decoded.data(), dimensions }) || decoded != expected) {
+        std::printf("%-16s decode MISMATCH\n", name.c_str());
+        return false;
+    }
+
+    int runs = 0;
+    auto start = std::chrono::steady_clock::now();
+    double seconds = 0;
+    while (seconds < MinimumSeconds) {
+        decoder.restart();
+        decoder.decode({ decoded.data(), dimensions });
+        ++runs;
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    double megabytes = expected.size() * sizeof(uint16_t) * double(runs) / 1e6;
+
+    Assets::Qoi::Image whole = Assets::Qoi::DecodeImage(encoded);
+    bool wholeMatches = whole && std::memcmp(whole.pixels.get(), expected.data(), expected.size() * sizeof(uint16_t)) == 0;
+
+    // Streamed to the panel: pixels on the wire must be the image, row after row
+    bool streamMatches = true;
+    if (dimensions.width <= Screen::Dimensions.width && dimensions.height <= Screen::Dimensions.height) {
+        Screen screen;
+        screen.begin().get();
+        screen.transport().clear();
+        decoder.restart();
+        bool streamed = screen.stream({ 0, 0, dimensions.width, dimensions.height }, [&decoder](uint16_t* row, int) {
+            return decoder.decodeRow(row);
+        });
+
+        const std::vector<uint8_t>& sent = screen.transport().writes().back().bytes;
+        streamMatches = streamed && sent.size() == expected.size() * sizeof(uint16_t) && std::memcmp(sent.data(), expected.data(), sent.size()) == 0;
+    }
+
+    std::printf("%-16s %4dx%-4d %7zu -> %7zu bytes (%3zu%%) %8.1f MB/s %s\n",
+        name.c_str(), dimensions.width, dimensions.height, expected.size() * sizeof(uint16_t), encoded.size(),
+        encoded.size() * 100 / (expected.size() * sizeof(uint16_t)), megabytes / seconds,
+        wholeMatches && streamMatches ? "ok" : "STREAM/IMAGE MISMATCH");
+    return wholeMatches && streamMatches;
+}
+
+int main(int argc, char** argv) {
+    bool ok = true;
+    if (argc == 1) {
+        ok &= Bench("gradient", Synthetic(false));
+        ok &= Bench("flat", Synthetic(true));
+    }
+    for (int index = 1; index < argc; ++index) {
+        Tools::Image image = Tools::LoadImage(argv[index]);
+        if (!image) {
+            std::cerr << argv[index] << ": couldn't load\n";
+            return 1;
+        }
+        ok &= Bench(argv[index], image);
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "utility/random.hpp"
+using namespace evms;
+
+/*
+*   Compares random number generation on the host:
+*       random_bench
+*   The previous implementation (a shared std::mt19937 with a <random> distribution
+*   constructed per call) against Utility::RandomEngine drawing one value at a time
+*   and in batches, for bounded integers and floats, in millions of draws per second.
+*   Also buckets a few million bounded draws from each to check they stay uniform,
+*   with a chi-squared statistic that should land near the bucket count.
+*/
+
+namespace {
+    constexpr size_t BatchSize = 256;
+    constexpr double MinimumSeconds = 0.3;
+    constexpr int Buckets = 240;
+}
+
+// Utility::RandomInteger and RandomFloat before RandomEngine
+namespace Previous {
+    std::mt19937& Generator() {
+        static std::mt19937 generator(12345);
+        return generator;
+    }
+
+    int RandomInteger(int min, int max) {
+        return std::uniform_int_distribution(min, max)(Generator());
+    }
+
+    float RandomFloat(float min, float max) {
+        return std::uniform_real_distribution(min, max)(Generator());
+    }
+}
+
+// Fill calls batch(values) until enough time has passed, returns millions of values per second
+template <typename T, typename Batch>
+static double MillionsPerSecond(Batch batch) {
+    std::vector<T> values(BatchSize);
+    long long count = 0;
+    double seconds = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (seconds < MinimumSeconds) {
+        for (int repeat = 0; repeat < 1000; ++repeat)
+            batch(values);
+        count += 1000LL * BatchSize;
+        asm volatile("" : : "r"(values.data()) : "memory");
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    return count / seconds / 1e6;
+}
+
+template <typename Draw>
+static double ChiSquared(Draw draw) {
+    constexpr int Draws = 4'800'000;
+    std::vector<int> counts(Buckets);
+    for (int index = 0; index < Draws; ++index)
+        ++counts[draw()];
+
+    double expected = double(Draws) / Buckets, sum = 0;
+    for (int count : counts)
+        sum += (count - expected) * (count - expected) / expected;
+    return sum;
+}
+
+int main() {
+    Utility::RandomEngine engine(12345);
+
+    std::printf("%-34s %10s\n", "", "Mdraws/s");
+    std::printf("%-34s %10.1f\n", "integer, mt19937 + distribution", MillionsPerSecond<int>([](std::vector<int>& values) {
+        for (int& value : values)
+            value = Previous::RandomInteger(0, Buckets - 1);
+    }));
+    std::printf("%-34s %10.1f\n", "integer, RandomEngine::integer", MillionsPerSecond<int>([&engine](std::vector<int>& values) {
+        for (int& value : values)
+            value = engine.integer(0, Buckets - 1);
+    }));
+    std::printf("%-34s %10.1f\n", "integer, RandomEngine::fillIntegers", MillionsPerSecond<int>([&engine](std::vector<int>& values) {
+        engine.fillIntegers(values, 0, Buckets - 1);
+    }));
+    std::printf("%-34s %10.1f\n", "float, mt19937 + distribution", MillionsPerSecond<float>([](std::vector<float>& values) {
+        for (float& value : values)
+            value = Previous::RandomFloat(-1.0f, 1.0f);
+    }));
+    std::printf("%-34s %10.1f\n", "float, RandomEngine::real", MillionsPerSecond<float>([&engine](std::vector<float>& values) {
+        for (float& value : values)
+            value = engine.real(-1.0f, 1.0f);
+    }));
+    std::printf("%-34s %10.1f\n", "float, RandomEngine::fillFloats", MillionsPerSecond<float>([&engine](std::vector<float>& values) {
+        engine.fillFloats(values, -1.0f, 1.0f);
+    }));
+
+    std::printf("\nchi-squared over %d buckets (expect about %d)\n", Buckets, Buckets - 1);
+    std::printf("%-34s %10.1f\n", "mt19937 + distribution", ChiSquared([]() {
+        return Previous::RandomInteger(0, Buckets - 1);
+    }));
+    std::printf("%-34s %10.1f\n", "RandomEngine::integer", ChiSquared([&engine]() {
+        return engine.integer(0, Buckets - 1);
+    }));
+
+    std::printf("\nstate: mt19937 %zu bytes, RandomEngine %zu bytes\n", sizeof(std::mt19937), sizeof(Utility::RandomEngine));
+    return 0;
+}
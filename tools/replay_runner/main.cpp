@@ -0,0 +1,281 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "app/demo.hpp"
+#include "assets/asset_pack.hpp"
+#include "assets/pack_storage.hpp"
+#include "display/controllers/ili9341.hpp"
+#include "display/latency_probe.hpp"
+#include "display/screen.hpp"
+#include "diagnostics/snapshot_stream.hpp"
+#include "display/transports/mock.hpp"
+#include "replay/session_log.hpp"
+#include "utility/random.hpp"
+using namespace evms;
+
+/*
+*   Replays a recorded session of the demo loop on the host:
+*       replay_runner <session> [--pack <assets.bin>] [--diff] [--overhead <us>]
+*                     [--snapshots <capture> [--baud <rate>]]
+*   Session is a binary log or console output holding the "replay: " dump lines.
+*   Pass the asset pack that was flashed if the logo came from it, start positions
+*   depend on the logo's size. The same App::Demo runs against a screen over the mock
+*   transport, fed the recorded touch samples frame by frame, and reports per-frame
+*   CPU time, bytes flushed (and their wire time at the panel's SPI clock) and heap
+*   allocations, plus a checksum of the final framebuffer to confirm the replay is
+*   faithful to the recording and deterministic between runs.
+*   Touch-to-photon latency is simulated with Display::LatencyProbe on model time:
+*   a frame starts at its recorded tick, the PENIRQ edge of a press falls anywhere
+*   in the interval before it, and time advances only by the mock transport's wire
+*   model (host CPU time says little about the device's, so drawing is free).
+*   --diff enables frame diffing and --overhead sets the setup cost of every SPI
+*   transfer in the wire model, to compare how render scheduling moves latency.
+*   --snapshots streams framebuffer snapshots into capture like the firmware does over
+*   its console, through a mock UART that drains baud / 10 bytes per second of session
+*   time (115200 by default). A last snapshot is taken once the session ends and
+*   checked against the framebuffer, tools/snapshot_receiver turns capture into images.
+*   Writes a scripted heavy-drawing session instead of replaying one:
+*       replay_runner --synthesize <session> [frames]
+*/
+
+namespace {
+    using Panel = Display::Controllers::Ili9341;
+    using Screen = Display::Screen<Panel, Display::Transports::Mock>;
+
+    // Session frames between the starts of two snapshots
+    constexpr size_t SnapshotIntervalFrames = 100;
+
+    // Mock UART credit a step waits for, fewer and longer lines spend less on framing
+    constexpr double SnapshotStepBytes = 512;
+
+    std::atomic<bool> g_countAllocations = false;
+    std::atomic<size_t> g_allocations = 0;
+
+    // Model time for the latency probe: tick of the current frame plus wire time since it
+    int64_t g_frameStart = 0;
+    Screen* g_screen = nullptr;
+
+    int64_t SimulatedTime() {
+        return g_frameStart + g_screen->transport().wireNanoseconds() / 1000;
+    }
+
+    struct Distribution {
+        std::vector<double> values;
+
+        double percentile(double fraction) {
+            if (values.empty())
+                return 0;
+            std::sort(values.begin(), values.end());
+            return values[std::min(values.size() - 1, static_cast<size_t>(fraction * values.size()))];
+        }
+    };
+}
+
+void* operator new(size_t size) {
+    if (g_countAllocations)
+        ++g_allocations;
+    if (void* pointer = std::malloc(size ? size : 1))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    std::free(pointer);
+}
+
+static int Synthesize(const char* path, int frames) {
+    // Strokes around the middle, a tap on Clear, then a dashed zigzag over most of the screen
+    Replay::Recorder recorder(0x5EED, 16 + frames * 14);
+    int64_t time = 0;
+    for (int frame = 0; frame < frames; ++frame) {
+        Display::Position touch = { -1, -1 };
+        int phase = frame % 1500;
+        if (phase >= 100 && phase < 700) {
+            double angle = phase * 0.05;
+            touch = { int(120 + std::cos(angle) * (30 + phase / 10)), int(150 + std::sin(angle) * (30 + phase / 10)) };
+        }
+        else if (phase >= 800 && phase < 805) {
+            touch = { 209, Screen::Dimensions.height - 6 };
+        }
+        else if (phase >= 900 && phase < 1400 && phase % 30 < 25) {
+            touch = { 10 + (phase * 7) % 220, 20 + (phase - 900) / 2 };
+        }
+
+        // Frame ticks jitter like on the device: 10 ms sleep plus a variable amount of work
+        time += 10'000 + (frame * 7919) % 3000;
+        recorder.frame(time, touch);
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(recorder.bytes().data()), recorder.bytes().size());
+    if (!file) {
+        std::cerr << path << ": couldn't write\n";
+        return 1;
+    }
+    std::printf("%zu frames, %zu bytes\n", recorder.frames(), recorder.bytes().size());
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 3 && std::string(argv[1]) == "--synthesize")
+        return Synthesize(argv[2], argc > 3 ? std::atoi(argv[3]) : 3000);
+
+    std::string packPath, snapshotPath;
+    int baudRate = 115200;
+    bool frameDiffing = false;
+    double overheadMicroseconds = 0;
+    bool usage = argc < 2;
+    for (int index = 2; index < argc && !usage; ++index) {
+        std::string argument = argv[index];
+        if (argument == "--pack" && index + 1 < argc)
+            packPath = argv[++index];
+        else if (argument == "--overhead" && index + 1 < argc)
+            overheadMicroseconds = std::atof(argv[++index]);
+        else if (argument == "--snapshots" && index + 1 < argc)
+            snapshotPath = argv[++index];
+        else if (argument == "--baud" && index + 1 < argc)
+            baudRate = std::max(std::atoi(argv[++index]), 1);
+        else if (argument == "--diff")
+            frameDiffing = true;
+        else
+            usage = true;
+    }
+    if (usage) {
+        std::cerr << "Usage: " << argv[0] << " <session> [--pack <assets.bin>] [--diff] [--overhead <us>]\n";
+        std::cerr << "       " << std::string(std::string(argv[0]).size(), ' ') << " [--snapshots <capture> [--baud <rate>]]\n";
+        std::cerr << "       " << argv[0] << " --synthesize <session> [frames]\n";
+        return 1;
+    }
+
+    std::ifstream file(argv[1], std::ios::binary);
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    Replay::Reader reader(bytes);
+    if (!reader) {
+        bytes = Replay::ParseDump(bytes);
+        reader = Replay::Reader(bytes);
+    }
+    if (!reader) {
+        std::cerr << argv[1] << ": no session log found\n";
+        return 1;
+    }
+
+    // Same logo selection as the firmware
+    Assets::PackStorage assetStorage(packPath.c_str());
+    Assets::AssetPack assets(assetStorage.bytes());
+    Display::PixelView logoImage = App::Demo<Screen>::PickLogo(assets.asset("logo").view());
+
+    Utility::SeedRandom(reader.seed());
+    Screen screen(false, Display::Transports::Mock::WireModel{ Panel::Frequency, static_cast<int>(overheadMicroseconds * 1000) });
+    App::Demo<Screen> demo(screen, logoImage);
+    screen.begin().get();
+    if (frameDiffing)
+        screen.setFrameDiffing(true);
+
+    g_screen = &screen;
+    Display::LatencyProbe probe(&SimulatedTime);
+    screen.setLatencyProbe(&probe);
+    demo.setLatencyProbe(&probe);
+    std::minstd_rand edgeRandom(1);
+
+    // Mock UART: the streamer may write what the line drained since the last frame, overdrafts wait
+    std::ofstream snapshotFile;
+    if (!snapshotPath.empty())
+        snapshotFile.open(snapshotPath, std::ios::binary);
+    Diagnostics::SnapshotStreamer snapshots(screen.framebuffer(), snapshotFile);
+    double uartCredit = 0;
+
+    Distribution cpuTimes, wireTimes, flushedBytes;
+    size_t frames = 0, allocations = 0, allocatingFrames = 0, totalBytes = 0;
+    int64_t sessionMicroseconds = 0;
+    Replay::FrameSample sample;
+    while (reader.next(sample)) {
+        screen.transport().clear();
+        int64_t interval = sample.timeMicroseconds - g_frameStart;
+        g_frameStart = sample.timeMicroseconds;
+        int64_t edgeTime = g_frameStart - static_cast<int64_t>(edgeRandom() % (std::max<int64_t>(interval, 0) + 1));
+
+        g_allocations = 0;
+        g_countAllocations = true;
+        auto start = std::chrono::steady_clock::now();
+        probe.sample(sample.touch, edgeTime);
+        demo.frame(sample.touch);
+        double microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        g_countAllocations = false;
+
+        size_t sent = screen.transport().bytesWritten();
+        cpuTimes.values.push_back(microseconds);
+        flushedBytes.values.push_back(static_cast<double>(sent));
+        wireTimes.values.push_back(screen.transport().wireNanoseconds() / 1000.0);
+        totalBytes += sent;
+        allocations += g_allocations;
+        allocatingFrames += g_allocations > 0;
+        sessionMicroseconds = sample.timeMicroseconds;
+
+        if (snapshotFile.is_open()) {
+            if (frames % SnapshotIntervalFrames == 0)
+                snapshots.begin();
+            uartCredit = std::min(uartCredit + baudRate / 10.0 * interval / 1e6, baudRate / 10.0);
+            if (uartCredit >= SnapshotStepBytes)
+                uartCredit -= static_cast<double>(snapshots.step(static_cast<size_t>(uartCredit)));
+        }
+        ++frames;
+    }
+
+    // FNV-1a over the final framebuffer
+    uint32_t checksum = 2166136261u;
+    Display::PixelView framebuffer = screen.framebuffer();
+    for (int y = 0; y < framebuffer.height(); ++y) {
+        for (int x = 0; x < framebuffer.width(); ++x)
+            checksum = (checksum ^ framebuffer.at(x, y)) * 16777619u;
+    }
+
+    std::printf("%zu frames, %.1f s recorded, seed 0x%08X\n", frames, sessionMicroseconds / 1e6, reader.seed());
+    std::printf("%-12s %9s %9s %9s %9s\n", "", "p50", "p90", "p99", "max");
+    for (auto [name, distribution] : { std::pair{ "cpu us", &cpuTimes }, std::pair{ "wire us", &wireTimes }, std::pair{ "bytes", &flushedBytes } }) {
+        std::printf("%-12s %9.1f %9.1f %9.1f %9.1f\n", name,
+            distribution->percentile(0.5), distribution->percentile(0.9), distribution->percentile(0.99), distribution->percentile(1.0));
+    }
+    std::printf("flushed %zu bytes (%.0f per frame), %zu allocations in %zu frames\n",
+        totalBytes, frames ? double(totalBytes) / frames : 0.0, allocations, allocatingFrames);
+    std::printf("hits: canvas %d, border %d, corner %d, framebuffer checksum %08X\n",
+        demo.canvasHits(), demo.borderHits(), demo.cornerHits(), checksum);
+    probe.report(std::cout);
+
+    if (snapshotFile.is_open()) {
+        // Finish the snapshot in progress, then one of the final framebuffer
+        while (snapshots.busy())
+            snapshots.step(static_cast<size_t>(baudRate / 10));
+        snapshots.begin();
+        while (snapshots.busy())
+            snapshots.step(static_cast<size_t>(baudRate / 10));
+        snapshotFile.close();
+
+        Diagnostics::SnapshotReceiver receiver;
+        std::ifstream capture(snapshotPath, std::ios::binary);
+        std::string line;
+        while (std::getline(capture, line))
+            receiver.feed(line);
+        bool matches = receiver.complete() && Diagnostics::Snapshot::ImageChecksum(receiver.image()) == Diagnostics::Snapshot::ImageChecksum(framebuffer);
+        std::printf("snapshots: %zu sent, %zu bytes at %d baud (%.1f s), %zu received, last %s the framebuffer\n",
+            snapshots.snapshots(), snapshots.bytesWritten(), baudRate, snapshots.bytesWritten() * 10.0 / baudRate,
+            receiver.complete(), matches ? "matches" : "DOESN'T MATCH");
+        if (!matches)
+            return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,262 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "display/controllers/ili9341.hpp"
+#include "display/controllers/ili9488.hpp"
+#include "display/fonts/mono_5x7.hpp"
+#include "display/kernels.hpp"
+#include "display/screen.hpp"
+#include "display/transports/mock.hpp"
+#include "ui/terminal.hpp"
+#include "utility/random.hpp"
+using namespace evms;
+
+/*
+*   Checks what Screen sends while hardware scrolling is active:
+*       scroll_check
+*   Replays the mock transport's commands and pixels into a model of the panel's GRAM
+*   and scroll registers, then compares what the panel would show, row by row, with
+*   the framebuffer. Covers drawing at a known row with a non-zero offset, a Terminal
+*   that wrapped many times, and random fills, scrolls, streams and scroll area
+*   changes with and without frame diffing, on RGB565 and RGB666 controllers.
+*   Returns non-zero on any mismatch.
+*/
+
+namespace {
+    using Mock = Display::Transports::Mock;
+
+    constexpr int RandomSteps = 3000;
+
+    // GRAM and scroll registers of a MIPI DCS controller in Rotation::Deg0
+    template <typename Panel>
+    class PanelModel {
+    public:
+        static constexpr Display::Dimensions2D Dimensions = Panel::Dimensions;
+        static constexpr int BytesPerPixel = Display::Controllers::BytesPerPixel<Panel>();
+
+    private:
+        std::vector<uint8_t> m_gram = std::vector<uint8_t>(Dimensions.width * Dimensions.height * BytesPerPixel);
+        int m_columns[2] = { 0, Dimensions.width - 1 };
+        int m_pages[2] = { 0, Dimensions.height - 1 };
+        int m_scrollTop = 0;
+        int m_scrollHeight = Dimensions.height;
+        int m_scrollStart = 0;
+
+    private:
+        static int Word(const std::vector<uint8_t>& bytes, size_t index) {
+            return (bytes[index] << 8) | bytes[index + 1];
+        }
+
+        void write(const std::vector<uint8_t>& pixels) {
+            int width = m_columns[1] - m_columns[0] + 1;
+            for (size_t pixel = 0; pixel * BytesPerPixel < pixels.size(); ++pixel) {
+                int x = m_columns[0] + static_cast<int>(pixel % width);
+                int y = m_pages[0] + static_cast<int>(pixel / width);
+                if (y > m_pages[1])
+                    break;
+                std::memcpy(&m_gram[(y * Dimensions.width + x) * BytesPerPixel], &pixels[pixel * BytesPerPixel], BytesPerPixel);
+            }
+        }
+
+    public:
+        void apply(const std::vector<Mock::Write>& writes) {
+            uint8_t code = Panel::Nop;
+            for (const Mock::Write& write : writes) {
+                if (write.command) {
+                    code = write.bytes[0];
+                    continue;
+                }
+                if (code == Panel::ColumnAddressSet) {
+                    m_columns[0] = Word(write.bytes, 0);
+                    m_columns[1] = Word(write.bytes, 2);
+                }
+                else if (code == Panel::PageAddressSet) {
+                    m_pages[0] = Word(write.bytes, 0);
+                    m_pages[1] = Word(write.bytes, 2);
+                }
+                else if (code == Panel::VerticalScrollDefinition) {
+                    m_scrollTop = Word(write.bytes, 0);
+                    m_scrollHeight = Word(write.bytes, 2);
+                }
+                else if (code == Panel::VerticalScrollStart) {
+                    m_scrollStart = Word(write.bytes, 0);
+                }
+                else if (code == Panel::MemoryWrite) {
+                    this->write(write.bytes);
+                }
+            }
+        }
+
+        int gramRow(int y) const {
+            if (y < m_scrollTop || y >= m_scrollTop + m_scrollHeight)
+                return y;
+            return m_scrollTop + (y - m_scrollTop + m_scrollStart - m_scrollTop) % m_scrollHeight;
+        }
+
+        // Pixel bytes the panel shows on screen row y
+        const uint8_t* shownRow(int y) const {
+            return &m_gram[gramRow(y) * Dimensions.width * BytesPerPixel];
+        }
+    };
+
+    template <typename Panel>
+    struct Harness {
+        using Screen = Display::Screen<Panel, Mock>;
+        static constexpr Display::Dimensions2D Dimensions = Screen::Dimensions;
+
+        Screen screen;
+        PanelModel<Panel> panel;
+
+        Harness() {
+            screen.begin().get();
+        }
+
+        void apply() {
+            panel.apply(screen.transport().writes());
+            screen.transport().clear();
+        }
+
+        void render() {
+            screen.render();
+            apply();
+        }
+
+        // Returns the first screen row that differs from the framebuffer, -1 if none
+        int firstMismatch() const {
+            std::vector<uint8_t> expected(Dimensions.width * PanelModel<Panel>::BytesPerPixel);
+            for (int y = 0; y < Dimensions.height; ++y) {
+                const uint16_t* row = screen.framebuffer().row(y);
+                if constexpr (Panel::Format == Display::Controllers::PixelFormat::Rgb565)
+                    std::memcpy(expected.data(), row, expected.size());
+                else
+                    Display::Kernels::ToRgb666Span(expected.data(), row, Dimensions.width);
+                if (std::memcmp(expected.data(), panel.shownRow(y), expected.size()) != 0)
+                    return y;
+            }
+            return -1;
+        }
+    };
+}
+
+static bool Report(const char* name, int mismatch) {
+    if (mismatch < 0)
+        std::printf("%-40s ok\n", name);
+    else
+        std::printf("%-40s MISMATCH at screen row %d\n", name, mismatch);
+    return mismatch < 0;
+}
+
+// A row drawn at a known screen row with a non-zero offset lands on the GRAM row the panel shows there
+template <typename Panel>
+static bool CheckKnownRow(const char* name) {
+    Harness<Panel> harness;
+    constexpr int Top = 16, Height = 200, Offset = 100, Row = 50;
+    harness.screen.setScrollArea(Top, Height);
+    harness.screen.fill(0x1F00);
+    harness.render();
+    harness.screen.scrollTo(Offset);
+    harness.render();
+
+    harness.screen.fill(0, Row, { Harness<Panel>::Dimensions.width, 1 }, 0x00F8);
+    harness.render();
+
+    int mismatch = harness.firstMismatch();
+    int expectedGramRow = Top + (Row - Top + Offset) % Height;
+    if (mismatch < 0 && harness.panel.gramRow(Row) != expectedGramRow)
+        mismatch = Row;
+    return Report(name, mismatch);
+}
+
+template <typename Panel>
+static bool CheckTerminal(const char* name) {
+    Harness<Panel> harness;
+    harness.screen.fill(0x1F00);
+    Ui::Terminal terminal(harness.screen, Fonts::Mono5x7, 24, 240);
+    for (int line = 0; line < 100; ++line) {
+        // Lines of different lengths, so leftovers of longer ones would show
+        terminal.append(std::string(1 + (line * 7) % 30, static_cast<char>('A' + line % 26)));
+        if (line % 3 == 0)
+            harness.render();
+    }
+    harness.render();
+    return Report(name, harness.firstMismatch());
+}
+
+template <typename Panel>
+static bool CheckRandom(const char* name, bool frameDiffing) {
+    constexpr Display::Dimensions2D Dimensions = Harness<Panel>::Dimensions;
+    Harness<Panel> harness;
+    Utility::RandomEngine random(7);
+    if (frameDiffing)
+        harness.screen.setFrameDiffing(true);
+    harness.screen.setScrollArea(20, Dimensions.height - 60);
+    harness.render();
+
+    std::vector<uint16_t> streamed(Dimensions.width * Dimensions.height);
+    for (int step = 0; step < RandomSteps; ++step) {
+        int x = random.integer(-20, Dimensions.width), y = random.integer(-20, Dimensions.height);
+        Display::Dimensions2D size = { random.integer(1, 80), random.integer(1, 120) };
+        uint16_t color = static_cast<uint16_t>(random.below(0x10000));
+
+        switch (random.below(8)) {
+            case 0:
+            case 1:
+            case 2:
+                harness.screen.fill(x, y, size, color);
+                break;
+            case 3:
+                harness.screen.scrollBy(random.integer(-Dimensions.height, Dimensions.height));
+                break;
+            case 4:
+                harness.screen.drawText(x, y, Fonts::Mono5x7, "Scrolled", color, ~color);
+                break;
+            case 5: {
+                // Streamed rows go straight to GRAM, the framebuffer gets the same ones to compare with
+                harness.render();
+                Display::Rect region = Display::Rect{ x, y, size.width, size.height }.intersected({ 0, 0, Dimensions.width, Dimensions.height });
+                if (!region)
+                    break;
+                bool sent = harness.screen.stream(region, [&](uint16_t* row, int rowIndex) {
+                    for (int column = 0; column < region.width; ++column)
+                        row[column] = static_cast<uint16_t>(color + rowIndex * 31 + column);
+                    std::copy_n(row, region.width, harness.screen.canvas().row(region.y + rowIndex) + region.x);
+                    return true;
+                });
+                harness.apply();
+                if (!sent || harness.firstMismatch() >= 0)
+                    return Report(name, sent ? harness.firstMismatch() : region.y);
+                break;
+            }
+            case 6:
+                if (random.below(20) == 0)
+                    harness.screen.setScrollArea(random.integer(0, 100), random.integer(0, Dimensions.height - 100));
+                break;
+            default:
+                harness.render();
+                if (harness.firstMismatch() >= 0)
+                    return Report(name, harness.firstMismatch());
+                break;
+        }
+    }
+    harness.render();
+    return Report(name, harness.firstMismatch());
+}
+
+int main() {
+    using Display::Controllers::Ili9341;
+    using Display::Controllers::Ili9488;
+
+    bool ok = true;
+    ok &= CheckKnownRow<Ili9341>("known row, rgb565");
+    ok &= CheckKnownRow<Ili9488>("known row, rgb666");
+    ok &= CheckTerminal<Ili9341>("terminal, rgb565");
+    ok &= CheckTerminal<Ili9488>("terminal, rgb666");
+    ok &= CheckRandom<Ili9341>("random, rgb565", false);
+    ok &= CheckRandom<Ili9341>("random, rgb565, frame diffing", true);
+    ok &= CheckRandom<Ili9488>("random, rgb666", false);
+    ok &= CheckRandom<Ili9488>("random, rgb666, frame diffing", true);
+    return ok ? 0 : 1;
+}
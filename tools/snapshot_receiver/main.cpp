@@ -0,0 +1,73 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "common/image.hpp"
+#include "diagnostics/snapshot_stream.hpp"
+using namespace evms;
+
+/*
+*   Reassembles framebuffer snapshots from captured console output:
+*       snapshot_receiver <capture|-> <out.png|out.ppm> [--all]
+*   Capture is the console log holding the "snapshot: " lines (- reads stdin, so it
+*   can sit behind a serial monitor). The last complete snapshot is written to out,
+*   with --all every complete one is, numbered: out-0001.png, out-0002.png and so on.
+*   Delta snapshots are applied on top of the previous one, lines that got mangled
+*   or lost drop their snapshot until the next key snapshot resyncs.
+*/
+
+static std::string NumberedPath(const std::string& path, size_t number) {
+    size_t dot = path.find_last_of('.');
+    char suffix[16];
+    std::snprintf(suffix, sizeof(suffix), "-%04zu", number);
+    return dot == std::string::npos ? path + suffix : path.substr(0, dot) + suffix + path.substr(dot);
+}
+
+int main(int argc, char** argv) {
+    bool all = argc == 4 && std::string(argv[3]) == "--all";
+    if (argc != 3 && !all) {
+        std::cerr << "Usage: " << argv[0] << " <capture|-> <out.png|out.ppm> [--all]\n";
+        return 1;
+    }
+
+    std::string capturePath = argv[1], outputPath = argv[2];
+    std::ifstream file;
+    if (capturePath != "-") {
+        file.open(capturePath, std::ios::binary);
+        if (!file) {
+            std::cerr << capturePath << ": couldn't open\n";
+            return 1;
+        }
+    }
+    std::istream& input = capturePath == "-" ? std::cin : file;
+
+    Diagnostics::SnapshotReceiver receiver;
+    Tools::Image last;
+    std::string line;
+    while (std::getline(input, line)) {
+        if (!receiver.feed(line))
+            continue;
+
+        Display::PixelView image = receiver.image();
+        last = Tools::FromRgb565(image.data(), image.dimensions());
+        if (all) {
+            std::string path = NumberedPath(outputPath, receiver.complete());
+            if (!Tools::SaveImage(path, last)) {
+                std::cerr << path << ": couldn't write\n";
+                return 1;
+            }
+        }
+    }
+
+    std::printf("%zu complete snapshots, %zu dropped, %zu bad frames\n", receiver.complete(), receiver.dropped(), receiver.badFrames());
+    if (!last) {
+        std::cerr << capturePath << ": no complete snapshot found\n";
+        return 1;
+    }
+    if (!all && !Tools::SaveImage(outputPath, last)) {
+        std::cerr << outputPath << ": couldn't write\n";
+        return 1;
+    }
+    return 0;
+}
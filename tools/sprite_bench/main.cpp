@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "display/dirty_regions.hpp"
+#include "display/sprite_atlas.hpp"
+#include "display/sprite_batch.hpp"
+#include "utility/random.hpp"
+using namespace evms;
+
+/*
+*   Measures Display::SpriteBatch on the host:
+*       sprite_bench
+*   Moves 100 to 1000 animated 8x8 sprites over a 240x320 framebuffer, bouncing off
+*   its edges. Each frame is update(), the bounce pass and render() into a DirtyRegions
+*   list, and reports time per frame for each, the rects that would go to the panel
+*   and their area. A frame at 60 fps has 16.7 ms, on the ESP32 expect several
+*   times the host's CPU time; the dirty area is what bounds the SPI side.
+*/
+
+namespace {
+    constexpr Display::Dimensions2D ScreenDims = { 240, 320 };
+    constexpr int SpriteSize = 8;
+    constexpr int FrameCount = 4;
+    constexpr size_t MaxSprites = 1000;
+    constexpr int Frames = 600;
+    constexpr size_t RegionCapacity = 16;
+
+    using Batch = Display::SpriteBatch<MaxSprites>;
+}
+
+int main() {
+    // Four frames of a square that grows a ring, side by side
+    std::vector<uint16_t> sheet(SpriteSize * FrameCount * SpriteSize);
+    std::array<Display::Rect, FrameCount> frames;
+    for (int frame = 0; frame < FrameCount; ++frame) {
+        frames[frame] = { frame * SpriteSize, 0, SpriteSize, SpriteSize };
+        for (int y = 0; y < SpriteSize; ++y) {
+            for (int x = 0; x < SpriteSize; ++x) {
+                bool ring = std::max(std::abs(2 * x - 7), std::abs(2 * y - 7)) <= 2 * frame + 1;
+                sheet[y * SpriteSize * FrameCount + frame * SpriteSize + x] = ring ? 0xFFFF : 0x1F00;
+            }
+        }
+    }
+    Display::SpriteAtlas atlas({ sheet.data(), { SpriteSize * FrameCount, SpriteSize } }, frames);
+    std::vector<uint16_t> framebuffer(ScreenDims.width * ScreenDims.height);
+    Display::MutablePixelView target(framebuffer.data(), ScreenDims);
+
+    std::printf("%8s %12s %12s %12s %12s %10s %12s\n", "sprites", "update us", "bounce us", "render us", "total us", "rects", "dirty px");
+    for (int count : { 100, 250, 500, 1000 }) {
+        auto batch = std::make_unique<Batch>(atlas);
+        Utility::RandomEngine random(1);
+        for (int index = 0; index < count; ++index) {
+            Display::Position position = { random.integer(0, ScreenDims.width - SpriteSize), random.integer(0, ScreenDims.height - SpriteSize) };
+            Display::Position velocity = { random.integer(-3 * Batch::One, 3 * Batch::One), random.integer(-3 * Batch::One, 3 * Batch::One) };
+            batch->add(position, velocity, 0, FrameCount, 1 + random.integer(0, 7));
+        }
+
+        double updateTime = 0, bounceTime = 0, renderTime = 0;
+        size_t rects = 0, dirtyPixels = 0;
+        Display::DirtyRegions<RegionCapacity> dirty;
+        for (int frame = 0; frame < Frames; ++frame) {
+            auto start = std::chrono::steady_clock::now();
+            batch->update();
+            auto updated = std::chrono::steady_clock::now();
+            for (int index = 0; index < count; ++index) {
+                Display::Position position = batch->position(index), velocity = batch->velocity(index);
+                if (position.x < 0 || position.x > ScreenDims.width - SpriteSize)
+                    velocity.x = position.x < 0 ? std::abs(velocity.x) : -std::abs(velocity.x);
+                if (position.y < 0 || position.y > ScreenDims.height - SpriteSize)
+                    velocity.y = position.y < 0 ? std::abs(velocity.y) : -std::abs(velocity.y);
+                batch->setVelocity(index, velocity);
+            }
+            auto bounced = std::chrono::steady_clock::now();
+            dirty.clear();
+            batch->render(target, 0x0000, dirty);
+            auto rendered = std::chrono::steady_clock::now();
+
+            updateTime += std::chrono::duration<double, std::micro>(updated - start).count();
+            bounceTime += std::chrono::duration<double, std::micro>(bounced - updated).count();
+            renderTime += std::chrono::duration<double, std::micro>(rendered - bounced).count();
+            rects += dirty.size();
+            for (const Display::Rect& rect : dirty)
+                dirtyPixels += rect.area();
+        }
+        std::printf("%8d %12.2f %12.2f %12.2f %12.2f %10.1f %12zu\n", count, updateTime / Frames, bounceTime / Frames, renderTime / Frames,
+            (updateTime + bounceTime + renderTime) / Frames, double(rects) / Frames, dirtyPixels / Frames);
+    }
+    return 0;
+}
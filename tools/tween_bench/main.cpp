@@ -0,0 +1,104 @@
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <cstdio>
+#include <utility>
+
+#include "display/dirty_regions.hpp"
+#include "motion/tweener.hpp"
+#include "utility/random.hpp"
+using namespace evms;
+
+/*
+*   Measures Motion::Tweener on the host:
+*       tween_bench
+*   Advances 64 to 1024 concurrent tweens (a mix of scalars, moving rects reporting
+*   dirty regions and colors, every easing curve, looping) by one 60 Hz frame tick at
+*   a time and prints the cost per frame and per tween. Also compares table easing
+*   against the exact curves to show the fixed-point error, in units of the end value.
+*/
+
+namespace {
+    constexpr uint32_t FrameMicroseconds = 16'667;
+    constexpr double MinimumSeconds = 0.3;
+    constexpr size_t MaxTweens = 1024;
+}
+
+using Tweener = Motion::Tweener<MaxTweens>;
+
+static double ExactCurve(Motion::Easing easing, double t) {
+    switch (easing) {
+        case Motion::Easing::InQuad:
+            return t * t;
+        case Motion::Easing::OutQuad:
+            return 1 - (1 - t) * (1 - t);
+        case Motion::Easing::InOutCubic:
+            return t < 0.5 ? 4 * t * t * t : 1 - 4 * (1 - t) * (1 - t) * (1 - t);
+        case Motion::Easing::OutBack:
+            return 1 + 2.70158 * std::pow(t - 1, 3) + 1.70158 * std::pow(t - 1, 2);
+        default:
+            return t;
+    }
+}
+
+static void Populate(Tweener& tweener, size_t count) {
+    Utility::RandomEngine random(1);
+    for (size_t index = 0; index < count; ++index) {
+        Motion::Easing easing = static_cast<Motion::Easing>(index % Motion::EasingCount);
+        uint32_t duration = 200'000 + random.below(2'000'000);
+        switch (index % 3) {
+            case 0:
+                tweener.tween(0, 1000, duration, easing, Tweener::Repeat::Loop);
+                break;
+            case 1:
+                tweener.tweenPosition({ random.integer(0, 300), random.integer(0, 220) }, { random.integer(0, 300), random.integer(0, 220) },
+                    { 16, 16 }, duration, easing, Tweener::Repeat::PingPong);
+                break;
+            default:
+                tweener.tweenColor(0x00F8, 0x1F00, duration, easing, Tweener::Repeat::PingPong);
+                break;
+        }
+    }
+}
+
+int main() {
+    std::printf("%8s %14s %14s\n", "tweens", "us/frame", "ns/tween");
+    for (size_t count = 64; count <= MaxTweens; count *= 2) {
+        static Tweener tweener;
+        tweener.clear();
+        Populate(tweener, count);
+
+        Display::DirtyRegions<16> dirty;
+        long long frames = 0;
+        double seconds = 0;
+        auto start = std::chrono::steady_clock::now();
+        while (seconds < MinimumSeconds) {
+            for (int repeat = 0; repeat < 100; ++repeat) {
+                dirty.clear();
+                tweener.advance(FrameMicroseconds, dirty);
+            }
+            frames += 100;
+            seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+        double frameMicroseconds = seconds * 1e6 / frames;
+        std::printf("%8zu %14.2f %14.2f\n", count, frameMicroseconds, frameMicroseconds * 1000 / count);
+    }
+
+    std::printf("\n%-12s %14s\n", "easing", "max error");
+    const std::pair<Motion::Easing, const char*> curves[] = {
+        { Motion::Easing::Linear, "linear" },
+        { Motion::Easing::InQuad, "in quad" },
+        { Motion::Easing::OutQuad, "out quad" },
+        { Motion::Easing::InOutCubic, "in-out cubic" },
+        { Motion::Easing::OutBack, "out back" },
+    };
+    for (const auto& [easing, name] : curves) {
+        double maximum = 0;
+        for (uint32_t progress = 0; progress <= 65536; progress += 7) {
+            double eased = Motion::Ease(easing, progress) / double(1 << Motion::EasedBits);
+            maximum = std::max(maximum, std::abs(eased - ExactCurve(easing, progress / 65536.0)));
+        }
+        std::printf("%-12s %14.6f\n", name, maximum);
+    }
+    return 0;
+}